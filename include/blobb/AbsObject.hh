@@ -11,10 +11,12 @@
 #include "blobb/Exception.hh"  // exception handler
 #include "blobb/Printable.hh"  // printable object
 #include "blobb/ClassDef.hh"   // blobb class definition
+#include "blobb/ArchiveIndex.hh" // footer index of binary archives
 
 namespace Blobb {
 
 class CLUI;
+class StreamWriter;
 
 /** \class AbsObject
     \brief An abstract base class.
@@ -38,8 +40,11 @@ public:
 
   //! Class-type (pure virtual)
   virtual string className() const = 0;
+  //! Class identifier (pure virtual)
+  virtual ClassId_t classId() const = 0;
   Bool_t isSame(const AbsObject& other) const;
   Bool_t isA(const string& className) const;
+  Bool_t isA(ClassId_t classId) const;
   Bool_t isSameClass(const AbsObject& other) const;
 
   //! Does this equal other? (pure virtual)
@@ -55,6 +60,9 @@ public:
   Bool_t operator>(const AbsObject& other) const;
   Bool_t operator>=(const AbsObject& other) const;
 
+  // content hashing
+  virtual ULong_t hash() const;
+
   // printing
   void printClassName(ostream& os) const;
 
@@ -71,6 +79,11 @@ public:
 		     const string& objName = "") const = 0;
   Bool_t save(const string& fileName, const string& objName = "") const;
 
+  // streaming (JSON/XML) plug-in
+  virtual void stream(StreamWriter& sw) const;
+  Bool_t saveStreamed(const string& fileName, Bool_t compact = kFalse,
+		      const string& objName = "") const;
+
   //_____________________________________________________________________________
   //! Read this object from the stream. (pure virtual)
   /** \note Only _the_ object named 'name' is read from the stream.
@@ -78,6 +91,21 @@ public:
   virtual void read(istream& is, eArchiveType arcType = gDefArcType,
 		    const string& objName = "") = 0;
   Bool_t load(const string& fileName, const string& objName = "");
+
+protected:
+  // archives not handled by cereal (e.g. kMapped)
+  virtual void writeArchive(ostream& os, eArchiveType arcType, 
+			    const string& objName) const;
+  virtual void readArchive(istream& is, eArchiveType arcType, 
+			   const string& objName);
+  virtual void loadMapped(const string& fileName, const string& objName);
+  //! Let go of a file (e.g. a mapping) before it is (over-)written
+  inline virtual void releaseFile(const string& /*fileName*/) const { }
+  // footer index of binary archives
+  virtual void writeIndexed(ostream& os, const string& objName, 
+			    IndexEntries_t& entries) const;
+  void writeIndex(ostream& os, IndexEntries_t& entries, ULong_t start,
+		  const LzOStreamBuf* lz = 0) const;
 };
 
 } // end namespace Blobb
@@ -0,0 +1,89 @@
+/** \file      ArchiveIndex.hh
+    \brief     Header for ArchiveIndex
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_ARCHIVEINDEX_HH
+#define BLOBB_ARCHIVEINDEX_HH
+
+#include "blobb/LzStreamBuf.hh"  // LZ block-compressed streams
+#include <fstream>               // cplusplus.com/reference/fstream/
+
+namespace Blobb {
+
+class AbsObject;
+class Warrior;
+
+//_____________________________________________________________________________
+/** \struct IndexEntry_t
+    \brief Byte range of a named object in an (uncompressed) archive. */
+struct IndexEntry_t {
+  string  name;    //!< object name; "<object>/<key>" for a roster warrior
+  ULong_t offset;  //!< offset of the first byte
+  ULong_t length;  //!< number of bytes
+};
+
+/** \typedef IndexEntries_t
+    \brief A list of index entries. */
+typedef vector<IndexEntry_t> IndexEntries_t;
+
+/** \class ArchiveIndex
+    \brief Footer index of binary archives, for random-access loads.
+
+    Binary (kBinary) and LZ-compressed binary (kBinaryLz) files written by 
+    AbsObject::save end with an index of the saved object and of its
+    members which can be loaded alone (e.g. the warriors of a BloBB):
+    - entries: name length (4 bytes), name, offset & length (8 bytes each),
+    - blocks (kBinaryLz): raw offset & file offset (8 bytes each) of 
+      each compressed block,
+    - trailer: footer offset (8 bytes), numbers of entries & blocks, 
+      check (XXH64, low 32 bits, of the footer) and "BIX1".
+    All integers are little-endian. Offsets are file offsets, or, for
+    compressed files, offsets in the raw stream. Readers of the archive
+    itself ignore the footer.
+
+    Loading an entry is a seek and a read of its bytes (or of the 
+    compressed blocks holding them).
+*/
+class ArchiveIndex {
+public:
+  ArchiveIndex();
+  ArchiveIndex(const string& fileName);
+  inline virtual ~ArchiveIndex() { }
+
+  Bool_t open(const string& fileName, Bool_t quiet = kFalse);
+  void close();
+  //! Is an indexed archive open?
+  inline Bool_t isOpen() const { return mFile.is_open(); }
+  //! Is the archive compressed?
+  inline Bool_t isCompressed() const { return !mBlocks.empty(); }
+  //! Name of the archived object
+  inline const string& objectName() const { return mObjectName; }
+  //! Number of entries
+  inline Pos_t size() const { return mEntries.size(); }
+  const IndexEntry_t* find(const string& name) const;
+
+  Bool_t read(const string& name, string& bytes);
+  Bool_t load(const string& name, AbsObject& obj);
+
+  static void Write(ostream& os, const IndexEntries_t& entries, 
+		    const vector<LzOStreamBuf::Block_t>& blocks);
+  static Bool_t LoadWarrior(const string& fileName, const string& key, Warrior& war);
+
+private:
+  // not copyable
+  ArchiveIndex(const ArchiveIndex&);
+  ArchiveIndex& operator=(const ArchiveIndex&);
+
+private:
+  string                        mFileName;    //!< archive file name
+  std::ifstream                 mFile;        //!< archive file
+  string                        mObjectName;  //!< name of the archived object
+  IndexEntries_t                mEntries;     //!< entries, by name
+  vector<LzOStreamBuf::Block_t> mBlocks;      //!< compressed blocks
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_ARCHIVEINDEX_HH
@@ -14,9 +14,13 @@ namespace Blobb {
 //_____________________________________________________________________________
 /** \enum eArchiveType Archive types. */
 enum eArchiveType { 
-  kBinary =  0, /**< Binary */
-  kJson   =  1, /**< JavaScript Object Notation */
-  kXml    =  2  /**< eXtensible Markup Language */
+  kBinary   =  0, /**< Binary */
+  kJson     =  1, /**< JavaScript Object Notation */
+  kXml      =  2, /**< eXtensible Markup Language */
+  kMapped   =  3, /**< Memory-mapped roster (BloBB only) */
+  kBinaryLz =  4, /**< Binary, LZ block-compressed */
+  kJsonLz   =  5, /**< JavaScript Object Notation, LZ block-compressed */
+  kPortable =  6  /**< Portable (endian-safe) binary */
 };
 
 //_____________________________________________________________________________
@@ -31,6 +35,10 @@ eArchiveType GetArchiveTypeFromFileName(const string& fileName);
 string GetArchiveName(eArchiveType algo);
 string GetArchiveTitle(eArchiveType algo);
 string GetArchiveExt(eArchiveType algo);
+Bool_t IsArchiveExt(const string& ext);
+Bool_t IsTextArchive(eArchiveType algo);
+Bool_t IsCompressedArchive(eArchiveType algo);
+eArchiveType GetUncompressedArchive(eArchiveType algo);
 void PrintArchiveInfo(ostream& os, const string& prefix = "");
 
 } // end namespace Blobb
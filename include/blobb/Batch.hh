@@ -0,0 +1,96 @@
+/** \file      Batch.hh
+    \brief     Header for Batch
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_BATCH_HH
+#define BLOBB_BATCH_HH
+
+#include "blobb/BloBB.hh"  // master class
+#include "blobb/Sink.hh"   // output sinks
+
+namespace Blobb {
+
+class Dashboard;
+class StreamWriter;
+
+/** \class Batch
+    \brief Non-interactive driver of a BloBB state by a command script.
+
+    Commands are read one per line, with no prompts; arguments are
+    separated by white space, or double-quoted. Empty lines & lines
+    starting with '#' are skipped. Commands:
+    - load file                    Load a state (BloBB::loadFile)
+    - save file                    Save the state (BloBB::saveFile)
+    - save-delta file base         Save the changes since the state in
+                                   base, a full save or a delta
+                                   (StateDelta::Save); file is named
+                                   <name>.delta<ext>
+    - register name p a i pe h [title]
+                                   Register or update a warrior: prowess,
+                                   agility, intelligence, personality & health
+    - fight name1 name2            Death match; the fighters are updated
+    - tournament [name ...]        Round robin of death matches between
+                                   copies of the (or all) warriors
+    - warriors                     List the warriors
+    - quit                         Stop reading the script
+
+    Each command writes one result line: a compact JSON object with the
+    script line, the command and status "ok" (and its results) or
+    "error" (and the error message). Fight narration is discarded;
+    tournaments can be shown live on a Dashboard (setDashboard).
+*/
+class Batch {
+public:
+  Batch(BloBB& blobb, ostream& os);
+  inline virtual ~Batch() { }
+
+  Pos_t run(istream& is);
+  Bool_t execute(const string& line);
+
+  //! Number of commands executed
+  inline Pos_t numCommands() const { return mNumCommands; }
+  //! Number of commands failed
+  inline Pos_t numFailed() const { return mNumFailed; }
+  //! Has quit been read?
+  inline Bool_t hasQuit() const { return mQuit; }
+  //! Set the dashboard of the tournaments (0: none); it must outlive its use
+  inline void setDashboard(Dashboard* dashboard){ mDashboard = dashboard; }
+
+  static vector<string> Tokenize(const string& line);
+
+private:
+  // not copyable
+  Batch(const Batch&);
+  Batch& operator=(const Batch&);
+
+  void dispatch(const vector<string>& args, StreamWriter& sw);
+  // commands
+  void load(const vector<string>& args, StreamWriter& sw);
+  void save(const vector<string>& args, StreamWriter& sw);
+  void saveDelta(const vector<string>& args, StreamWriter& sw);
+  void registerWarrior(const vector<string>& args, StreamWriter& sw);
+  void fight(const vector<string>& args, StreamWriter& sw);
+  void tournament(const vector<string>& args, StreamWriter& sw);
+  void warriors(const vector<string>& args, StreamWriter& sw);
+  // utilities
+  Warrior& find(const string& name);
+  Int_t deathMatch(Warrior& w1, Warrior& w2);
+  void commitRandom();
+
+private:
+  BloBB&     mBlobb;        //!< driven state
+  ostream&   mOs;           //!< result stream
+  NullSink   mNull;         //!< discards fight narration
+  CLUI       mClui;         //!< fights' user interface, on mNull
+  Pos_t      mLine;         //!< current script line
+  Pos_t      mNumCommands;  //!< commands executed
+  Pos_t      mNumFailed;    //!< commands failed
+  Bool_t     mQuit;         //!< quit read
+  Dashboard* mDashboard;    //!< tournaments' dashboard, if any
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_BATCH_HH
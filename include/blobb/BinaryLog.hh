@@ -0,0 +1,139 @@
+/** \file      BinaryLog.hh
+    \brief     Header for format-string logging & binary log records
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_BINARYLOG_HH
+#define BLOBB_BINARYLOG_HH
+
+#include "blobb/Common.hh"      // common includes
+#include "blobb/LogService.hh"  // log service
+#include <cstdio>               // cplusplus.com/reference/cstdio/
+#include <cstring>              // cplusplus.com/reference/cstring/
+#include <type_traits>          // cplusplus.com/reference/type_traits/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** \class LogRecord
+    \brief Binary log record, built in a thread-local buffer.
+
+    A log file (StartBinaryLog) starts with the magic "BLOBBLOG" and a
+    version, followed by records, in native byte order:
+    - format: 'F', id (4), length (2), format string,
+    - message: 'M', time [ns since the epoch] (8), level (1), topic (1),
+      format id (4), number of arguments (1), arguments,
+    where each argument is a type tag & value: 'i' signed (8),
+    'u' unsigned (8), 'd' double (8) or 's' length (2) & bytes.
+    Formats are defined once, before their first use; format 0 is "%s",
+    used for stream (lout) messages. DecodeBinaryLog renders the records.
+*/
+class LogRecord {
+public:
+  LogRecord(eLogLevel level, eLogTopic topic, UInt_t formatId);
+  void putInt(Long_t val);
+  void putUInt(ULong_t val);
+  void putDouble(Double_t val);
+  void putString(CChar_t* val, ULong_t length);
+  void write();
+
+private:
+  string& mBuffer;   //!< thread-local record buffer
+  Pos_t   mNumArgs;  //!< position of the number of arguments
+};
+
+//_____________________________________________________________________________
+// binary log file
+Bool_t StartBinaryLog(const string& fileName);
+void StopBinaryLog();
+Bool_t IsBinaryLog();
+UInt_t RegisterLogFormat(CChar_t* format);
+void LogBinaryText(eLogLevel level, eLogTopic topic, const string& text);
+Bool_t DecodeBinaryLog(istream& is, ostream& os);
+
+//_____________________________________________________________________________
+//! Record a signed integer argument.
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+LogArg(LogRecord& rec, T val){ rec.putInt(val); }
+//! Record an unsigned integer argument.
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+LogArg(LogRecord& rec, T val){ rec.putUInt(val); }
+//! Record a floating-point argument.
+template <class T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+LogArg(LogRecord& rec, T val){ rec.putDouble(val); }
+//! Record a C-string argument.
+inline void LogArg(LogRecord& rec, CChar_t* val){ rec.putString(val, strlen(val)); }
+//! Record a string argument.
+inline void LogArg(LogRecord& rec, const string& val){ rec.putString(val.data(), val.size()); }
+
+//! Record no more arguments.
+inline void LogArgs(LogRecord&){ }
+//! Record the arguments, in turn.
+template <class T, class... Rest>
+inline void LogArgs(LogRecord& rec, const T& val, const Rest&... rest)
+{
+  LogArg(rec, val);
+  LogArgs(rec, rest...);
+}
+
+//! printf argument of a string.
+inline CChar_t* TextArg(const string& val){ return val.c_str(); }
+//! printf argument of anything else.
+template <class T> inline const T& TextArg(const T& val){ return val; }
+
+//! The format string: first of the macro arguments.
+template <class... Args> inline CChar_t* LogFormatOf(CChar_t* format, const Args&...){ return format; }
+
+//_____________________________________________________________________________
+/** Log a printf-style message: a binary record if StartBinaryLog, else
+    formatted (truncated to 1 kB) and streamed to Log(). */
+template <class... Args>
+void LogFormat(eLogLevel level, eLogTopic topic, UInt_t formatId,
+	       CChar_t* format, const Args&... args)
+{
+  if(IsBinaryLog()){
+    LogRecord rec(level, topic, formatId);
+    LogArgs(rec, args...);
+    rec.write();
+    return;
+  }
+  Char_t text[1024];
+  snprintf(text, sizeof(text), format, TextArg(args)...);
+  Log(level, topic) << text << endl;
+}
+
+} // end namespace Blobb
+
+//_____________________________________________________________________________
+/** \def BLOBB_LOGF
+    Log a printf-style message if its level & topic are enabled; the
+    format is registered once per call site (a static of the inner loop).
+    Single-pass for loops, as in BLOBB_LOG, keep it one statement that
+    cannot capture a following "else". */
+#define BLOBB_LOGF(l,t,...)						\
+  for(bool blobbLogOn_ = Blobb::LogEnabled(l,t); blobbLogOn_; blobbLogOn_ = false) \
+    for(static const unsigned int blobbFormatId_ =			\
+	  Blobb::RegisterLogFormat(Blobb::LogFormatOf(__VA_ARGS__));	\
+	blobbLogOn_; blobbLogOn_ = false)				\
+      Blobb::LogFormat(l, t, blobbFormatId_, __VA_ARGS__)
+
+//_____________________________________________________________________________
+// Shortcut printf-style definitions, with topic, format & arguments
+//! printf-style debug message macro.
+#define loutfD(t,...) BLOBB_LOGF(Blobb::kDebug,t,__VA_ARGS__)
+//! printf-style info message macro.
+#define loutfI(t,...) BLOBB_LOGF(Blobb::kInfo,t,__VA_ARGS__)
+//! printf-style progress message macro.
+#define loutfP(t,...) BLOBB_LOGF(Blobb::kProgress,t,__VA_ARGS__)
+//! printf-style warning message macro.
+#define loutfW(t,...) BLOBB_LOGF(Blobb::kWarning,t,__VA_ARGS__)
+//! printf-style error message macro.
+#define loutfE(t,...) BLOBB_LOGF(Blobb::kError,t,__VA_ARGS__)
+//! printf-style fatal message macro.
+#define loutfF(t,...) BLOBB_LOGF(Blobb::kFatal,t,__VA_ARGS__)
+
+#endif // BLOBB_BINARYLOG_HH
@@ -11,29 +11,37 @@
 #include "blobb/TimeStamp.hh"    // time-stamp
 #include "blobb/Random.hh"       // random numbers
 #include "blobb/Warrior.hh"      // warrior
+#include "blobb/RosterIndex.hh"  // columnar roster index
 #include "blobb/CLUI.hh"         // command-line user interface
+#include "blobb/SnapshotSaver.hh" // background saving
 #include <cereal/types/map.hpp>  // map cerealization
 #include <map>                   // cplusplus.com/reference/map/
+#include <memory>                // cplusplus.com/reference/memory/
+#include <type_traits>           // cplusplus.com/reference/type_traits/
 using std::map;
 
 namespace Blobb {
 
-//_____________________________________________________________________________
-/** \typedef std::map<string,Warrior> Warriors_t 
-    \brief A std::map of Warrior's. 
-*/
-typedef map<string,Warrior> Warriors_t;
+class Journal;
+class MappedRoster;
 
 //_____________________________________________________________________________
 /** \class BloBB 
     \brief Master class for game control and state persistence.
+
+    A memory-mapped roster (.bbm) is loaded lazily: the file stays mapped
+    and a warrior is built when warrior(name) first asks for it. Anything
+    needing the whole roster (warriors(), index(), hash(), saving, ...)
+    builds the rest and lets go of the file.
+    \note Lazy look-ups modify the (mutable) roster; const access is not
+    thread-safe while a roster is mapped.
 */
 class BloBB : public Named { 
 public:
   BloBB();
-  BloBB(const BloBB& other, const string& newName);
+  BloBB(const BloBB& other, const string& newName = "");
   BloBB& operator=(const BloBB& rhs);
-  inline virtual ~BloBB() { }
+  virtual ~BloBB();
 
   virtual Bool_t isEmpty() const;
   virtual void clear();
@@ -58,18 +66,55 @@ public:
   //! Set random generator
   inline void setRandom(const Random& rnd){ mRandom = rnd; }
   //! Get warriors map
-  inline Warriors_t& warriors(){ return mWarriors; }
+  /** \note Call reindex() after modifying warriors through this map. */
+  inline Warriors_t& warriors(){ materialize(); return mWarriors; }
   //! Get warriors map (const)
-  inline const Warriors_t& warriors() const { return mWarriors; }
+  inline const Warriors_t& warriors() const { materialize(); return mWarriors; }
   //! Set warriors map
-  inline void setWarriors(const Warriors_t& wars){ mWarriors = wars; }
+  inline void setWarriors(const Warriors_t& wars){ mMapped.reset(); mWarriors = wars; reindex(); }
   //! Get warrior
-  inline Warrior& warrior(const string& name){ return mWarriors.at(name); }
+  /** \note Call reindex(name) after modifying the warrior. */
+  inline Warrior& warrior(const string& name){ fetch(name); return mWarriors.at(name); }
   //! Get warrior (const)
-  inline const Warrior& warrior(const string& name) const { return mWarriors.at(name); }
-  //! Set warrior
-  inline void addWarrior(const Warrior& war){ mWarriors[war.name()] = war; }
+  inline const Warrior& warrior(const string& name) const { fetch(name); return mWarriors.at(name); }
+  //! Is there a warrior named name?
+  inline Bool_t hasWarrior(const string& name) const { fetch(name); return mWarriors.count(name) == 1; }
+  void addWarrior(const Warrior& war);
+  Pos_t importWarriors(const Warriors_t& wars);
+  //! Get the columnar roster index
+  inline const RosterIndex& index() const { materialize(); return mIndex; }
+  //! Re-build the roster index
+  inline void reindex(){ if(mMapped) materialize(); else mIndex.rebuild(mWarriors); }
+  //! Update the roster index of one warrior (built in full once mapped warriors are)
+  inline void reindex(const string& name){ if(!mMapped) mIndex.update(name, mWarriors.at(name)); }
+  //! Is a roster mapped, with warriors not built yet?
+  inline Bool_t isMapped() const { return Bool_t(mMapped); }
   void printWarriors(Bool_t verbose = kFalse) const;
+  //! Set the user interface's output to a sink (0: std::cout)
+  inline void setSink(Sink* sink){ mClui.setSink(sink); }
+
+  virtual ULong_t hash() const;
+  virtual void stream(StreamWriter& sw) const;
+  //! Has the state changed since the last save or load?
+  inline Bool_t isModified() const { return hash() != mSavedHash; }
+
+  // fastest writer & loader for the file type
+  Bool_t saveFile(const string& fileName) const;
+  Bool_t loadFile(const string& fileName);
+
+  // background saving
+  Bool_t saveAsync(const string& fileName, 
+		   const SnapshotSaver::Done_t& done = SnapshotSaver::Done_t());
+  Bool_t waitSave();
+  //! Is a background save running?
+  inline Bool_t isSaving() const { return mSaver.isBusy(); }
+
+  // journaled state
+  Bool_t openJournal(const string& fileName);
+  void closeJournal();
+  Bool_t compactJournal();
+  //! Get the change journal (0 if not journaling)
+  inline Journal* journal() const { return mJournal; }
 
   void printMenu() const;
 
@@ -83,27 +128,53 @@ public:
 protected:
   string readCommand();
   void saveState();
+  void reportSave(Bool_t wait = kFalse);
   void loadState();
   void registerWarrior();
   void fight();
+  void journalState();
+  void commit(const string& name);
+  // memory-mapped roster
+  virtual void writeArchive(ostream& os, eArchiveType arcType, 
+			    const string& objName) const;
+  virtual void loadMapped(const string& fileName, const string& objName);
+  virtual void releaseFile(const string& fileName) const;
+  void fetch(const string& name) const;
+  void materialize() const;
+  // footer index: one entry per warrior
+  virtual void writeIndexed(ostream& os, const string& objName, 
+			    IndexEntries_t& entries) const;
 
 private:
   // data members
   TimeStamp  mStartTime; //!< start-time
   TimeStamp  mEndTime;   //!< end-time
   Random     mRandom;    //!< random numbers
-  Warriors_t mWarriors;  //<! warriors
+  mutable Warriors_t mWarriors;  //<! warriors (built so far, if mapped)
   // helpers
-  mutable CLUI mClui;    //!< command-line user interface
+  mutable std::shared_ptr<const MappedRoster> mMapped; //!< lazily read roster (not persisted)
+  string       mMappedFileName; //!< file of the mapped roster (not persisted)
+  mutable RosterIndex mIndex;  //!< columnar roster index (not persisted)
+  ULong_t      mSavedHash;     //!< hash at the last save or load (not persisted)
+  string       mSavedFileName; //!< file of the last save or load (not persisted)
+  Journal*     mJournal;       //!< change journal (not persisted or copied)
+  SnapshotSaver mSaver;        //!< background saver (not persisted or copied)
+  ULong_t      mSaverHash;     //!< hash of the state being saved (not persisted)
+  mutable CLUI mClui;          //!< command-line user interface
 
   //! cerealize
   template <class Archive> void serialize(Archive& ar)
   {
+    // a mapped roster is saved whole, or replaced when loading
+    if(std::is_base_of<cereal::detail::InputArchiveBase, Archive>::value) mMapped.reset();
+    else materialize();
     ar(make_nvp("Named", cereal::base_class<Named>(this)),
        BLOBB_NVP(mStartTime),
        BLOBB_NVP(mEndTime),
        BLOBB_NVP(mRandom),
        BLOBB_NVP(mWarriors));
+    // loaded warriors need (re-)indexing
+    if(std::is_base_of<cereal::detail::InputArchiveBase, Archive>::value) reindex();
   }
   //! Macro: define concrete class
   BLOBB_CLASS_DEF(BloBB);   
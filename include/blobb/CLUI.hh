@@ -11,28 +11,64 @@
 
 namespace Blobb {
 
+class CLUIBuffer;
+class Sink;
+
 /** \class CLUI 
     \brief Utility class for handling command-line user interface.
+
+    By default each message is flushed to the out-stream when the next
+    is started (os()). In buffered mode (setBuffered) messages, endl
+    included, are collected in a large buffer, written to the out-stream
+    only at a prompt (request), by flush() or when full.
+
+    For sessions narrating concurrently on a shared out-stream, the
+    line-atomic mode (setLineAtomic) writes each completed line (endl)
+    in one piece; the buffered mode writes complete lines only, too
+    (but at flush()). Either way the session formats into its own
+    buffer and the shared stream is only locked to write (WriteShared).
+
+    The out-stream may be a Sink's (setSink); on a failed stream, e.g. a
+    NullSink's, messages are neither buffered nor formatted.
 */
 class CLUI { 
 public:
   CLUI();
   CLUI(const CLUI& other);
   CLUI& operator=(const CLUI& rhs);
-  inline virtual ~CLUI() { }
+  virtual ~CLUI();
 
   ostream& os(Bool_t prefix = kTrue);
   void setOutStream(ostream* os);
+  void setSink(Sink* sink);
   istream& is();
   void setInStream(istream* is);
 
+  //! Is the output buffered?
+  inline Bool_t isBuffered() const { return (mBuffer != 0 && !mLineAtomic); }
+  void setBuffered(Bool_t buffered = kTrue, Pos_t bufferSize = DefBufferSize);
+  //! Are the lines written whole, each at its endl?
+  inline Bool_t isLineAtomic() const { return mLineAtomic; }
+  void setLineAtomic(Bool_t lineAtomic = kTrue);
+  void flush();
+
   void request(const string& req = "");
   string readString();
   Double_t readDouble();
 
 protected:
-  ostream* mOs;  //!< out-stream
-  istream* mIs;  //!< in-stream
+  void resetBuffer(Pos_t bufferSize, Bool_t lineAtomic);
+
+  ostream*    mOs;          //!< out-stream
+  istream*    mIs;          //!< in-stream
+  CLUIBuffer* mBuffer;      //!< output buffer, if buffered or line-atomic
+  ostream*    mBufOs;       //!< stream on the output buffer, if any
+  Bool_t      mLineAtomic;  //!< lines written whole, at endl
+
+  //! Default size of the output buffer [bytes].
+  static const Pos_t DefBufferSize;
+  //! Size of the line-atomic buffer [bytes]; longer lines are split.
+  static const Pos_t LineBufferSize;
 
   //! Prefix for out messages.
   static const string Prefix;
@@ -13,12 +13,35 @@
 #include <cereal/types/string.hpp>  // string cerealization
 using cereal::make_nvp;             // make name-value-pair
 
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** \typedef UInt_t ClassId_t 
+    \brief Compile-time class identifier.
+*/
+typedef UInt_t ClassId_t;
+
+//_____________________________________________________________________________
+//! Class identifier from a class name (32-bit FNV-1a hash).
+/** Evaluated at compile-time for the BLOBB_CLASS_DEF class names and at 
+    run-time for AbsObject::isA(const string&). */
+constexpr ClassId_t ClassIdHash(CChar_t* name, ClassId_t hash = 2166136261u)
+{
+  return (*name == '\0') ? hash : 
+    ClassIdHash(name + 1, (hash ^ ClassId_t(UChar_t(*name))) * 16777619u);
+}
+
+} // end namespace Blobb
+
 //_____________________________________________________________________________
 //! \def BLOBB_CLASS_DEF(name) Class definition macro.
+/** Also assigns the class a compile-time identifier, ClassId(). */
 #define BLOBB_CLASS_DEF(name)                                                 \
 public:								              \
  virtual AbsObject* clone(const string&) const;                               \
  virtual string className() const;		                              \
+ static constexpr ClassId_t ClassId(){ return ClassIdHash(#name); }           \
+ virtual ClassId_t classId() const { return ClassId(); }                      \
  virtual void write(ostream& os, eArchiveType arcType = gDefArcType,          \
 		    const string& objName = "") const;		              \
  virtual void read(istream& is, eArchiveType arcType = gDefArcType,           \
@@ -8,6 +8,7 @@
 #define BLOBB_CLASSIMP_HH
 
 #include <cereal/archives/binary.hpp>    // cereal binary archive
+#include <cereal/archives/portable_binary.hpp>  // cereal portable binary archive
 #include <cereal/archives/json.hpp>      // cereal JSON archive
 #include <cereal/archives/xml.hpp>       // cereal XML archive
 #include <cereal/types/polymorphic.hpp>  // cereal poly & registration
@@ -47,6 +48,15 @@
   	xoa(make_nvp(n, *this));                                              \
   	return;                                                               \
       }                                                                       \
+    case kPortable :                                                          \
+      {                                                                       \
+  	cereal::PortableBinaryOutputArchive poa(os);                          \
+  	poa(make_nvp(n, *this));                                              \
+  	return;                                                               \
+      }                                                                       \
+    default :                                                                 \
+      writeArchive(os, arcType, n);                                           \
+      return;                                                                 \
     }                                                                         \
   }                                                                           \
   void Blobb::name::read(istream& is, eArchiveType arcType,                   \
@@ -73,6 +83,15 @@
   	xia(make_nvp(n, *this));                                              \
   	return;                                                               \
       }                                                                       \
+    case kPortable :                                                          \
+      {                                                                       \
+  	cereal::PortableBinaryInputArchive pia(is);                           \
+  	pia(make_nvp(n, *this));                                              \
+  	return;                                                               \
+      }                                                                       \
+    default :                                                                 \
+      readArchive(is, arcType, n);                                            \
+      return;                                                                 \
     }                                                                         \
   }                                                                           
 
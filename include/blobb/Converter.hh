@@ -0,0 +1,82 @@
+/** \file      Converter.hh
+    \brief     Header for Converter
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_CONVERTER_HH
+#define BLOBB_CONVERTER_HH
+
+#include "blobb/BloBB.hh"  // master class
+#include <functional>      // cplusplus.com/reference/functional/
+
+namespace Blobb {
+
+/** \class Converter
+    \brief Parallel conversion of BloBB saves between archive types.
+
+    Files are converted by a pool of worker threads; each worker loads
+    (BloBB::loadFile), saves (BloBB::saveFile) and frees one state at a
+    time, so at most numThreads() states are held in memory.
+    Each output is written to a temporary file (SnapshotSaver::TempName)
+    and renamed over the target once complete.
+
+    A roster sharded over several files can be merged into one file,
+    with the shards decoded in parallel, or split into shards, with the
+    shards encoded in parallel; shards are named by ShardName().
+*/
+class Converter {
+public:
+  Converter(eArchiveType outType = kBinary, UInt_t numThreads = 0);
+  inline virtual ~Converter() { }
+
+  //! Get output archive type
+  inline eArchiveType outType() const { return mOutType; }
+  //! Set output archive type
+  inline void setOutType(eArchiveType outType){ mOutType = outType; }
+  //! Get number of worker threads
+  inline UInt_t numThreads() const { return mNumThreads; }
+  void setNumThreads(UInt_t numThreads);
+  //! Get output directory (empty: next to the input)
+  inline const string& outDir() const { return mOutDir; }
+  void setOutDir(const string& dir);
+  //! Overwrite existing outputs?
+  inline Bool_t overwrite() const { return mOverwrite; }
+  //! Set overwrite existing outputs
+  inline void setOverwrite(Bool_t overwrite = kTrue){ mOverwrite = overwrite; }
+  //! Sync outputs to disk before renaming?
+  inline Bool_t sync() const { return mSync; }
+  //! Set sync outputs to disk before renaming
+  inline void setSync(Bool_t sync = kTrue){ mSync = sync; }
+
+  string outFileName(const string& inFileName) const;
+
+  Bool_t convert(const vector<string>& fileNames);
+  Bool_t merge(const vector<string>& shardNames, const string& outFileName);
+  Bool_t split(const string& fileName, UInt_t numShards);
+
+  //! Number of files written by the last call
+  inline Pos_t numDone() const { return mNumDone; }
+  //! Number of files failed by the last call
+  inline Pos_t numFailed() const { return mNumFailed; }
+
+  static string ShardName(const string& fileName, UInt_t shard);
+
+private:
+  Bool_t canWrite(const string& fileName) const;
+  Bool_t write(const BloBB& blobb, const string& fileName) const;
+  void run(UInt_t numJobs, const std::function<Bool_t(UInt_t)>& job);
+
+private:
+  eArchiveType mOutType;     //!< output archive type
+  UInt_t       mNumThreads;  //!< worker threads
+  string       mOutDir;      //!< output directory
+  Bool_t       mOverwrite;   //!< overwrite existing outputs
+  Bool_t       mSync;        //!< fsync outputs & their directories
+  Pos_t        mNumDone;     //!< files written
+  Pos_t        mNumFailed;   //!< files failed
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_CONVERTER_HH
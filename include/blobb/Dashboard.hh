@@ -0,0 +1,107 @@
+/** \file      Dashboard.hh
+    \brief     Header for Dashboard
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_DASHBOARD_HH
+#define BLOBB_DASHBOARD_HH
+
+#include "blobb/Common.hh"     // common includes
+#include <atomic>              // cplusplus.com/reference/atomic/
+#include <chrono>              // cplusplus.com/reference/chrono/
+#include <condition_variable>  // cplusplus.com/reference/condition_variable/
+#include <memory>              // cplusplus.com/reference/memory/
+#include <mutex>               // cplusplus.com/reference/mutex/
+#include <thread>              // cplusplus.com/reference/thread/
+
+namespace Blobb {
+
+/** \class Dashboard
+    \brief Full-screen ANSI terminal view of a running tournament: live
+    standings, throughput (fights/s) and the matches in progress.
+
+    Workers report matches (startMatch, finishMatch) with lock-free
+    counter updates only. Frames are drawn on the dashboard's own
+    thread, at most maxRate per second: each frame is composed as rows
+    of text, compared with the previous one, and only the changed runs
+    of cells are redrawn (cursor moves & text), in one write (see
+    WriteShared). The title row is styled like CLUI's prefix.
+*/
+class Dashboard {
+public:
+  explicit Dashboard(ostream& os, Double_t maxRate = DefMaxRate, Pos_t width = 0, Pos_t height = 0);
+  virtual ~Dashboard();
+
+  void start(const string& title, const vector<string>& names, ULong_t numMatches,
+	     Pos_t numSlots = 1);
+  void stop();
+  //! Is it running?
+  inline Bool_t isRunning() const { return mThread.joinable(); }
+
+  // workers: lock-free
+  void startMatch(Pos_t slot, Pos_t first, Pos_t second);
+  void finishMatch(Pos_t slot, Pos_t first, Pos_t second, Int_t result);
+
+  //! Number of frames drawn
+  inline ULong_t numFrames() const { return mNumFrames; }
+  //! Number of bytes written
+  inline ULong_t numBytes() const { return mNumBytes; }
+  //! Get screen width [cells]
+  inline Pos_t width() const { return mWidth; }
+  //! Get screen height [cells]
+  inline Pos_t height() const { return mHeight; }
+
+  //! Default maximum refresh rate [frames/s].
+  static const Double_t DefMaxRate;
+
+protected:
+  void run();
+  void draw();
+  void compose(vector<string>& rows, vector<string>& styles);
+  void diff(Pos_t row, const string& text, const string& style, string& out) const;
+
+private:
+  // not copyable
+  Dashboard(const Dashboard&);
+  Dashboard& operator=(const Dashboard&);
+
+  /** \typedef Clock_t
+      \brief Clock of the throughput. */
+  typedef std::chrono::steady_clock Clock_t;
+  /** \typedef Counts_t
+      \brief Per-warrior counters. */
+  typedef std::unique_ptr<std::atomic<UInt_t>[]> Counts_t;
+
+  ostream&                 mOs;          //!< terminal stream
+  Double_t                 mMaxRate;     //!< maximum refresh rate [frames/s]
+  Pos_t                    mWidth;       //!< screen width [cells]
+  Pos_t                    mHeight;      //!< screen height [cells]
+  // tournament
+  string                   mTitle;       //!< title
+  vector<string>           mNames;       //!< warriors' names
+  ULong_t                  mNumMatches;  //!< matches to fight
+  Counts_t                 mWins;        //!< wins per warrior
+  Counts_t                 mLosses;      //!< losses per warrior
+  Counts_t                 mDraws;       //!< draws per warrior
+  std::unique_ptr<std::atomic<ULong_t>[]> mSlots;  //!< match per slot: (first+1)<<32 | second+1
+  Pos_t                    mNumSlots;    //!< number of slots (workers)
+  std::atomic<ULong_t>     mNumDone;     //!< matches done
+  // drawing (dashboard thread)
+  Clock_t::time_point      mStartTime;   //!< start of the tournament
+  Clock_t::time_point      mLastTime;    //!< time of the previous frame
+  ULong_t                  mLastDone;    //!< matches done at the previous frame
+  Double_t                 mRate;        //!< smoothed throughput [fights/s]
+  vector<string>           mRows;        //!< text on screen
+  vector<string>           mStyles;      //!< styles on screen
+  ULong_t                  mNumFrames;   //!< frames drawn
+  ULong_t                  mNumBytes;    //!< bytes written
+  std::thread              mThread;      //!< drawing thread
+  std::mutex               mMutex;       //!< guards mStop
+  std::condition_variable  mWake;        //!< wakes the thread to stop
+  Bool_t                   mStop;        //!< stop requested
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_DASHBOARD_HH
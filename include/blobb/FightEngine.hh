@@ -23,6 +23,7 @@ public:
   inline virtual ~FightEngine() { }
 
   Int_t fight();
+  void death() const;
 
 protected:
   CLUI*    mClui;   //!< clui
@@ -37,7 +38,6 @@ protected:
   string readCommand();
   void printMenu() const;
   void swing() const;
-  void death() const;
 };
 
 } // end namespace Blobb
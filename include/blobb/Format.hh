@@ -0,0 +1,74 @@
+/** \file      Format.hh
+    \brief     Header for formatting into caller-provided buffers
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_FORMAT_HH
+#define BLOBB_FORMAT_HH
+
+#include "blobb/Common.hh"  // common includes
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Write a number's characters to [first, last), without allocating nor
+    terminating them; doubles as a classic-locale stream's default
+    floatfield (%g) with the precision given.
+    \return End of the characters written, or 0 if they do not fit. */
+Char_t* FormatChars(Char_t* first, Char_t* last, Double_t value, Int_t precision = 6);
+Char_t* FormatChars(Char_t* first, Char_t* last, Long_t value);
+Char_t* FormatChars(Char_t* first, Char_t* last, ULong_t value);
+
+/** \class FormatBuffer
+    \brief Text formatted into caller-provided storage (e.g. on the
+    stack), then written to a stream in one piece.
+
+    Numbers are formatted by FormatChars, with the stream's precision,
+    rather than by the stream's facets; nothing is allocated. If the
+    stream's number format is not the default (flags, width or locale),
+    numbers are formatted by the stream instead. Text that does not fit
+    is not lost: the storage is written out first. The rest is written
+    out by flush or at destruction.
+*/
+class FormatBuffer {
+public:
+  FormatBuffer(ostream& os, Char_t* storage, Pos_t capacity);
+  //! Destructor; the text is written out.
+  inline ~FormatBuffer() { flush(); }
+
+  void append(CChar_t* s, Pos_t n);
+  void flush();
+  //! Get the text not yet written out
+  inline CChar_t* data() const { return mBegin; }
+  //! Get the size of the text not yet written out [bytes]
+  inline Pos_t size() const { return Pos_t(mPos - mBegin); }
+
+  FormatBuffer& operator<<(CChar_t* s);
+  //! Append a string
+  inline FormatBuffer& operator<<(const string& s){ append(s.data(), s.size()); return *this; }
+  FormatBuffer& operator<<(Char_t c);
+  FormatBuffer& operator<<(Double_t value);
+  //! Append an integer
+  inline FormatBuffer& operator<<(Int_t value){ return *this << Long_t(value); }
+  //! Append an unsigned integer
+  inline FormatBuffer& operator<<(UInt_t value){ return *this << ULong_t(value); }
+  FormatBuffer& operator<<(Long_t value);
+  FormatBuffer& operator<<(ULong_t value);
+
+private:
+  // not copyable
+  FormatBuffer(const FormatBuffer&);
+  FormatBuffer& operator=(const FormatBuffer&);
+
+  ostream& mOs;         //!< target stream
+  Char_t*  mBegin;      //!< storage
+  Char_t*  mEnd;        //!< end of the storage
+  Char_t*  mPos;        //!< end of the text
+  Int_t    mPrecision;  //!< precision of doubles (the stream's)
+  Bool_t   mByStream;   //!< numbers formatted by the stream (format not the default)
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_FORMAT_HH
@@ -0,0 +1,25 @@
+/** \file      Hash.hh
+    \brief     Header for content hashing helpers.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_HASH_HH
+#define BLOBB_HASH_HH
+
+#include "blobb/Common.hh"  // common includes
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Fast, non-cryptographic 64-bit hashing (XXH64 algorithm).
+// Values are hashed in a canonical (little-endian) byte order, such that
+// hashes are stable across hosts and builds.
+ULong_t Hash64(const void* data, ULong_t length, ULong_t seed = 0);
+ULong_t HashCombine(ULong_t seed, ULong_t value);
+ULong_t HashDouble(ULong_t seed, Double_t value);
+ULong_t HashString(ULong_t seed, const string& value);
+
+} // end namespace Blobb
+
+#endif // BLOBB_HASH_HH
@@ -0,0 +1,101 @@
+/** \file      Journal.hh
+    \brief     Header for Journal
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_JOURNAL_HH
+#define BLOBB_JOURNAL_HH
+
+#include "blobb/Warrior.hh"  // warrior
+#include "blobb/Random.hh"   // random numbers
+#include <cstdio>            // cplusplus.com/reference/cstdio/
+#include <thread>            // cplusplus.com/reference/thread/
+
+namespace Blobb {
+
+class BloBB;
+
+/** \class Journal
+    \brief Append-only (write-ahead) journal of BloBB state changes.
+
+    A journaled state is a base snapshot, saved with any archive type,
+    plus the journal file <base>.jnl of records written since:
+    - kWarriorRecord: registered name & warrior (binary archive),
+    - kRandomRecord: random seed & number of iterations.
+
+    Records hold absolute values, so replaying one twice is harmless.
+    Each is written as type (1 byte), payload length (4 bytes), payload
+    and check (XXH64, low 32 bits); a torn last record is dropped.
+
+    Compaction saves a snapshot as the new base on a background thread;
+    the records written meanwhile go to a fresh journal, while the old
+    one is kept as <base>.jnl.1 until the new base is in place.
+*/
+class Journal {
+public:
+  //_____________________________________________________________________________
+  //! \enum eRecord Record types.
+  enum eRecord {
+    kWarriorRecord = 1,  //!< warrior added or modified
+    kRandomRecord  = 2   //!< random generator advanced
+  };
+
+  //! Default journal size [bytes] above which compaction is due
+  static const ULong_t kDefCompactSize = 16 << 20;
+
+  Journal();
+  virtual ~Journal();
+
+  Bool_t open(const string& fileName);
+  void close();
+  //! Is a journal open?
+  inline Bool_t isOpen() const { return mFile != 0; }
+  //! Name of the base state file
+  inline const string& fileName() const { return mFileName; }
+
+  void putWarrior(const string& key, const Warrior& war);
+  void putRandom(const Random& rnd);
+  Bool_t sync();
+
+  //! Number of bytes in the journal
+  inline ULong_t bytes() const { return mBytes; }
+  //! Number of records in the journal
+  inline Pos_t numRecords() const { return mNumRecords; }
+  //! Get the size above which compaction is due (at least the base size)
+  inline ULong_t compactSize() const { return mCompactSize; }
+  //! Set the size above which compaction is due (at least the base size)
+  inline void setCompactSize(ULong_t size){ mCompactSize = size; }
+  //! Is compaction due?
+  inline Bool_t needsCompaction() const 
+  { return mBytes > (mCompactSize > mBaseBytes ? mCompactSize : mBaseBytes); }
+  Bool_t compact(const BloBB& state);
+  Bool_t wait();
+
+  //! Name of the journal of a base state file
+  static inline string JournalName(const string& fileName){ return fileName + ".jnl"; }
+  static Pos_t Replay(const string& fileName, BloBB& blobb);
+
+private:
+  // not copyable
+  Journal(const Journal&);
+  Journal& operator=(const Journal&);
+
+  void append(eRecord type, const string& payload);
+  static ULong_t Scan(const string& jnlName, BloBB* blobb, Pos_t& numRecords);
+
+private:
+  string      mFileName;     //!< base state file
+  FILE*       mFile;         //!< journal file (appending)
+  ULong_t     mBytes;        //!< journal bytes
+  ULong_t     mBaseBytes;    //!< base state file bytes
+  Pos_t       mNumRecords;   //!< journal records
+  ULong_t     mCompactSize;  //!< size above which compaction is due
+  std::thread mCompactor;    //!< background compaction
+  Bool_t      mCompactOk;    //!< last compaction succeeded
+  ULong_t     mCompactBytes; //!< bytes of the compacted base
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_JOURNAL_HH
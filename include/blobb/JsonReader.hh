@@ -0,0 +1,76 @@
+/** \file      JsonReader.hh
+    \brief     Header for JsonReader
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_JSONREADER_HH
+#define BLOBB_JSONREADER_HH
+
+#include "blobb/BloBB.hh"  // master class
+#include <functional>      // cplusplus.com/reference/functional/
+
+namespace Blobb {
+
+/** \class JsonReader
+    \brief Streaming (SAX) loader of BloBB JSON saves.
+
+    The file is read through a fixed-size buffer by rapidjson's SAX
+    reader and each Warrior is built, filtered and stored as soon as
+    its closing brace is read; no document (DOM) is held in memory.
+    Small files, without a filter, are loaded through cereal instead.
+
+    A filter decides, per warrior, whether to keep it and whether to stop
+    parsing; a stopped load keeps the warriors (and state) read so far.
+*/
+class JsonReader {
+public:
+  //_____________________________________________________________________________
+  //! \enum eFilter Filter decisions.
+  enum eFilter {
+    kSkip = 0,  //!< drop the warrior & continue
+    kKeep = 1,  //!< keep the warrior & continue
+    kStop = 2   //!< keep the warrior & stop parsing
+  };
+
+  /** \typedef Filter_t
+      \brief Filter on the registered name and the warrior. */
+  typedef std::function<eFilter(const string& key, const Warrior& war)> Filter_t;
+
+  //! Default size [bytes] below which files are loaded through cereal
+  static const ULong_t kDefDomSize = 8 << 20;
+  //! Default read-buffer size [bytes]
+  static const ULong_t kDefBufferSize = 1 << 20;
+
+  JsonReader(const Filter_t& filter = Filter_t(), ULong_t domSize = kDefDomSize);
+  inline virtual ~JsonReader() { }
+
+  //! Get filter
+  inline const Filter_t& filter() const { return mFilter; }
+  //! Set filter
+  inline void setFilter(const Filter_t& filter){ mFilter = filter; }
+  //! Get the size below which files are loaded through cereal
+  inline ULong_t domSize() const { return mDomSize; }
+  //! Set the size below which files are loaded through cereal (0: never)
+  inline void setDomSize(ULong_t size){ mDomSize = size; }
+
+  Bool_t load(const string& fileName, BloBB& blobb);
+  void read(istream& is, BloBB& blobb);
+
+  //! Number of warriors parsed by the last load or read
+  inline Pos_t numParsed() const { return mNumParsed; }
+  //! Did the filter stop the last load or read?
+  inline Bool_t stopped() const { return mStopped; }
+
+  static Bool_t LoadWarrior(const string& fileName, const string& key, Warrior& war);
+
+private:
+  Filter_t mFilter;     //!< warrior filter (empty: keep all)
+  ULong_t  mDomSize;    //!< size below which cereal is used
+  Pos_t    mNumParsed;  //!< warriors parsed
+  Bool_t   mStopped;    //!< stopped by the filter
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_JSONREADER_HH
@@ -8,6 +8,7 @@
 #define BLOBB_LOGSERVICE_HH
 
 #include <iostream>  // cplusplus.com/reference/iostream/
+#include <string>    // cplusplus.com/reference/string/
 using std::ostream;  // STL out-stream
 using std::endl;     // STL end-line
 
@@ -36,6 +37,25 @@ enum eLogTopic {
   Plotting       = 32  //!< data handling
 };
 
+//! Mask of all log topics.
+const unsigned int kAllLogTopics = 
+  None | InputArguments | Evaluation | ObjectHandling | DataHandling | Plotting;
+
+//_____________________________________________________________________________
+/** \enum eLogOverflow What the asynchronous log does when its ring is full. */
+enum eLogOverflow {
+  kLogBlock = 0, //!< wait for space
+  kLogDrop  = 1  //!< drop the message
+};
+
+//_____________________________________________________________________________
+/** \def BLOBB_LOG_MIN_LEVEL
+    Least severe log level compiled in; messages of a less severe level
+    (e.g. kDebug for 4) are stripped at compile time. Default: all. */
+#ifndef BLOBB_LOG_MIN_LEVEL
+  #define BLOBB_LOG_MIN_LEVEL 5
+#endif
+
 //_____________________________________________________________________________
 // logging methods
 void SetLogPrefix(const char* prefix);
@@ -43,29 +63,100 @@ void SetLogLevel(eLogLevel level);
 eLogLevel GetLogLevel();
 eLogLevel LogLevel(const char* name);
 eLogLevel IntToLogLevel(int val);
+void SetLogTopics(unsigned int mask);
+unsigned int GetLogTopics();
+unsigned int LogTopics(const char* names);
+const char* LogLevelName(eLogLevel level);
+const char* LogTopicName(eLogTopic topic);
 ostream& Log(eLogLevel level, eLogTopic topic, bool skipPrefix = false);
 
+// asynchronous backend; synchronous (direct to the streams) by default
+void StartAsyncLog(eLogOverflow overflow = kLogBlock, unsigned long capacity = 8192,
+		   const std::string& fileName = "");
+void StopAsyncLog();
+bool IsAsyncLog();
+void FlushLog();
+unsigned long GetLogDropped();
+
+//_____________________________________________________________________________
+/** \struct LogConfig
+    \brief Log configuration: level, topic mask & prefix. */
+struct LogConfig {
+  eLogLevel    level;   //!< logging level; see SetLogLevel
+  unsigned int topics;  //!< topic mask; see SetLogTopics
+  std::string  prefix;  //!< message prefix; see SetLogPrefix
+};
+
+//! Process-wide log configuration.
+extern LogConfig gLogConfig;
+//! Log configuration of the thread: its LogContext, if any, else gLogConfig.
+extern thread_local LogConfig* gThreadLogConfig;
+
+//_____________________________________________________________________________
+/** \class LogContext
+    \brief Thread-local log configuration, while in scope.
+
+    Starts as a copy of the thread's current configuration; until the
+    context is destroyed, SetLogLevel, SetLogTopics & SetLogPrefix on
+    this thread change only it, e.g. to debug one of several parallel
+    sessions. Contexts nest; each must be destroyed on its thread.
+*/
+class LogContext {
+public:
+  LogContext();
+  ~LogContext();
+
+private:
+  // not copyable
+  LogContext(const LogContext&);
+  LogContext& operator=(const LogContext&);
+
+  LogConfig  mConfig;    //!< the thread's configuration
+  LogConfig* mPrevious;  //!< configuration restored at destruction
+};
+
+//_____________________________________________________________________________
+/** Is a message of this level & topic logged (compiled in, at the log
+    level and, if less severe than warnings, in the topic mask) by the
+    calling thread? */
+inline bool LogEnabled(eLogLevel level, eLogTopic topic)
+{
+  if(level > BLOBB_LOG_MIN_LEVEL) return false;
+  const LogConfig& config = *gThreadLogConfig;
+  return (level <= config.level && (level <= kWarning || (topic & config.topics) != 0));
+}
+
 } // end namespace Blobb
 
 
+//_____________________________________________________________________________
+/** \def BLOBB_LOG
+    Stream a message if its level & topic are enabled; otherwise the streamed
+    operands are not evaluated. A (one-pass) for loop keeps the macro a
+    single statement that cannot capture a following "else", so it is safe
+    (and warning-free) as the body of an unbraced if-else. */
+#define BLOBB_LOG(l,t,np) \
+  for(bool blobbLogOn_ = Blobb::LogEnabled(l,t); blobbLogOn_; blobbLogOn_ = false) \
+    Blobb::Log(l,t,np)
+
 //_____________________________________________________________________________
 // Shortcut streamer definitions, with topic 
 //! Stream debug message macro. 
-#define loutD(t) Blobb::Log(Blobb::kDebug,t) 
+#define loutD(t) BLOBB_LOG(Blobb::kDebug,t,false) 
 //! Stream info message macro. 
-#define loutI(t) Blobb::Log(Blobb::kInfo,t) 
+#define loutI(t) BLOBB_LOG(Blobb::kInfo,t,false) 
 //! Stream progress message macro. 
-#define loutP(t) Blobb::Log(Blobb::kProgress,t) 
+#define loutP(t) BLOBB_LOG(Blobb::kProgress,t,false) 
 //! Stream warning message macro. 
-#define loutW(t) Blobb::Log(Blobb::kWarning,t) 
+#define loutW(t) BLOBB_LOG(Blobb::kWarning,t,false) 
 //! Stream error message macro. 
-#define loutE(t) Blobb::Log(Blobb::kError,t) 
+#define loutE(t) BLOBB_LOG(Blobb::kError,t,false) 
 //! Stream fatal message macro. 
-#define loutF(t) Blobb::Log(Blobb::kFatal,t) 
+#define loutF(t) BLOBB_LOG(Blobb::kFatal,t,false) 
 
 //! Stream debug message macro - no prefix. 
-#define loutnpD(t) Blobb::Log(Blobb::kDebug,t,true) 
+#define loutnpD(t) BLOBB_LOG(Blobb::kDebug,t,true) 
 //! Stream progress message macro - no prefix. 
-#define loutnpP(t) Blobb::Log(Blobb::kProgress,t,true) 
+#define loutnpP(t) BLOBB_LOG(Blobb::kProgress,t,true) 
 
 #endif // end BLOBB_LOGSERVICE_HH
@@ -0,0 +1,24 @@
+/** \file      LzCodec.hh
+    \brief     Header for the LZ block codec.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_LZCODEC_HH
+#define BLOBB_LZCODEC_HH
+
+#include "blobb/Common.hh"  // common includes
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Fast LZ77 block codec (LZ4-style sequences: token, literals, 16-bit
+// offset, match length). Blocks are independent; decompression is
+// bounds-checked and fails on corrupt input.
+ULong_t LzBound(ULong_t length);
+ULong_t LzCompress(const Byte_t* src, ULong_t length, Byte_t* dst, ULong_t capacity);
+Bool_t LzDecompress(const Byte_t* src, ULong_t length, Byte_t* dst, ULong_t rawLength);
+
+} // end namespace Blobb
+
+#endif // BLOBB_LZCODEC_HH
@@ -0,0 +1,129 @@
+/** \file      LzStreamBuf.hh
+    \brief     Header for LzOStreamBuf & LzIStreamBuf
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_LZSTREAMBUF_HH
+#define BLOBB_LZSTREAMBUF_HH
+
+#include "blobb/Common.hh"  // common includes
+#include <streambuf>        // cplusplus.com/reference/streambuf/
+
+namespace Blobb {
+
+class LzWorkers;
+
+void   SetLzThreads(UInt_t numThreads);
+UInt_t GetLzThreads();
+
+/** \class LzOStreamBuf
+    \brief Output stream buffer compressing blocks (LzCodec) to a sink.
+
+    Written bytes are cut into fixed-size blocks; a batch of blocks (about
+    1 MiB per thread) is compressed in parallel and written, in order, as
+    - header: "BLZ1", block size (4 bytes),
+    - per block: raw length, stored length (| 2^31 if stored raw) and
+      check (XXH64, low 32 bits, of the raw bytes), then the payload,
+    - end: a raw length of 0.
+    All integers are little-endian. close() (or the destructor) writes
+    the last blocks and the end marker.
+    The compression threads are started with the first batch and kept
+    until destruction; by default, there are as many as set by
+    SetLzThreads on the creating thread.
+    The start of each block is recorded, for random access (see ArchiveIndex);
+    tellp on a stream of the buffer gives the position in the raw stream.
+*/
+class LzOStreamBuf : public std::streambuf {
+public:
+  /** \struct Block_t
+      \brief Start of a block in the raw and compressed streams. */
+  struct Block_t {
+    ULong_t rawOffset;     //!< offset of the first raw byte
+    ULong_t storedOffset;  //!< offset of the block header
+  };
+
+  //! Default block size [bytes]
+  static const UInt_t kDefBlockSize = 1 << 20;
+  //! Block size [bytes] for random access (the codec's match window)
+  static const UInt_t kSeekBlockSize = 1 << 16;
+
+  LzOStreamBuf(ostream& sink, UInt_t blockSize = kDefBlockSize, UInt_t numThreads = 0);
+  virtual ~LzOStreamBuf();
+
+  void close();
+  //! Number of raw bytes written
+  inline ULong_t rawBytes() const { return mRawBytes; }
+  //! Number of compressed bytes written to the sink
+  inline ULong_t storedBytes() const { return mStoredBytes; }
+  //! Blocks written (offsets from the start of the streams)
+  inline const vector<Block_t>& blocks() const { return mBlocks; }
+
+protected:
+  virtual int_type overflow(int_type c);
+  virtual int sync();
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+			   std::ios_base::openmode which = std::ios_base::out);
+
+private:
+  // not copyable
+  LzOStreamBuf(const LzOStreamBuf&);
+  LzOStreamBuf& operator=(const LzOStreamBuf&);
+
+  void nextBlock();
+  void writeBatch();
+
+private:
+  ostream&                mSink;         //!< compressed output
+  UInt_t                  mBlockSize;    //!< raw block size
+  UInt_t                  mNumThreads;   //!< compression threads
+  LzWorkers*              mWorkers;      //!< compression threads, kept between batches
+  vector< vector<Byte_t> > mRaw;         //!< raw blocks of the batch
+  vector<ULong_t>         mRawSizes;     //!< used bytes of the raw blocks
+  UInt_t                  mBlock;        //!< current block of the batch
+  ULong_t                 mRawBytes;     //!< raw bytes written
+  ULong_t                 mStoredBytes;  //!< bytes written to the sink
+  Bool_t                  mClosed;       //!< end marker written
+  vector<Block_t>         mBlocks;       //!< blocks written
+};
+
+/** \class LzIStreamBuf
+    \brief Input stream buffer decompressing the LzOStreamBuf format.
+
+    A batch of blocks (about 1 MiB per thread) is read and decompressed
+    in parallel when the previous batch is consumed; the threads are
+    kept as for LzOStreamBuf.
+    \warning Throws Exception on corrupt input.
+*/
+class LzIStreamBuf : public std::streambuf {
+public:
+  LzIStreamBuf(istream& source, UInt_t numThreads = 0);
+  virtual ~LzIStreamBuf();
+
+  static void ReadBlock(istream& is, vector<Byte_t>& raw);
+
+protected:
+  virtual int_type underflow();
+
+private:
+  // not copyable
+  LzIStreamBuf(const LzIStreamBuf&);
+  LzIStreamBuf& operator=(const LzIStreamBuf&);
+
+  void readBatch();
+
+private:
+  istream&                mSource;     //!< compressed input
+  UInt_t                  mBlockSize;  //!< raw block size (from the header)
+  UInt_t                  mNumThreads; //!< decompression threads
+  LzWorkers*              mWorkers;    //!< decompression threads, kept between batches
+  vector< vector<Byte_t> > mRaw;       //!< raw blocks of the batch
+  vector<ULong_t>         mRawSizes;   //!< used bytes of the raw blocks
+  UInt_t                  mBlock;      //!< current block of the batch
+  UInt_t                  mNumBlocks;  //!< blocks in the batch
+  Bool_t                  mEnd;        //!< end marker read
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_LZSTREAMBUF_HH
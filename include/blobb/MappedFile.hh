@@ -0,0 +1,56 @@
+/** \file      MappedFile.hh
+    \brief     Header for MappedFile
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_MAPPEDFILE_HH
+#define BLOBB_MAPPEDFILE_HH
+
+#include "blobb/Common.hh"  // common includes
+
+namespace Blobb {
+
+/** \class MappedFile
+    \brief Read-only, memory-mapped view of a file.
+
+    Opening maps the file without reading it; pages are faulted in
+    by the OS when first touched.
+    Without <sys/mman.h> the file is read into memory instead.
+    A terminated file is followed by a null character (for C-string parsers); it is
+    read into memory when the mapping cannot provide one.
+*/
+class MappedFile {
+public:
+  MappedFile();
+  MappedFile(const string& fileName, Bool_t terminated = kFalse);
+  virtual ~MappedFile();
+
+  Bool_t open(const string& fileName, Bool_t terminated = kFalse);
+  void close();
+  //! Is a file mapped?
+  inline Bool_t isOpen() const { return mData != 0; }
+  //! Name of the mapped file
+  inline const string& fileName() const { return mFileName; }
+  //! Start of the mapped bytes
+  inline const Byte_t* data() const { return mData; }
+  //! Number of mapped bytes
+  inline ULong_t size() const { return mSize; }
+
+private:
+  // not copyable
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  Bool_t read(const string& fileName);
+
+private:
+  string        mFileName;  //!< file name
+  const Byte_t* mData;      //!< mapped bytes
+  ULong_t       mSize;      //!< number of mapped bytes
+  Bool_t        mIsMapped;  //!< mapped (true) or read into memory (false)
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_MAPPEDFILE_HH
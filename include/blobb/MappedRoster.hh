@@ -0,0 +1,75 @@
+/** \file      MappedRoster.hh
+    \brief     Header for MappedRoster
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_MAPPEDROSTER_HH
+#define BLOBB_MAPPEDROSTER_HH
+
+#include "blobb/MappedFile.hh"  // memory-mapped file
+#include "blobb/Warrior.hh"     // warrior
+#include "blobb/TimeStamp.hh"   // time-stamp
+#include "blobb/Random.hh"      // random numbers
+
+namespace Blobb {
+
+/** \class MappedRoster
+    \brief Lazy, memory-mapped reader (and writer) of the kMapped archive.
+
+    The file has a fixed layout, in host byte order:
+    - a header with the state (name, title, times, random generator) and
+      the section offsets,
+    - a name index: one entry per warrior, sorted by name,
+    - fixed-size warrior records, with every attribute value, error and range,
+    - a pool of the (de-duplicated) strings referenced by the above.
+
+    Opening only maps the file and checks the header, independent of the
+    number of warriors.
+    A Warrior is built when it is asked for, touching only its
+    index entry, record and strings.
+*/
+class MappedRoster {
+public:
+  MappedRoster();
+  MappedRoster(const string& fileName);
+  inline virtual ~MappedRoster() { }
+
+  Bool_t open(const string& fileName);
+  void close();
+  //! Is a roster file open?
+  inline Bool_t isOpen() const { return mFile.isOpen(); }
+
+  // state
+  string name() const;
+  string title() const;
+  TimeStamp startTime() const;
+  TimeStamp endTime() const;
+  Random random() const;
+
+  // warriors
+  ULong_t size() const;
+  string key(ULong_t i) const;
+  Long_t find(const string& key) const;
+  //! Is there a warrior registered under key?
+  inline Bool_t has(const string& key) const { return find(key) >= 0; }
+  Warrior warrior(ULong_t i) const;
+  Warrior warrior(const string& key) const;
+  void warriors(Warriors_t& wars) const;
+
+  static void Write(ostream& os, const string& name, const string& title,
+		    const TimeStamp& startTime, const TimeStamp& endTime,
+		    const Random& random, const Warriors_t& wars);
+
+private:
+  Bool_t fits(ULong_t offset, ULong_t num, ULong_t size) const;
+  const Byte_t* section(ULong_t offset) const;
+  string str(ULong_t offset, ULong_t length) const;
+
+private:
+  MappedFile mFile;  //!< the mapped file
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_MAPPEDROSTER_HH
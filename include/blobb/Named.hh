@@ -28,18 +28,21 @@ public:
   //! Get name
   inline const string& name() const { return mName; }
   //! Set name
-  inline void setName(const string& name){ mName = name; }
+  inline void setName(const string& name){ mName = name; invalidateHash(); }
   //! Has name?
   inline Bool_t hasName() const { return mName != ""; }
   //! Get title
   inline const string& title() const { return mTitle; }
   //! Set title
-  inline void setTitle(const string& title){ mTitle = title; }
+  inline void setTitle(const string& title){ mTitle = title; invalidateHash(); }
   //! Has title?
   inline Bool_t hasTitle() const { return mTitle != ""; }
   //! Set name & title
   inline void setNameTitle(const string& name, const string& title)
-  { mName = name; mTitle = title; }
+  { mName = name; mTitle = title; invalidateHash(); }
+
+  virtual ULong_t hash() const;
+  virtual void stream(StreamWriter& sw) const;
 
   // printing 
   void printName(ostream& os) const;
@@ -49,9 +52,15 @@ public:
   virtual Bool_t readFromUI(CLUI& clui, Bool_t verbose = kFalse);
   virtual void printToUI(CLUI& clui, Bool_t verbose = kFalse) const;
 
+protected:
+  virtual ULong_t computeHash() const;
+  //! Mark the cached hash as stale; call from every mutator.
+  inline void invalidateHash(){ mHash = 0; }
+
 private:
-  string mName;   //!< name
-  string mTitle;  //!< title
+  string mName;           //!< name
+  string mTitle;          //!< title
+  mutable ULong_t mHash;  //!< cached content hash (0 = stale)
 
 private:
   //! cerealize
@@ -59,6 +68,7 @@ private:
   {
     ar(BLOBB_NVP(mName),
        BLOBB_NVP(mTitle));
+    invalidateHash();
   }
   //! Macro: define concrete class
   BLOBB_CLASS_DEF(Named);   
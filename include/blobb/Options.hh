@@ -46,6 +46,24 @@ public:
   inline Bool_t batch() const { return mBatch; }
   //! Set is print help
   inline void setBatch(Bool_t batch = kTrue){ mBatch = batch; }
+  //! Get batch script file name (empty: stdin)
+  inline const string& scriptFileName() const { return mScriptFileName; }
+  //! Set batch script file name
+  inline void setScriptFileName(const string& name){ mScriptFileName = name; }
+  //! Get batch results file name (empty: stdout)
+  inline const string& outFileName() const { return mOutFileName; }
+  //! Set batch results file name
+  inline void setOutFileName(const string& name){ mOutFileName = name; }
+
+  //! Get binary log file name (empty: text log)
+  inline const string& binaryLogFileName() const { return mBinaryLogFileName; }
+  //! Set binary log file name
+  inline void setBinaryLogFileName(const string& name){ mBinaryLogFileName = name; }
+
+  //! tournament dashboard?
+  inline Bool_t dashboard() const { return mDashboard; }
+  //! Set is tournament dashboard
+  inline void setDashboard(Bool_t dashboard = kTrue){ mDashboard = dashboard; }
 
   //! Get program name
   inline const string& progName() const { return mProgName; }
@@ -66,6 +84,10 @@ protected:
   Bool_t     mBatch;        //!< batch-mode
   string     mProgName;     //!< program (executable) name
   string     mInFileName;   //!< input file name
+  string     mScriptFileName; //!< batch script file name
+  string     mOutFileName;    //!< batch results file name
+  Bool_t     mDashboard;      //!< batch tournament dashboard
+  string     mBinaryLogFileName; //!< binary log file name
 
 private:
   //! cerealize
@@ -76,7 +98,11 @@ private:
        BLOBB_NVP(mCopyright),
        BLOBB_NVP(mBatch),
        BLOBB_NVP(mProgName),
-       BLOBB_NVP(mInFileName));
+       BLOBB_NVP(mInFileName),
+       BLOBB_NVP(mScriptFileName),
+       BLOBB_NVP(mOutFileName),
+       BLOBB_NVP(mDashboard),
+       BLOBB_NVP(mBinaryLogFileName));
   }
   //! Macro: define concrete class
   BLOBB_CLASS_DEF(Options);   
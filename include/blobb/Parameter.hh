@@ -9,6 +9,11 @@
 
 #include "blobb/Named.hh"  // named base class
 
+namespace cereal {
+  class PortableBinaryOutputArchive;
+  class PortableBinaryInputArchive;
+}
+
 namespace Blobb {
 
 class Random;
@@ -33,22 +38,22 @@ public:
   //! Get value
   inline Double_t value() const { return mValue; }
   //! Set value
-  inline void setValue(Double_t value){ mValue = value; }
+  inline void setValue(Double_t value){ mValue = value; invalidateHash(); }
   //! Increment value
-  inline void incrValue(Double_t value){ mValue += value; }
+  inline void incrValue(Double_t value){ mValue += value; invalidateHash(); }
   //! Get error
   inline Double_t error() const { return mError; }
   //! Set error
-  inline void setError(Double_t error){ mError = error; }
+  inline void setError(Double_t error){ mError = error; invalidateHash(); }
 
   //! Get min
   inline Double_t min() const { return mMin; }
   //! Set min
-  inline void setMin(Double_t min){ mMin = min; }
+  inline void setMin(Double_t min){ mMin = min; invalidateHash(); }
   //! Get max
   inline Double_t max() const { return mMax; }
   //! Set max
-  inline void setMax(Double_t max){ mMax = max; }
+  inline void setMax(Double_t max){ mMax = max; invalidateHash(); }
   void range(Double_t& min, Double_t& max) const;
   void setRange(Double_t min = 0., Double_t max = 100.);
   //! Has a range
@@ -58,6 +63,8 @@ public:
 
   Double_t getRandom(const Random& random);
 
+  virtual void stream(StreamWriter& sw) const;
+
   // printing
   void printValue(ostream& os) const;
   void printExtras(ostream& os) const;
@@ -66,6 +73,9 @@ public:
   virtual Bool_t readFromUI(CLUI& clui, Bool_t verbose = kFalse);
   virtual void printToUI(CLUI& clui, Bool_t verbose = kFalse) const;
 
+protected:
+  virtual ULong_t computeHash() const;
+
 protected:
   Double_t mValue;  //!< value
   Double_t mError;  //!< error
@@ -81,7 +91,10 @@ private:
        BLOBB_NVP(mError),
        BLOBB_NVP(mMin),
        BLOBB_NVP(mMax));
+    invalidateHash();
   }
+  void serialize(cereal::PortableBinaryOutputArchive& ar);
+  void serialize(cereal::PortableBinaryInputArchive& ar);
   //! Macro: define concrete class
   BLOBB_CLASS_DEF(Parameter);   
 };
@@ -12,6 +12,7 @@
 namespace Blobb {
 
 class CLUI;
+class Sink;
 
 /** \class Printable 
     \brief Utility class for printing objects.
@@ -56,6 +57,7 @@ public:
 			   const string& indent="") const;
   virtual void print(ostream& os, const string& indent="") const;
   virtual void print(CLUI& clui, const string& indent="") const;
+  virtual void print(Sink& sink, const string& indent="") const;
   virtual void print(const string& indent="") const;
 
   // Virtual hook function for class-specific content implementation
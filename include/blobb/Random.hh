@@ -27,6 +27,8 @@ public:
   virtual Bool_t isEmpty() const;
   virtual void clear();
   virtual Bool_t isEqual(const AbsObject& other) const;
+  virtual ULong_t hash() const;
+  virtual void stream(StreamWriter& sw) const;
 
   //! Get seed
   inline UInt_t seed() const { return mSeed; }
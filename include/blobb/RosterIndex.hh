@@ -0,0 +1,114 @@
+/** \file      RosterIndex.hh
+    \brief     Header for RosterIndex
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_ROSTERINDEX_HH
+#define BLOBB_ROSTERINDEX_HH
+
+#include "blobb/Warrior.hh"  // warrior
+#include <unordered_map>     // cplusplus.com/reference/unordered_map/
+
+namespace Blobb {
+
+/** \class RosterIndex
+    \brief Columnar secondary index over a roster of warriors.
+
+    Each indexed attribute value and error is held in its own contiguous
+    array (one "row" per warrior), so that range filters, sorting and
+    top-k queries run over plain arrays of doubles instead of walking
+    the Warriors_t map through Parameter accessors.
+    Rows are identified by their position, row ids are not stable
+    under remove().
+*/
+class RosterIndex {
+public:
+  //_____________________________________________________________________________
+  //! \enum eAttribute Indexed warrior attributes.
+  enum eAttribute {
+    kProwess       = 0,
+    kAgility       = 1,
+    kIntelligence  = 2,
+    kPersonality   = 3,
+    kHealth        = 4,
+    kNumAttributes = 5
+  };
+
+  //_____________________________________________________________________________
+  //! \enum eField Indexed parameter fields.
+  enum eField {
+    kValue = 0,
+    kError = 1
+  };
+
+  //_____________________________________________________________________________
+  /** \struct Cut
+      \brief Open range, (min, max), on one attribute field.
+  */
+  struct Cut {
+    //! Constructor
+    Cut(eAttribute attribute, Double_t min = kMinD, Double_t max = kMaxD,
+	eField field = kValue)
+      : mAttribute(attribute), mField(field), mMin(min), mMax(max)
+    {}
+    eAttribute mAttribute;  //!< attribute
+    eField     mField;      //!< field
+    Double_t   mMin;        //!< exclusive minimum
+    Double_t   mMax;        //!< exclusive maximum
+  };
+
+public:
+  RosterIndex();
+  RosterIndex(const Warriors_t& wars);
+  inline virtual ~RosterIndex() { }
+
+  void clear();
+  void rebuild(const Warriors_t& wars);
+  void update(const string& name, const Warrior& war);
+  //! Insert or update the row of a warrior (by warrior name)
+  inline void update(const Warrior& war){ update(war.name(), war); }
+  Bool_t remove(const string& name);
+
+  //! Number of rows
+  inline Pos_t size() const { return mNames.size(); }
+  //! Is there a row for this warrior name?
+  inline Bool_t has(const string& name) const { return mRows.count(name) == 1; }
+  //! Row of a warrior name; throws out_of_range if not indexed
+  inline Pos_t row(const string& name) const { return mRows.at(name); }
+  //! Warrior name of a row
+  inline const string& name(Pos_t row) const { return mNames.at(row); }
+  //! All warrior names, by row
+  inline const vector<string>& names() const { return mNames; }
+  //! Column of an attribute field, by row
+  inline const vector<Double_t>& column(eAttribute attribute, eField field = kValue) const
+  { return mColumns[columnNumber(attribute, field)]; }
+  //! Attribute field of a row
+  inline Double_t at(Pos_t row, eAttribute attribute, eField field = kValue) const
+  { return column(attribute, field).at(row); }
+
+  // queries
+  vector<Pos_t> select(const Cut& cut) const;
+  vector<Pos_t> select(const vector<Cut>& cuts) const;
+  vector<Pos_t> sorted(eAttribute attribute, Bool_t descending = kFalse,
+		       eField field = kValue) const;
+  vector<Pos_t> top(eAttribute attribute, Pos_t k, eField field = kValue) const;
+  vector<string> names(const vector<Pos_t>& rows) const;
+
+  // utilities
+  static const Parameter& GetAttribute(const Warrior& war, eAttribute attribute);
+  static string GetAttributeName(eAttribute attribute);
+
+private:
+  Pos_t columnNumber(eAttribute attribute, eField field) const;
+  void setRow(Pos_t row, const Warrior& war);
+
+private:
+  vector<string>                   mNames;    //!< warrior name, by row
+  std::unordered_map<string,Pos_t> mRows;     //!< row, by warrior name
+  vector<Double_t>                 mColumns[2*kNumAttributes];  //!< attribute (value, error) columns
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_ROSTERINDEX_HH
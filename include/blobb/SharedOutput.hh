@@ -0,0 +1,24 @@
+/** \file      SharedOutput.hh
+    \brief     Header for writing to streams shared between threads
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_SHAREDOUTPUT_HH
+#define BLOBB_SHAREDOUTPUT_HH
+
+#include "blobb/Common.hh"  // common includes
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Write a block (e.g. complete lines) to a stream shared between
+    threads, and flush it. Blocks written to the same stream buffer are
+    serialized by a lock of that buffer (one of a small striped set, not
+    a global lock), so concurrent blocks are never interleaved; the
+    lock is only held for the write itself. */
+void WriteShared(ostream& os, CChar_t* data, ULong_t size);
+
+} // end namespace Blobb
+
+#endif // BLOBB_SHAREDOUTPUT_HH
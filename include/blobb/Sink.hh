@@ -0,0 +1,163 @@
+/** \file      Sink.hh
+    \brief     Header for the output sinks
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_SINK_HH
+#define BLOBB_SINK_HH
+
+#include "blobb/Common.hh"  // common includes
+#include <cstdio>           // cplusplus.com/reference/cstdio/
+#include <streambuf>        // cplusplus.com/reference/streambuf/
+
+namespace Blobb {
+
+/** \class Sink
+    \brief Destination of text output.
+
+    A sink is a stream buffer with its own stream (os()), so anything
+    writing to an ostream can target it: a CLUI (setSink), and so a
+    FightEngine or a BloBB, or Printable::printStream. Sinks are not
+    copyable.
+*/
+class Sink : public std::streambuf {
+public:
+  Sink();
+  inline virtual ~Sink() { }
+
+  //! Stream on the sink
+  inline ostream& os(){ return mOs; }
+  //! Does the sink discard the output?
+  virtual Bool_t isNull() const { return kFalse; }
+
+protected:
+  ostream mOs;  //!< stream on the sink
+
+private:
+  // not copyable
+  Sink(const Sink&);
+  Sink& operator=(const Sink&);
+};
+
+/** \class NullSink
+    \brief Sink discarding the output, without formatting it: its stream
+    is always bad (badbit), so insertions return at once.
+*/
+class NullSink : public Sink {
+public:
+  NullSink();
+  inline virtual ~NullSink() { }
+  //! Does the sink discard the output?
+  virtual Bool_t isNull() const { return kTrue; }
+
+protected:
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n);
+};
+
+/** \class MemorySink
+    \brief Sink collecting the output in memory, in a growing string.
+*/
+class MemorySink : public Sink {
+public:
+  explicit MemorySink(Pos_t reserve = 0);
+  inline virtual ~MemorySink() { }
+
+  //! Get the output
+  inline const string& str() const { return mText; }
+  //! Get the size of the output [bytes]
+  inline ULong_t size() const { return mText.size(); }
+  //! Discard the output (the memory is kept)
+  inline void clear(){ mText.clear(); }
+
+protected:
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n);
+
+private:
+  string mText;  //!< output
+};
+
+/** \class BufferedSink
+    \brief Sink collecting the output in a buffer, written out when full
+    or synced (flush, endl).
+
+    A block larger than the free space is written together with the
+    buffer, without copying it (writeOut with two pieces). Write errors
+    make the stream bad.
+*/
+class BufferedSink : public Sink {
+public:
+  explicit BufferedSink(Pos_t bufferSize = DefBufferSize);
+  inline virtual ~BufferedSink() { }
+
+  //! Number of writes out (e.g. system calls)
+  inline ULong_t numWrites() const { return mNumWrites; }
+
+  //! Default size of the buffer [bytes].
+  static const Pos_t DefBufferSize;
+
+protected:
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n);
+  virtual int sync();
+
+  Bool_t drain(CChar_t* block = 0, ULong_t size = 0);
+  /** Write the buffered data and then the block out, entirely.
+      \return "success" boolean. */
+  virtual Bool_t writeOut(CChar_t* data, ULong_t size, CChar_t* block, ULong_t blockSize) = 0;
+
+private:
+  vector<Char_t> mBuffer;     //!< buffer
+  ULong_t        mNumWrites;  //!< writes out
+};
+
+/** \class FileSink
+    \brief Sink writing to a file, through its buffer.
+*/
+class FileSink : public BufferedSink {
+public:
+  explicit FileSink(Pos_t bufferSize = DefBufferSize);
+  FileSink(const string& fileName, Bool_t append = kFalse, Pos_t bufferSize = DefBufferSize);
+  virtual ~FileSink();
+
+  Bool_t open(const string& fileName, Bool_t append = kFalse);
+  Bool_t close();
+  //! Is a file open?
+  inline Bool_t isOpen() const { return (mFile != 0); }
+  //! Get the file name
+  inline const string& fileName() const { return mFileName; }
+
+protected:
+  virtual Bool_t writeOut(CChar_t* data, ULong_t size, CChar_t* block, ULong_t blockSize);
+
+private:
+  std::FILE* mFile;      //!< file, unbuffered
+  string     mFileName;  //!< file name
+};
+
+/** \class FdSink
+    \brief Sink writing to a file descriptor, e.g. a pipe or a socket,
+    through its buffer; buffer & block are gathered in one writev call.
+    \note Needs POSIX <unistd.h> (& <sys/uio.h> to gather).
+*/
+class FdSink : public BufferedSink {
+public:
+  explicit FdSink(Int_t fd, Bool_t owned = kFalse, Pos_t bufferSize = DefBufferSize);
+  virtual ~FdSink();
+
+  //! Get the file descriptor
+  inline Int_t fd() const { return mFd; }
+
+protected:
+  virtual Bool_t writeOut(CChar_t* data, ULong_t size, CChar_t* block, ULong_t blockSize);
+
+private:
+  Int_t  mFd;     //!< file descriptor
+  Bool_t mOwned;  //!< closed at destruction
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_SINK_HH
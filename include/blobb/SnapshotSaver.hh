@@ -0,0 +1,70 @@
+/** \file      SnapshotSaver.hh
+    \brief     Header for SnapshotSaver
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_SNAPSHOTSAVER_HH
+#define BLOBB_SNAPSHOTSAVER_HH
+
+#include "blobb/Common.hh"  // common includes
+#include <atomic>           // cplusplus.com/reference/atomic/
+#include <functional>       // cplusplus.com/reference/functional/
+#include <thread>           // cplusplus.com/reference/thread/
+
+namespace Blobb {
+
+/** \class SnapshotSaver
+    \brief Writes a file on a background thread, one save at a time.
+
+    The writer (typically saving a snapshot copy of the state) writes a
+    temporary file next to the target, with the same extension; it is
+    then synced to disk (fsync) and renamed over the target, so the
+    target is always either the old or the complete new file; the
+    directory is synced last, so that the rename survives a crash too.
+
+    Completion is reported by the optional callback (on the background
+    thread) and, on the calling thread, by isBusy() & wait().
+*/
+class SnapshotSaver {
+public:
+  /** \typedef Writer_t
+      \brief Writes the snapshot to the given (temporary) file. */
+  typedef std::function<Bool_t(const string& fileName)> Writer_t;
+  /** \typedef Done_t
+      \brief Called on completion with the target file and success. */
+  typedef std::function<void(const string& fileName, Bool_t success)> Done_t;
+
+  SnapshotSaver();
+  virtual ~SnapshotSaver();
+
+  Bool_t start(const string& fileName, const Writer_t& writer, const Done_t& done = Done_t());
+  Bool_t wait();
+  //! Is a save running?
+  inline Bool_t isBusy() const { return mBusy; }
+  //! Has a save been started but not yet waited for?
+  inline Bool_t isPending() const { return mThread.joinable(); }
+  //! Target of the last save
+  inline const string& fileName() const { return mFileName; }
+  //! Did the last (waited for) save succeed?
+  inline Bool_t success() const { return mSuccess; }
+
+  static string TempName(const string& fileName);
+  static Bool_t SyncFile(const string& fileName);
+  static Bool_t SyncDir(const string& fileName);
+
+private:
+  // not copyable
+  SnapshotSaver(const SnapshotSaver&);
+  SnapshotSaver& operator=(const SnapshotSaver&);
+
+private:
+  string              mFileName;  //!< target of the last save
+  std::thread         mThread;    //!< background save
+  std::atomic<Bool_t> mBusy;      //!< save running
+  Bool_t              mSuccess;   //!< last save succeeded
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_SNAPSHOTSAVER_HH
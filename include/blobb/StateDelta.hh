@@ -0,0 +1,94 @@
+/** \file      StateDelta.hh
+    \brief     Header for StateDelta
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_STATEDELTA_HH
+#define BLOBB_STATEDELTA_HH
+
+#include "blobb/BloBB.hh"           // master class
+#include <cereal/types/string.hpp>  // string cerealization
+#include <cereal/types/vector.hpp>  // vector cerealization
+
+namespace Blobb {
+
+/** \class StateDelta
+    \brief Changes of a BloBB state since a previous (base) snapshot.
+
+    Holds the warriors added or changed since the base (matched by name),
+    the names of the removed ones, and the state's name, times & random
+    state. The content hashes of the base and of the new state are kept,
+    so a delta is only applied to its base and the result is checked.
+
+    A delta file names its base file, itself a full save or a delta, so
+    a chain of deltas is loaded from its last file (Load). Delta files
+    are recognised by a ".delta" suffix of the base name, e.g.
+    blobb-1403476702.delta.cnb; BloBB::loadFile loads them via Load.
+    A base file given without a directory is next to the delta.
+*/
+class StateDelta : public Named {
+public:
+  StateDelta();
+  StateDelta(const BloBB& base, const BloBB& state, const string& baseFileName = "");
+  StateDelta(const StateDelta& other, const string& newName = "");
+  StateDelta& operator=(const StateDelta& rhs);
+  inline virtual ~StateDelta() { }
+
+  virtual Bool_t isEmpty() const;
+  virtual void clear();
+  virtual Bool_t isEqual(const AbsObject& other) const;
+
+  void compute(const BloBB& base, const BloBB& state);
+  void apply(BloBB& state, Bool_t check = kTrue) const;
+
+  //! Get base file name
+  inline const string& baseFileName() const { return mBaseFileName; }
+  //! Set base file name
+  inline void setBaseFileName(const string& name){ mBaseFileName = name; }
+  //! Get content hash of the base state
+  inline ULong_t baseHash() const { return mBaseHash; }
+  //! Get content hash of the new state
+  inline ULong_t stateHash() const { return mStateHash; }
+  //! Get added & changed warriors
+  inline const Warriors_t& changed() const { return mChanged; }
+  //! Get names of the removed warriors
+  inline const vector<string>& removed() const { return mRemoved; }
+
+  static Bool_t IsDeltaFile(const string& fileName);
+  static Bool_t Save(const BloBB& state, const string& fileName, const string& baseFileName);
+  static Bool_t Save(const BloBB& state, const string& fileName,
+		     const BloBB& base, const string& baseFileName);
+  static Bool_t Load(const string& fileName, BloBB& state);
+
+private:
+  string         mBaseFileName;  //!< file of the base state
+  ULong_t        mBaseHash;      //!< content hash of the base state
+  ULong_t        mStateHash;     //!< content hash of the new state
+  TimeStamp      mStartTime;     //!< start-time of the new state
+  TimeStamp      mEndTime;       //!< end-time of the new state
+  Random         mRandom;        //!< random numbers of the new state
+  Warriors_t     mChanged;       //!< added & changed warriors
+  vector<string> mRemoved;       //!< names of the removed warriors
+
+private:
+  //! cerealize
+  template <class Archive> void serialize(Archive& ar)
+  {
+    ar(make_nvp("Named", cereal::base_class<Named>(this)),
+       BLOBB_NVP(mBaseFileName),
+       BLOBB_NVP(mBaseHash),
+       BLOBB_NVP(mStateHash),
+       BLOBB_NVP(mStartTime),
+       BLOBB_NVP(mEndTime),
+       BLOBB_NVP(mRandom),
+       BLOBB_NVP(mChanged),
+       BLOBB_NVP(mRemoved));
+  }
+  //! Macro: define concrete class
+  BLOBB_CLASS_DEF(StateDelta);
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_STATEDELTA_HH
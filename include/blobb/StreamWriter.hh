@@ -0,0 +1,91 @@
+/** \file      StreamWriter.hh
+    \brief     Header for StreamWriter
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_STREAMWRITER_HH
+#define BLOBB_STREAMWRITER_HH
+
+#include "blobb/ArchiveTypes.hh"  // archive types
+
+namespace Blobb {
+
+/** \class StreamWriter
+    \brief Incremental JSON/XML writer with the cereal archive layout.
+
+    Nodes and values are written as they are given, through a fixed-size
+    buffer, so memory use does not depend on the size of the object
+    (cereal's XML archive builds a DOM of the whole object first).
+    The output is readable by cereal's JSONInputArchive & XMLInputArchive:
+    - JSON: root object, arrays hold unnamed elements,
+    - XML: \<cereal\> root, arrays have size="dynamic" and value<i> elements.
+
+    Pretty output matches cereal's indentation; compact output has none.
+    The root is closed by close() or the destructor.
+*/
+class StreamWriter {
+public:
+  //! Default buffer size [bytes]
+  static const ULong_t kDefBufferSize = 1 << 20;
+
+  StreamWriter(ostream& os, eArchiveType arcType = kJson, Bool_t compact = kFalse,
+	       ULong_t bufferSize = kDefBufferSize);
+  virtual ~StreamWriter();
+
+  // nodes
+  void startNode(const string& name);
+  void startArray(const string& name);
+  void finishNode();
+
+  // values
+  void value(const string& name, const string& val);
+  void value(const string& name, Double_t val);
+  void value(const string& name, UInt_t val);
+
+  void flush();
+  void close();
+
+  //! Archive type written
+  inline eArchiveType arcType() const { return mArcType; }
+  //! Compact (no indentation) output?
+  inline Bool_t isCompact() const { return mCompact; }
+  //! Number of bytes written so far
+  inline ULong_t bytes() const { return mBytes + mPos; }
+
+private:
+  // not copyable
+  StreamWriter(const StreamWriter&);
+  StreamWriter& operator=(const StreamWriter&);
+
+  /** \struct Level_t
+      \brief Open node. */
+  struct Level_t {
+    string  name;     //!< node name (XML)
+    Bool_t  isArray;  //!< array (true) or object (false)
+    ULong_t count;    //!< number of children so far
+  };
+
+  const string& prefix(const string& name);
+  void put(Char_t c);
+  void put(CChar_t* s, ULong_t length);
+  void put(CChar_t* s);
+  //! Append a string
+  inline void put(const string& s){ put(s.data(), s.size()); }
+  void putEscaped(const string& s);
+  void indent(ULong_t depth);
+
+private:
+  ostream&         mOs;       //!< output stream
+  eArchiveType     mArcType;  //!< kJson or kXml
+  Bool_t           mCompact;  //!< no indentation
+  vector<Char_t>   mBuffer;   //!< output buffer
+  ULong_t          mPos;      //!< used bytes in the buffer
+  ULong_t          mBytes;    //!< flushed bytes
+  vector<Level_t>  mLevels;   //!< open nodes
+  string           mTag;      //!< generated (XML array element) name
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_STREAMWRITER_HH
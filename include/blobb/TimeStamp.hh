@@ -48,6 +48,7 @@ public:
   Bool_t isEmpty() const;
   void clear();
   Bool_t isEqual(const AbsObject& other) const;
+  ULong_t hash() const;
 
   inline Bool_t isSortable() const { return true; }
   Int_t compare(const AbsObject& other) const;
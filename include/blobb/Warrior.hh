@@ -9,6 +9,7 @@
 
 #include "blobb/Named.hh"      // named base class
 #include "blobb/Parameter.hh"  // parameter
+#include <map>                   // cplusplus.com/reference/map/
 
 namespace Blobb {
 
@@ -36,6 +37,9 @@ public:
   string updateDisability(Bool_t forf, const Random& random);
   Bool_t collapsed() const;
 
+  virtual ULong_t hash() const;
+  virtual void stream(StreamWriter& sw) const;
+
   // printing
   void printValue(ostream& os) const;
   void printExtras(ostream& os) const;
@@ -59,6 +63,9 @@ public:
   Parameter mFatigueTime;   //!< fatigueTime
   Parameter mHealthTime;    //!< healthTime
 
+protected:
+  virtual ULong_t computeHash() const;
+
 private:
   //! cerealize
   template <class Archive> void serialize(Archive& ar)
@@ -80,6 +87,12 @@ private:
   BLOBB_CLASS_DEF(Warrior);   
 };
 
+//_____________________________________________________________________________
+/** \typedef std::map<string,Warrior> Warriors_t 
+    \brief A std::map of Warrior's. 
+*/
+typedef std::map<string,Warrior> Warriors_t;
+
 } // end namespace Blobb
 
 #endif // BLOBB_WARRIOR_HH
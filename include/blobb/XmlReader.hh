@@ -0,0 +1,39 @@
+/** \file      XmlReader.hh
+    \brief     Header for XmlReader
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#ifndef BLOBB_XMLREADER_HH
+#define BLOBB_XMLREADER_HH
+
+#include "blobb/BloBB.hh"  // master class
+
+namespace Blobb {
+
+/** \class XmlReader
+    \brief Memory-mapped, non-copying loader of BloBB XML saves.
+
+    The file is mapped (MappedFile) and parsed in place by rapidxml in
+    non-destructive mode: nodes point into the mapping, nothing is copied
+    or terminated.
+    Numbers are converted straight from the mapped text into the Parameter
+    fields; only names and titles become strings (with entities decoded).
+*/
+class XmlReader {
+public:
+  XmlReader();
+  inline virtual ~XmlReader() { }
+
+  Bool_t load(const string& fileName, BloBB& blobb);
+
+  //! Number of warriors read by the last load
+  inline Pos_t numParsed() const { return mNumParsed; }
+
+private:
+  Pos_t mNumParsed;  //!< warriors read
+};
+
+} // end namespace Blobb
+
+#endif // BLOBB_XMLREADER_HH
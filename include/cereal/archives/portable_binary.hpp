@@ -160,7 +160,7 @@ namespace cereal
         {
           std::uint8_t * ptr = reinterpret_cast<std::uint8_t*>( data );
           for( std::size_t i = 0; i < size; i += DataSize )
-            portable_binary_detail::swap_bytes<DataSize>( ptr );
+            portable_binary_detail::swap_bytes<DataSize>( ptr + i );
         }
       }
 
@@ -4,6 +4,10 @@
 // Copyright (c) 2011 Milo Yip (miloyip@gmail.com)
 // Version 0.1
 
+// BloBB local change (not upstream): ParseNumber converts doubles with
+// strtod in the C locale (StrtodC), correctly rounded whatever the host
+// program's LC_NUMERIC, instead of accumulating digits & scaling by Pow10.
+
 #include "rapidjson.h"
 #include "internal/pow10.h"
 #include "internal/stack.h"
@@ -12,7 +16,12 @@
 // All part of denormalized parsing
 #include <limits> // for numeric_limits
 #include <cmath> // for fpclassify
+#include <cstdlib> // for strtod
 #include <sstream>
+#include <locale.h> // for strtod_l (C locale)
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
 
 #ifdef RAPIDJSON_SSE42
 #include <nmmintrin.h>
@@ -531,15 +540,45 @@ private:
 #undef RAPIDJSON_PUT
 	}
 
+	// Take a character of a number, recording it in buf while there is room.
+	template<typename Stream>
+	static typename Stream::Ch TakeNumberChar(Stream& s, char* buf, size_t& len) {
+		typename Stream::Ch c = s.Take();
+		if (len < 127) buf[len] = (char)c;
+		++len;
+		return c;
+	}
+
+	// strtod in the C locale. Plain strtod follows LC_NUMERIC: if the host
+	// program sets a comma-decimal locale, "1.5" would be read as 1.
+	static double StrtodC(const char* str) {
+#if defined(_MSC_VER)
+		static const _locale_t c = _create_locale(LC_NUMERIC, "C");
+		return _strtod_l(str, 0, c);
+#elif defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+		static const locale_t c = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+		return strtod_l(str, 0, c);
+#else
+		std::istringstream is(str);
+		is.imbue(std::locale::classic());
+		double d = 0.;
+		is >> d;
+		return d;
+#endif
+	}
+
 	template<unsigned parseFlags, typename Stream, typename Handler>
 	void ParseNumber(Stream& stream, Handler& handler) {
 		Stream s = stream; // Local copy for optimization
+		// characters of the number, for a correctly rounded double (strtod)
+		char numBuf[128];
+		size_t numLen = 0;
 
 		// Parse minus
 		bool minus = false;
 		if (s.Peek() == '-') {
 			minus = true;
-			s.Take();
+			TakeNumberChar(s, numBuf, numLen);
 		}
 
 		// Parse int: zero / ( digit1-9 *DIGIT )
@@ -547,10 +586,10 @@ private:
 		bool try64bit = false;
 		if (s.Peek() == '0') {
 			i = 0;
-			s.Take();
+			TakeNumberChar(s, numBuf, numLen);
 		}
 		else if (s.Peek() >= '1' && s.Peek() <= '9') {
-			i = s.Take() - '0';
+			i = TakeNumberChar(s, numBuf, numLen) - '0';
 
 			if (minus)
 				while (s.Peek() >= '0' && s.Peek() <= '9') {
@@ -560,7 +599,7 @@ private:
 							break;
 						}
 					}
-					i = i * 10 + (s.Take() - '0');
+					i = i * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 				}
 			else
 				while (s.Peek() >= '0' && s.Peek() <= '9') {
@@ -570,7 +609,7 @@ private:
 							break;
 						}
 					}
-					i = i * 10 + (s.Take() - '0');
+					i = i * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 				}
 		}
 		else {
@@ -590,7 +629,7 @@ private:
 							useDouble = true;
 							break;
 						}
-					i64 = i64 * 10 + (s.Take() - '0');
+					i64 = i64 * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 				}
 			else
 				while (s.Peek() >= '0' && s.Peek() <= '9') {
@@ -599,7 +638,7 @@ private:
 							useDouble = true;
 							break;
 						}
-					i64 = i64 * 10 + (s.Take() - '0');
+					i64 = i64 * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 				}
 		}
 
@@ -612,7 +651,7 @@ private:
 					RAPIDJSON_PARSE_ERROR("Number too big to store in double", stream.Tell());
 					return;
 				}
-				d = d * 10 + (s.Take() - '0');
+				d = d * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 			}
 		}
 
@@ -623,10 +662,10 @@ private:
 				d = try64bit ? (double)i64 : (double)i;
 				useDouble = true;
 			}
-			s.Take();
+			TakeNumberChar(s, numBuf, numLen);
 
 			if (s.Peek() >= '0' && s.Peek() <= '9') {
-				d = d * 10 + (s.Take() - '0');
+				d = d * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 				--expFrac;
 			}
 			else {
@@ -639,7 +678,7 @@ private:
 					d = d * 10 + (s.Peek() - '0');
 					--expFrac;
 				}
-				s.Take();
+				TakeNumberChar(s, numBuf, numLen);
 			}
 		}
 
@@ -650,20 +689,20 @@ private:
 				d = try64bit ? (double)i64 : (double)i;
 				useDouble = true;
 			}
-			s.Take();
+			TakeNumberChar(s, numBuf, numLen);
 
 			bool expMinus = false;
 			if (s.Peek() == '+')
-				s.Take();
+				TakeNumberChar(s, numBuf, numLen);
 			else if (s.Peek() == '-') {
-				s.Take();
+				TakeNumberChar(s, numBuf, numLen);
 				expMinus = true;
 			}
 
 			if (s.Peek() >= '0' && s.Peek() <= '9') {
-				exp = s.Take() - '0';
+				exp = TakeNumberChar(s, numBuf, numLen) - '0';
 				while (s.Peek() >= '0' && s.Peek() <= '9') {
-					exp = exp * 10 + (s.Take() - '0');
+					exp = exp * 10 + (TakeNumberChar(s, numBuf, numLen) - '0');
 					if (exp > 308) {
             // Attempt denormalized construction
             std::stringstream ss;
@@ -693,8 +732,15 @@ private:
 
 		// Finish parsing, call event according to the type of number.
 		if (useDouble) {
-			d *= internal::Pow10(exp + expFrac);
-			handler.Double(minus ? -d : d);
+			if (numLen < sizeof(numBuf)) {
+				numBuf[numLen] = '\0';
+				// locale-independent (see StrtodC)
+				handler.Double(StrtodC(numBuf));
+			}
+			else {
+				d *= internal::Pow10(exp + expFrac);
+				handler.Double(minus ? -d : d);
+			}
 		}
 		else {
 			if (try64bit) {
@@ -7,6 +7,8 @@
 #include "blobb/AbsObject.hh"    // this class
 #include "blobb/StringTools.hh"  // string tools
 #include "blobb/LogService.hh"   // logging service
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
+#include "blobb/LzStreamBuf.hh"  // LZ block-compressed streams
 #include <fstream>               // cplusplus.com/reference/fstream/
 using std::ofstream;             // STL output file stream
 using std::ifstream;             // STL input file stream
@@ -43,14 +45,21 @@ Bool_t AbsObject::isSame(const AbsObject& other) const
 //! Compare class-type
 Bool_t AbsObject::isA(const string& classN) const 
 { 
-  return (className() == classN); 
+  return (classId() == ClassIdHash(classN.c_str())); 
+}
+
+//_____________________________________________________________________________
+//! Compare class-type, e.g. isA(Warrior::ClassId())
+Bool_t AbsObject::isA(ClassId_t classI) const 
+{ 
+  return (classId() == classI); 
 }
 
 //_____________________________________________________________________________
 //! Is this the same class-type as other?
 Bool_t  AbsObject::isSameClass(const AbsObject& other) const 
 { 
-  return (className() == other.className()); 
+  return (classId() == other.classId()); 
 }
 
 //_____________________________________________________________________________
@@ -113,6 +122,15 @@ Bool_t AbsObject::operator>=(const AbsObject& other) const
   return (compare(other) >= 0); 
 }
 
+//_____________________________________________________________________________
+//! Content hash of this object. 
+/** Derived implementations should return a stable hash of the 
+    canonical member values; see Hash.hh. */
+ULong_t AbsObject::hash() const
+{ 
+  throw Exception("AbsObject::hash: Not implemented for " + className());
+}
+
 //_____________________________________________________________________________
 //! Print class name of object
 void AbsObject::printClassName(ostream& os) const 
@@ -142,8 +160,12 @@ void AbsObject::printToUI(CLUI& /*clui*/, Bool_t /*verbose*/) const
      - .cnb for Cereal Native Binary
      - .json for JavaScript Object Notation (text)
      - .xml for eXtensible Markup Language, version="1.0" encoding="utf-8" (text).
+     - .bbm for a memory-mapped roster (BloBB only).
+     - .cnbz or .jsonz for LZ block-compressed binary or JSON.
      \param objName The name of the object in the file.
 
+     Binary files (.cnb & .cnbz) end with an ArchiveIndex.
+
      \return "success" boolean: true if successfully saved.
 */
 Bool_t AbsObject::save(const string& fileName, const string& objName) const
@@ -152,9 +174,7 @@ Bool_t AbsObject::save(const string& fileName, const string& objName) const
   string fn = fileName;
   string ext = GetFileExt(fn);	
   eArchiveType arcType;
-  if(ext == ".cnb") arcType = kBinary;
-  else if(ext == ".json") arcType = kJson;
-  else if(ext == ".xml") arcType = kXml;
+  if(IsArchiveExt(ext)) arcType = GetArchiveTypeFromExt(ext);
   else{
     loutW(InputArguments) << "AbsObject::save: Unkonwn file extension '" << ext 
 			  << "', using '.cnb' (cereal native binary)." << endl;
@@ -163,8 +183,9 @@ Bool_t AbsObject::save(const string& fileName, const string& objName) const
   } 
 
   // set up out file streamer
+  releaseFile(fn);
   ofstream* ofs = 0;
-  if(arcType == kBinary)
+  if(!IsTextArchive(arcType))
     ofs = new ofstream(fn.c_str(), std::ios_base::trunc | std::ios::binary);
   else
     ofs = new ofstream(fn.c_str(), std::ios_base::trunc);
@@ -172,9 +193,21 @@ Bool_t AbsObject::save(const string& fileName, const string& objName) const
   // check & write the stream
   Bool_t success(kFalse);
   if(ofs->is_open()){
-    loutI(DataHandling) << "Writing file " << fn << endl;
-    write(*ofs, arcType, objName);
-    success = kTrue;
+    try{ 
+      loutI(DataHandling) << "Writing file " << fn << endl;
+      // binary: footer index, for random-access loads
+      if(arcType == kBinary){
+	IndexEntries_t entries;
+	writeIndexed(*ofs, objName == "" ? className() : objName, entries);
+	writeIndex(*ofs, entries, 0);
+      }
+      else write(*ofs, arcType, objName);
+      success = kTrue;
+    }
+    catch(std::exception& e){
+      loutE(InputArguments) << "AbsObject::save: Failed to write file '" << fn 
+			    << "'; " << e.what() << endl;    
+    }
   }
   else
     loutE(InputArguments) << "AbsObject::save: Failed to open file '" << fn 
@@ -185,6 +218,62 @@ Bool_t AbsObject::save(const string& fileName, const string& objName) const
   return success;
 }
 
+//_____________________________________________________________________________
+//! Write the members of this object to a streaming writer.
+/** Derived implementations should write the same names, in the same 
+    order, as their cereal serialize method. */
+void AbsObject::stream(StreamWriter& /*sw*/) const
+{ 
+  throw Exception("AbsObject::stream: Not implemented for " + className());
+}
+
+//_____________________________________________________________________________
+//! Save this object to a file, incrementally.
+/** \param fileName The name of the output file; .json or .xml.
+    \param compact Write without indentation.
+    \param objName The name of the object in the file.
+
+    The file is readable with load(), but memory use does not depend on
+    the size of the object; see StreamWriter.
+
+    \return "success" boolean: true if successfully saved.
+*/
+Bool_t AbsObject::saveStreamed(const string& fileName, Bool_t compact, 
+			       const string& objName) const
+{
+  // parse file name for extension type
+  string ext = GetFileExt(fileName);
+  if(!IsArchiveExt(ext) || !IsTextArchive(GetArchiveTypeFromExt(ext))){
+    loutE(InputArguments) << "AbsObject::saveStreamed: Cannot stream to file extension '" 
+			  << ext << "', use '.json' or '.xml'." << endl;
+    return kFalse;
+  }
+
+  // set up out file streamer
+  releaseFile(fileName);
+  ofstream ofs(fileName.c_str(), std::ios_base::trunc);
+  if(!ofs.is_open()){
+    loutE(InputArguments) << "AbsObject::saveStreamed: Failed to open file '" << fileName 
+			  << "', no data writen." << endl;    
+    return kFalse;
+  }
+
+  // write the stream
+  try{ 
+    loutI(DataHandling) << "Writing file " << fileName << endl;
+    StreamWriter sw(ofs, GetArchiveTypeFromExt(ext), compact);
+    sw.startNode(objName == "" ? className() : objName);
+    stream(sw);
+    sw.close();
+  }
+  catch(std::exception& e){
+    loutE(InputArguments) << "AbsObject::saveStreamed: Failed to write file '" << fileName 
+			  << "'; " << e.what() << endl;    
+    return kFalse;
+  }
+  return kTrue;
+}
+
 //_____________________________________________________________________________
 //! Load this object from a file.
 /** \param fileName The name of the input file.
@@ -193,6 +282,8 @@ Bool_t AbsObject::save(const string& fileName, const string& objName) const
      - .cnb for Cereal Native Binary
      - .json for JavaScript Object Notation (text)
      - .xml for eXtensible Markup Language, version="1.0" encoding="utf-8" (text).
+     - .bbm for a memory-mapped roster (BloBB only), mapped rather than read.
+     - .cnbz or .jsonz for LZ block-compressed binary or JSON.
      \param objName The name of the object in the file.
 
      \return "success" boolean: true if successfully loaded.
@@ -202,18 +293,39 @@ Bool_t AbsObject::load(const string& fileName, const string& objName)
   // parse file name for extension type
   string ext = GetFileExt(fileName);	
   eArchiveType arcType;
-  if(ext == ".cnb") arcType = kBinary;
-  else if(ext == ".json") arcType = kJson;
-  else if(ext == ".xml") arcType = kXml;
+  if(IsArchiveExt(ext)) arcType = GetArchiveTypeFromExt(ext);
   else{
     loutE(InputArguments) << "AbsObject::load: Unkonwn file extension '" << ext 
 			  << "', no data loaded." << endl;
     return kFalse;
   } 
 
+  // mapped, not streamed
+  if(arcType == kMapped){
+    try{ 
+      loutI(DataHandling) << "Mapping file " << fileName << endl;
+      loadMapped(fileName, objName); 
+      return kTrue;
+    }
+    catch(std::exception& e){
+      loutE(InputArguments) << "AbsObject::load: Failed to map file '" << fileName 
+			    << "'; " << e.what() << endl;    
+      return kFalse;
+    }
+  }
+
+  // indexed binary: only the object's bytes, if the footer has its entry
+  if(arcType == kBinary || arcType == kBinaryLz){
+    ArchiveIndex index;
+    if(index.open(fileName, kTrue) && index.find(objName)){
+      loutI(DataHandling) << "Reading file " << fileName << " (indexed)" << endl;
+      return index.load(objName, *this);
+    }
+  }
+
   // set up out file streamer
   ifstream* ifs = 0;
-  if(arcType == kBinary)
+  if(!IsTextArchive(arcType))
     ifs = new ifstream(fileName.c_str(), std::ios::binary);
   else
     ifs = new ifstream(fileName.c_str());
@@ -240,4 +352,87 @@ Bool_t AbsObject::load(const string& fileName, const string& objName)
   return success;
 }
 
+//_____________________________________________________________________________
+//! Write this object to an archive not handled by cereal.
+/** Compressed archives are written through an LzOStreamBuf. */
+void AbsObject::writeArchive(ostream& os, eArchiveType arcType, 
+			     const string& objName) const
+{ 
+  if(IsCompressedArchive(arcType)){
+    std::streamoff start = os.tellp();
+    LzOStreamBuf buf(os, (arcType == kBinaryLz ? LzOStreamBuf::kSeekBlockSize 
+			  : LzOStreamBuf::kDefBlockSize));
+    ostream los(&buf);
+    // binary: footer index (on seekable streams), for random-access loads
+    if(arcType == kBinaryLz && start >= 0){
+      IndexEntries_t entries;
+      writeIndexed(los, objName, entries);
+      buf.close();
+      writeIndex(os, entries, start, &buf);
+      return;
+    }
+    write(los, GetUncompressedArchive(arcType), objName);
+    buf.close();
+    return;
+  }
+  throw Exception("AbsObject::writeArchive: " + GetArchiveName(arcType) 
+		  + " archive not supported for " + className());
+}
+
+//_____________________________________________________________________________
+//! Read this object from an archive not handled by cereal.
+/** Compressed archives are read through an LzIStreamBuf. */
+void AbsObject::readArchive(istream& is, eArchiveType arcType, 
+			    const string& objName)
+{ 
+  if(IsCompressedArchive(arcType)){
+    LzIStreamBuf buf(is);
+    istream lis(&buf);
+    lis.exceptions(std::ios::badbit);
+    read(lis, GetUncompressedArchive(arcType), objName);
+    return;
+  }
+  throw Exception("AbsObject::readArchive: " + GetArchiveName(arcType) 
+		  + " archive not supported for " + className());
+}
+
+//_____________________________________________________________________________
+//! Write this object to a binary archive, with its footer index entries.
+/** Entry offsets are from the start of the object (positions of the
+    stream, which must report them: tellp); the default indexes the whole
+    object. */
+void AbsObject::writeIndexed(ostream& os, const string& objName, 
+			     IndexEntries_t& entries) const
+{
+  std::streamoff start = os.tellp();
+  write(os, kBinary, objName);
+  IndexEntry_t entry = {objName, 0, ULong_t(os.tellp() - start)};
+  entries.push_back(entry);
+}
+
+//_____________________________________________________________________________
+//! Write the footer index of this object, written at start, to a stream.
+/** \param lz The buffer which compressed this object (if any). */
+void AbsObject::writeIndex(ostream& os, IndexEntries_t& entries, ULong_t start, 
+			   const LzOStreamBuf* lz) const
+{
+  vector<LzOStreamBuf::Block_t> blocks;
+  if(lz){
+    // offsets in the raw stream; blocks at file offsets
+    blocks = lz->blocks();
+    for(UInt_t b=0; b<blocks.size(); b++) blocks[b].storedOffset += start;
+  }
+  else
+    for(UInt_t e=0; e<entries.size(); e++) entries[e].offset += start;
+  ArchiveIndex::Write(os, entries, blocks);
+}
+
+//_____________________________________________________________________________
+//! Load this object from a memory-mapped file.
+void AbsObject::loadMapped(const string& /*fileName*/, const string& /*objName*/)
+{ 
+  throw Exception("AbsObject::loadMapped: Mapped archive not supported for " 
+		  + className());
+}
+
 } // end namespace Blobb
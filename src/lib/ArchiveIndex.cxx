@@ -0,0 +1,266 @@
+/** \file      src/lib/ArchiveIndex.cxx
+    \brief     Source for ArchiveIndex
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/ArchiveIndex.hh"  // this class
+#include "blobb/Warrior.hh"       // warrior
+#include "blobb/Hash.hh"          // content hashing
+#include "blobb/LogService.hh"    // logging
+#include <algorithm>              // cplusplus.com/reference/algorithm/
+#include <cstring>                // cplusplus.com/reference/cstring/
+#include <sstream>                // cplusplus.com/reference/sstream/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Format constants
+static CChar_t gIndexMagic[4] = {'B','I','X','1'};  //!< trailer magic
+static const ULong_t gIndexTrailerSize = 24;        //!< trailer bytes
+
+//_____________________________________________________________________________
+//! Append little-endian bytes.
+static void PutLE(string& s, ULong_t v, UInt_t n)
+{
+  for(UInt_t i=0; i<n; i++) s += Char_t(v >> (8*i));
+}
+
+//_____________________________________________________________________________
+//! Read little-endian bytes.
+static ULong_t GetLE(CChar_t* p, UInt_t n)
+{
+  ULong_t v(0);
+  for(UInt_t i=0; i<n; i++) v |= ULong_t(Byte_t(p[i])) << (8*i);
+  return v;
+}
+
+//_____________________________________________________________________________
+//! Order entries by name.
+static Bool_t ByName(const IndexEntry_t& a, const IndexEntry_t& b)
+{
+  return a.name < b.name;
+}
+
+//_____________________________________________________________________________
+/** Default constructor. */
+ArchiveIndex::ArchiveIndex()
+  : mFileName(""),
+    mFile(),
+    mObjectName(""),
+    mEntries(),
+    mBlocks()
+{}
+
+//_____________________________________________________________________________
+/** Constructor; opens the archive. */
+ArchiveIndex::ArchiveIndex(const string& fileName)
+  : mFileName(""),
+    mFile(),
+    mObjectName(""),
+    mEntries(),
+    mBlocks()
+{
+  open(fileName);
+}
+
+//_____________________________________________________________________________
+/** Open an archive and read its footer index.
+    \param quiet No error message for a missing file or index (a corrupt
+    index is still reported).
+    \return "success" boolean: true if the archive has a valid index. */
+Bool_t ArchiveIndex::open(const string& fileName, Bool_t quiet)
+{
+  close();
+  mFile.open(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if(!mFile.is_open()){
+    if(!quiet)
+      loutE(InputArguments) << "ArchiveIndex::open: Failed to open file '" << fileName << "'." << endl;
+    return kFalse;
+  }
+  ULong_t size = mFile.tellg();
+
+  // trailer
+  Char_t trailer[gIndexTrailerSize] = {0};
+  if(size >= gIndexTrailerSize){
+    mFile.seekg(size - gIndexTrailerSize);
+    mFile.read(trailer, gIndexTrailerSize);
+  }
+  ULong_t start = GetLE(trailer, 8);
+  if(size < gIndexTrailerSize || !mFile || memcmp(trailer + 20, gIndexMagic, 4) != 0
+     || start > size - gIndexTrailerSize){
+    if(!quiet)
+      loutE(InputArguments) << "ArchiveIndex::open: File '" << fileName 
+			    << "' has no index." << endl;
+    close();
+    return kFalse;
+  }
+
+  // footer
+  string footer(size - gIndexTrailerSize - start, '\0');
+  mFile.seekg(start);
+  mFile.read(&footer[0], footer.size());
+  ULong_t numEntries = GetLE(trailer + 8, 4), numBlocks = GetLE(trailer + 12, 4);
+  CChar_t* p = footer.data();
+  CChar_t* end = p + footer.size();
+  Bool_t ok = mFile && UInt_t(Hash64(footer.data(), footer.size())) == GetLE(trailer + 16, 4);
+  for(ULong_t i=0; ok && i<numEntries; i++){
+    ULong_t length = (end - p >= 4 ? GetLE(p, 4) : 0);
+    ok = (ULong_t(end - p) >= 20 + length);
+    if(!ok) break;
+    IndexEntry_t entry = {string(p + 4, length), GetLE(p + 4 + length, 8), GetLE(p + 12 + length, 8)};
+    mEntries.push_back(entry);
+    p += 20 + length;
+  }
+  if(!ok || ULong_t(end - p) != 16*numBlocks){
+    loutE(InputArguments) << "ArchiveIndex::open: Corrupt index in '" << fileName << "'." << endl;
+    close();
+    return kFalse;
+  }
+  mBlocks.resize(numBlocks);
+  for(ULong_t b=0; b<numBlocks; b++, p += 16){
+    mBlocks[b].rawOffset    = GetLE(p, 8);
+    mBlocks[b].storedOffset = GetLE(p + 8, 8);
+  }
+  // the object comes first; look-up by name
+  if(!mEntries.empty()) mObjectName = mEntries[0].name;
+  std::sort(mEntries.begin(), mEntries.end(), ByName);
+  mFileName = fileName;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Close the archive. */
+void ArchiveIndex::close()
+{
+  if(mFile.is_open()) mFile.close();
+  mFile.clear();
+  mFileName = "";
+  mObjectName = "";
+  mEntries.clear();
+  mBlocks.clear();
+}
+
+//_____________________________________________________________________________
+/** Find an entry by name.
+    \return The entry, or 0 if not found. */
+const IndexEntry_t* ArchiveIndex::find(const string& name) const
+{
+  IndexEntry_t key = {name, 0, 0};
+  IndexEntries_t::const_iterator it = std::lower_bound(mEntries.begin(), mEntries.end(), key, ByName);
+  return (it != mEntries.end() && it->name == name ? &(*it) : 0);
+}
+
+//_____________________________________________________________________________
+/** Read the bytes of an entry.
+    \return "success" boolean: true if read. */
+Bool_t ArchiveIndex::read(const string& name, string& bytes)
+{
+  const IndexEntry_t* entry = find(name);
+  if(!entry){
+    loutE(InputArguments) << "ArchiveIndex::read: No entry '" << name << "' in '" 
+			  << mFileName << "'." << endl;
+    return kFalse;
+  }
+  bytes.resize(entry->length);
+  mFile.clear();
+
+  // uncompressed: one seek & read
+  if(mBlocks.empty()){
+    mFile.seekg(entry->offset);
+    if(entry->length > 0) mFile.read(&bytes[0], entry->length);
+    if(!mFile){
+      loutE(InputArguments) << "ArchiveIndex::read: Failed to read '" << name << "'." << endl;
+      return kFalse;
+    }
+    return kTrue;
+  }
+
+  // compressed: the blocks holding the bytes, which follow each other
+  LzOStreamBuf::Block_t key = {entry->offset, 0};
+  vector<LzOStreamBuf::Block_t>::const_iterator it = 
+    std::upper_bound(mBlocks.begin(), mBlocks.end(), key, 
+		     [](const LzOStreamBuf::Block_t& a, const LzOStreamBuf::Block_t& b)
+		     { return a.rawOffset < b.rawOffset; });
+  if(it == mBlocks.begin()){
+    loutE(InputArguments) << "ArchiveIndex::read: No block holds '" << name << "' in '"
+			  << mFileName << "'." << endl;
+    return kFalse;
+  }
+  --it;
+  mFile.seekg(it->storedOffset);
+  vector<Byte_t> raw;
+  ULong_t done(0), offset(entry->offset - it->rawOffset);
+  try{
+    while(done < entry->length){
+      LzIStreamBuf::ReadBlock(mFile, raw);
+      if(offset > raw.size()) throw Exception("Entry beyond its block.");
+      ULong_t n = std::min<ULong_t>(raw.size() - offset, entry->length - done);
+      memcpy(&bytes[done], &raw[offset], n);
+      done += n;
+      offset = 0;
+    }
+  }
+  catch(std::exception& e){
+    loutE(InputArguments) << "ArchiveIndex::read: Failed to read '" << name << "'; " 
+			  << e.what() << endl;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Load an object from its entry.
+    \return "success" boolean: true if loaded. */
+Bool_t ArchiveIndex::load(const string& name, AbsObject& obj)
+{
+  string bytes;
+  if(!read(name, bytes)) return kFalse;
+  std::istringstream iss(bytes);
+  try{ obj.read(iss, kBinary, name); }
+  catch(std::exception& e){
+    loutE(InputArguments) << "ArchiveIndex::load: Failed to load '" << name << "'; " 
+			  << e.what() << endl;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Write a footer index at the stream position. */
+void ArchiveIndex::Write(ostream& os, const IndexEntries_t& entries, 
+			 const vector<LzOStreamBuf::Block_t>& blocks)
+{
+  ULong_t start = os.tellp();
+  string footer;
+  for(IndexEntries_t::const_iterator it = entries.begin(); it != entries.end(); ++it){
+    PutLE(footer, it->name.size(), 4);
+    footer += it->name;
+    PutLE(footer, it->offset, 8);
+    PutLE(footer, it->length, 8);
+  }
+  for(vector<LzOStreamBuf::Block_t>::const_iterator it = blocks.begin(); it != blocks.end(); ++it){
+    PutLE(footer, it->rawOffset, 8);
+    PutLE(footer, it->storedOffset, 8);
+  }
+  string trailer;
+  PutLE(trailer, start, 8);
+  PutLE(trailer, entries.size(), 4);
+  PutLE(trailer, blocks.size(), 4);
+  PutLE(trailer, UInt_t(Hash64(footer.data(), footer.size())), 4);
+  trailer.append(gIndexMagic, 4);
+  os.write(footer.data(), footer.size());
+  os.write(trailer.data(), trailer.size());
+}
+
+//_____________________________________________________________________________
+/** Load the single warrior registered as key from an indexed roster.
+    \return true if found. */
+Bool_t ArchiveIndex::LoadWarrior(const string& fileName, const string& key, Warrior& war)
+{
+  ArchiveIndex index;
+  if(!index.open(fileName)) return kFalse;
+  return index.load(index.objectName() + "/" + key, war);
+}
+
+} // end namespace Blobb
@@ -16,27 +16,39 @@ namespace Blobb {
 //! Archive names.
 static std::map<eArchiveType,string> gArchiveNames = 
   {
-    {kBinary, "Binary"},
-    {kJson,   "JSON"},
-    {kXml,    "XML"}
+    {kBinary,    "Binary"},
+    {kJson,      "JSON"},
+    {kXml,       "XML"},
+    {kMapped,    "Mapped"},
+    {kBinaryLz,  "BinaryLZ"},
+    {kJsonLz,    "JSONLZ"},
+    {kPortable,  "Portable"}
   };
 
 //_____________________________________________________________________________
 //! Archive titles.
 static std::map<eArchiveType,string> gArchiveTitles = 
   {
-    {kBinary, "Binary"},
-    {kJson,   "JavaScript Object Notation"},
-    {kXml,    "eXtensible Markup Language"}
+    {kBinary,    "Binary"},
+    {kJson,      "JavaScript Object Notation"},
+    {kXml,       "eXtensible Markup Language"},
+    {kMapped,    "Memory-mapped roster"},
+    {kBinaryLz,  "Binary, LZ block-compressed"},
+    {kJsonLz,    "JavaScript Object Notation, LZ block-compressed"},
+    {kPortable,  "Portable (endian-safe) binary"}
   };
 
 //_____________________________________________________________________________
 //! Archive extensions.
 static std::map<eArchiveType,string> gArchiveExts = 
   {
-    {kBinary, ".cnb"},
-    {kJson,   ".json"},
-    {kXml,    ".xml"}
+    {kBinary,    ".cnb"},
+    {kJson,      ".json"},
+    {kXml,       ".xml"},
+    {kMapped,    ".bbm"},
+    {kBinaryLz,  ".cnbz"},
+    {kJsonLz,    ".jsonz"},
+    {kPortable,  ".cnpb"}
   };
 
 //_____________________________________________________________________________
@@ -100,14 +112,55 @@ string GetArchiveExt(eArchiveType algo)
   catch(const out_of_range& oor){ throw Exception("GetArchiveName: Undefined archive enumeration."); }
 }
 
+//_____________________________________________________________________________
+/** Is this a known archive extension? */
+Bool_t IsArchiveExt(const string& ext)
+{
+  std::map<eArchiveType,string>::const_iterator it = gArchiveExts.begin();
+  for(it = gArchiveExts.begin(); it != gArchiveExts.end(); ++it)
+    if(it->second == ext)
+      return kTrue;
+  return kFalse;
+}
+
+//_____________________________________________________________________________
+/** Is this a text archive (i.e. not opened in binary mode)? */
+Bool_t IsTextArchive(eArchiveType algo)
+{
+  return (algo == kJson || algo == kXml);
+}
+
 //_____________________________________________________________________________
 //! Get an algorithm title string from the enumerated value.Print algorithm information to the stream 
 void PrintArchiveInfo(ostream& os, const string& prefix)
 {
-  os << prefix << "NAME    DESCRIPTION" << endl;
-  os << prefix << "Binary  " << gArchiveTitles[kBinary] << endl;
-  os << prefix << "JSON    " << gArchiveTitles[kJson] << endl;
-  os << prefix << "XML     " << gArchiveTitles[kXml] << endl;
+  os << prefix << "NAME      DESCRIPTION" << endl;
+  os << prefix << "Binary    " << gArchiveTitles[kBinary] << endl;
+  os << prefix << "JSON      " << gArchiveTitles[kJson] << endl;
+  os << prefix << "XML       " << gArchiveTitles[kXml] << endl;
+  os << prefix << "Mapped    " << gArchiveTitles[kMapped] << endl;
+  os << prefix << "BinaryLZ  " << gArchiveTitles[kBinaryLz] << endl;
+  os << prefix << "JSONLZ    " << gArchiveTitles[kJsonLz] << endl;
+  os << prefix << "Portable  " << gArchiveTitles[kPortable] << endl;
+}
+
+//_____________________________________________________________________________
+/** Is this an LZ block-compressed archive? */
+Bool_t IsCompressedArchive(eArchiveType algo)
+{
+  return (algo == kBinaryLz || algo == kJsonLz);
+}
+
+//_____________________________________________________________________________
+/** Get the archive type compressed by a compressed archive type
+    (the type itself otherwise). */
+eArchiveType GetUncompressedArchive(eArchiveType algo)
+{
+  switch(algo){
+  case kBinaryLz : return kBinary;
+  case kJsonLz :   return kJson;
+  default :        return algo;
+  }
 }
 
 } // end namespace Blobb
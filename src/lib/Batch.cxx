@@ -0,0 +1,315 @@
+/** \file      src/lib/Batch.cxx
+    \brief     Source for Batch
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Batch.hh"         // this class
+#include "blobb/BinaryLog.hh"     // printf-style debug messages
+#include "blobb/Dashboard.hh"     // live tournaments
+#include "blobb/Exception.hh"     // exception handler
+#include "blobb/FightEngine.hh"   // fights
+#include "blobb/Journal.hh"       // change journal
+#include "blobb/StateDelta.hh"    // delta snapshots
+#include "blobb/StreamWriter.hh"  // JSON results
+#include <algorithm>              // cplusplus.com/reference/algorithm/
+#include <cctype>                 // cplusplus.com/reference/cctype/
+#include <sstream>                // cplusplus.com/reference/sstream/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Parse a number argument.
+    \warning Throws Exception if it is not a number. */
+static Double_t ParseDouble(const string& arg)
+{
+  CChar_t* begin = arg.c_str();
+  Char_t* end = 0;
+  Double_t val = strtod(begin, &end);
+  if(arg == "" || *end != '\0') throw Exception("Not a number: '" + arg + "'.");
+  return val;
+}
+
+//_____________________________________________________________________________
+/** Constructor; results are written to os. */
+Batch::Batch(BloBB& blobb, ostream& os)
+  : mBlobb(blobb),
+    mOs(os),
+    mNull(),
+    mClui(),
+    mLine(0),
+    mNumCommands(0),
+    mNumFailed(0),
+    mQuit(kFalse),
+    mDashboard(0)
+{
+  mClui.setSink(&mNull);
+}
+
+//_____________________________________________________________________________
+/** Execute the script, line by line, up to its end or quit; the results
+    are flushed at the end.
+    \return The number of failed commands. */
+Pos_t Batch::run(istream& is)
+{
+  string line;
+  while(!mQuit && std::getline(is, line)) execute(line);
+  mBlobb.waitSave();
+  mOs.flush();
+  return mNumFailed;
+}
+
+//_____________________________________________________________________________
+/** Execute one script line and write its result line.
+    \return "success" boolean: true if executed (or skipped). */
+Bool_t Batch::execute(const string& line)
+{
+  mLine++;
+  vector<string> args = Tokenize(line);
+  if(args.empty() || args[0][0] == '#') return kTrue;
+  mNumCommands++;
+
+  std::ostringstream oss;
+  string error("");
+  try{
+    StreamWriter sw(oss, kJson, kTrue, 256);
+    sw.value("line", UInt_t(mLine));
+    sw.value("command", args[0]);
+    sw.value("status", string("ok"));
+    dispatch(args, sw);
+  }
+  catch(const std::exception& e){
+    error = e.what();
+  }
+  if(error != ""){
+    mNumFailed++;
+    oss.str("");
+    StreamWriter sw(oss, kJson, kTrue, 256);
+    sw.value("line", UInt_t(mLine));
+    sw.value("command", args[0]);
+    sw.value("status", string("error"));
+    sw.value("error", error);
+  }
+  mOs << oss.str() << '\n';
+  return error == "";
+}
+
+//_____________________________________________________________________________
+/** Split a line into white-space separated or double-quoted arguments. */
+vector<string> Batch::Tokenize(const string& line)
+{
+  vector<string> args;
+  Pos_t i(0), n(line.size());
+  while(kTrue){
+    while(i < n && isspace((unsigned char)line[i])) i++;
+    if(i >= n) break;
+    string arg("");
+    if(line[i] == '"'){
+      for(i++; i < n && line[i] != '"'; i++) arg += line[i];
+      i++;
+    }
+    else{
+      for(; i < n && !isspace((unsigned char)line[i]); i++) arg += line[i];
+    }
+    args.push_back(arg);
+  }
+  return args;
+}
+
+//_____________________________________________________________________________
+/** Run a command.
+    \warning Throws Exception for unknown commands or bad arguments. */
+void Batch::dispatch(const vector<string>& args, StreamWriter& sw)
+{
+  const string& cmd = args[0];
+  if     (cmd == "load")       load(args, sw);
+  else if(cmd == "save")       save(args, sw);
+  else if(cmd == "save-delta") saveDelta(args, sw);
+  else if(cmd == "register")   registerWarrior(args, sw);
+  else if(cmd == "fight")      fight(args, sw);
+  else if(cmd == "tournament") tournament(args, sw);
+  else if(cmd == "warriors")   warriors(args, sw);
+  else if(cmd == "quit")       mQuit = kTrue;
+  else throw Exception("Unknown command '" + cmd + "'.");
+}
+
+//_____________________________________________________________________________
+/** load file */
+void Batch::load(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 2) throw Exception("Usage: load file");
+  mBlobb.waitSave();
+  if(!mBlobb.loadFile(args[1])) throw Exception("Failed to load '" + args[1] + "'.");
+  sw.value("file", args[1]);
+  sw.value("warriors", UInt_t(mBlobb.warriors().size()));
+}
+
+//_____________________________________________________________________________
+/** save file */
+void Batch::save(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 2) throw Exception("Usage: save file");
+  mBlobb.waitSave();
+  mBlobb.setEndTime(TimeStamp(-1));
+  if(!mBlobb.saveFile(args[1])) throw Exception("Failed to save '" + args[1] + "'.");
+  sw.value("file", args[1]);
+  sw.value("warriors", UInt_t(mBlobb.warriors().size()));
+}
+
+//_____________________________________________________________________________
+/** save-delta file base */
+void Batch::saveDelta(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 3) throw Exception("Usage: save-delta file base");
+  mBlobb.waitSave();
+  mBlobb.setEndTime(TimeStamp(-1));
+  if(!StateDelta::Save(mBlobb, args[1], args[2]))
+    throw Exception("Failed to save the delta '" + args[1] + "'.");
+  sw.value("file", args[1]);
+  sw.value("base", args[2]);
+  sw.value("warriors", UInt_t(mBlobb.warriors().size()));
+}
+
+//_____________________________________________________________________________
+/** register name prowess agility intelligence personality health [title] */
+void Batch::registerWarrior(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 7 && args.size() != 8)
+    throw Exception("Usage: register name prowess agility intelligence personality health [title]");
+  Double_t vals[5];
+  for(Pos_t v=0; v<5; v++) vals[v] = ParseDouble(args[v+2]);
+  Bool_t isNew = (mBlobb.warriors().count(args[1]) == 0);
+  Warrior w = (isNew ? Warrior(args[1]) : mBlobb.warrior(args[1]));
+  if(args.size() == 8) w.setTitle(args[7]);
+  w.mProwess.setValue(vals[0]);
+  w.mAgility.setValue(vals[1]);
+  w.mIntelligence.setValue(vals[2]);
+  w.mPersonality.setValue(vals[3]);
+  w.mHealth.setValue(vals[4]);
+  w.mFatigue.setValue(vals[4]);
+  mBlobb.addWarrior(w);
+  sw.value("name", args[1]);
+  sw.value("action", string(isNew ? "added" : "updated"));
+}
+
+//_____________________________________________________________________________
+/** fight name1 name2 */
+void Batch::fight(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 3) throw Exception("Usage: fight name1 name2");
+  if(args[1] == args[2]) throw Exception("A warrior cannot fight itself.");
+  // fought as copies, committed when done
+  Warrior w1(find(args[1])), w2(find(args[2]));
+  Int_t result = deathMatch(w1, w2);
+  mBlobb.addWarrior(w1);
+  mBlobb.addWarrior(w2);
+  commitRandom();
+  sw.value("first", args[1]);
+  sw.value("second", args[2]);
+  sw.value("winner", (result == 0 ? string("") : args[result]));
+  sw.value("first_health", w1.mHealth.value());
+  sw.value("second_health", w2.mHealth.value());
+}
+
+//_____________________________________________________________________________
+/** tournament [name ...] */
+void Batch::tournament(const vector<string>& args, StreamWriter& sw)
+{
+  vector<string> names(args.begin() + 1, args.end());
+  if(names.empty()){
+    for(Warriors_t::const_iterator it = mBlobb.warriors().begin(); it != mBlobb.warriors().end(); ++it)
+      names.push_back(it->first);
+  }
+  for(Pos_t n=0; n<names.size(); n++) find(names[n]);
+  if(names.size() < 2) throw Exception("A tournament needs two or more warriors.");
+
+  // round robin: each pair fights once, as fresh copies
+  vector<UInt_t> wins(names.size(), 0), losses(names.size(), 0), draws(names.size(), 0);
+  UInt_t numMatches(0);
+  if(mDashboard) mDashboard->start("tournament", names, ULong_t(names.size())*(names.size() - 1)/2);
+  for(Pos_t i=0; i<names.size(); i++){
+    for(Pos_t j=i+1; j<names.size(); j++){
+      Warrior w1(find(names[i])), w2(find(names[j]));
+      if(mDashboard) mDashboard->startMatch(0, i, j);
+      Int_t result = deathMatch(w1, w2);
+      if(mDashboard) mDashboard->finishMatch(0, i, j, result);
+      loutfD(Evaluation, "Batch::tournament: %s vs %s, result %d", names[i], names[j], result);
+      if     (result == 1){ wins[i]++; losses[j]++; }
+      else if(result == 2){ wins[j]++; losses[i]++; }
+      else               { draws[i]++; draws[j]++; }
+      numMatches++;
+    }
+  }
+  if(mDashboard) mDashboard->stop();
+  commitRandom();
+
+  // standings: most wins, then fewest losses
+  vector<Pos_t> order(names.size());
+  for(Pos_t n=0; n<order.size(); n++) order[n] = n;
+  std::stable_sort(order.begin(), order.end(), [&](Pos_t a, Pos_t b){
+      return (wins[a] != wins[b] ? wins[a] > wins[b] : losses[a] < losses[b]);
+    });
+  sw.value("matches", numMatches);
+  sw.startArray("standings");
+  for(Pos_t n=0; n<order.size(); n++){
+    Pos_t w = order[n];
+    sw.startNode("");
+    sw.value("name", names[w]);
+    sw.value("wins", wins[w]);
+    sw.value("losses", losses[w]);
+    sw.value("draws", draws[w]);
+    sw.finishNode();
+  }
+  sw.finishNode();
+}
+
+//_____________________________________________________________________________
+/** warriors */
+void Batch::warriors(const vector<string>& args, StreamWriter& sw)
+{
+  if(args.size() != 1) throw Exception("Usage: warriors");
+  sw.startArray("warriors");
+  for(Warriors_t::const_iterator it = mBlobb.warriors().begin(); it != mBlobb.warriors().end(); ++it){
+    const Warrior& w = it->second;
+    sw.startNode("");
+    sw.value("name", w.name());
+    sw.value("title", w.title());
+    sw.value("prowess", w.mProwess.value());
+    sw.value("agility", w.mAgility.value());
+    sw.value("intelligence", w.mIntelligence.value());
+    sw.value("personality", w.mPersonality.value());
+    sw.value("health", w.mHealth.value());
+    sw.finishNode();
+  }
+  sw.finishNode();
+}
+
+//_____________________________________________________________________________
+/** Get a registered warrior.
+    \warning Throws Exception if not found. */
+Warrior& Batch::find(const string& name)
+{
+  Warriors_t::iterator it = mBlobb.warriors().find(name);
+  if(it == mBlobb.warriors().end()) throw Exception("Cannot find warrior named '" + name + "'.");
+  return it->second;
+}
+
+//_____________________________________________________________________________
+/** Fight a death match, with the state's random generator.
+    \return The winner: 1 (w1), 2 (w2) or 0 if both collapsed. */
+Int_t Batch::deathMatch(Warrior& w1, Warrior& w2)
+{
+  FightEngine fe(&mClui, &mBlobb.random(), &w1, &w2);
+  fe.death();
+  if(w1.collapsed() == w2.collapsed()) return 0;
+  return (w2.collapsed() ? 1 : 2);
+}
+
+//_____________________________________________________________________________
+/** Journal the random generator, advanced by fights. */
+void Batch::commitRandom()
+{
+  if(mBlobb.journal()) mBlobb.journal()->putRandom(mBlobb.random());
+}
+
+} // end namespace Blobb
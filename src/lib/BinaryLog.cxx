@@ -0,0 +1,336 @@
+/** \file      src/lib/BinaryLog.cxx
+    \brief     Source for format-string logging & binary log records
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/BinaryLog.hh"  // these methods
+#include <atomic>              // cplusplus.com/reference/atomic/
+#include <chrono>              // cplusplus.com/reference/chrono/
+#include <ctime>               // cplusplus.com/reference/ctime/
+#include <mutex>               // cplusplus.com/reference/mutex/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+//! Magic of binary log files.
+static const Char_t gBinaryLogMagic[8] = {'B','L','O','B','B','L','O','G'};
+//! Version of binary log files.
+static const UInt_t gBinaryLogVersion = 1;
+
+//_____________________________________________________________________________
+//! Guards the formats & the file.
+static std::mutex gBinaryLogMutex;
+//! Registered formats, by id; 0 is stream (lout) text.
+static vector<string> gLogFormats(1, "%s");
+//! Binary log file (0: none).
+static FILE* gBinaryLogFile(0);
+//! Is a binary log file open?
+static std::atomic<Bool_t> gBinaryLogOn(kFalse);
+
+//_____________________________________________________________________________
+//! Append the bytes of a value.
+template <class T> static inline void Append(string& buf, const T& val)
+{
+  buf.append(reinterpret_cast<CChar_t*>(&val), sizeof(T));
+}
+
+//_____________________________________________________________________________
+//! Write the definition of a format; the file is locked.
+static void WriteFormat(UInt_t id)
+{
+  const string& format = gLogFormats[id];
+  UShort_t length = UShort_t(format.size() < kMaxUS ? format.size() : kMaxUS);
+  string buf("F");
+  Append(buf, id);
+  Append(buf, length);
+  buf.append(format, 0, length);
+  fwrite(buf.data(), 1, buf.size(), gBinaryLogFile);
+}
+
+//_____________________________________________________________________________
+//! Thread-local buffer of the records.
+static string& RecordBuffer()
+{
+  static thread_local string buffer;
+  return buffer;
+}
+
+//_____________________________________________________________________________
+/** Constructor; starts a message record. */
+LogRecord::LogRecord(eLogLevel level, eLogTopic topic, UInt_t formatId)
+  : mBuffer(RecordBuffer()),
+    mNumArgs(0)
+{
+  Long_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+    (std::chrono::system_clock::now().time_since_epoch()).count();
+  mBuffer.clear();
+  mBuffer += 'M';
+  Append(mBuffer, ns);
+  mBuffer += Char_t(level);
+  mBuffer += Char_t(topic);
+  Append(mBuffer, formatId);
+  mNumArgs = mBuffer.size();
+  mBuffer += Char_t(0);
+}
+
+//_____________________________________________________________________________
+/** Add a signed integer argument. */
+void LogRecord::putInt(Long_t val)
+{
+  mBuffer += 'i';
+  Append(mBuffer, val);
+  mBuffer[mNumArgs]++;
+}
+
+//_____________________________________________________________________________
+/** Add an unsigned integer argument. */
+void LogRecord::putUInt(ULong_t val)
+{
+  mBuffer += 'u';
+  Append(mBuffer, val);
+  mBuffer[mNumArgs]++;
+}
+
+//_____________________________________________________________________________
+/** Add a floating-point argument. */
+void LogRecord::putDouble(Double_t val)
+{
+  mBuffer += 'd';
+  Append(mBuffer, val);
+  mBuffer[mNumArgs]++;
+}
+
+//_____________________________________________________________________________
+/** Add a string argument; truncated to 64 kB. */
+void LogRecord::putString(CChar_t* val, ULong_t length)
+{
+  UShort_t len = UShort_t(length < kMaxUS ? length : kMaxUS);
+  mBuffer += 's';
+  Append(mBuffer, len);
+  mBuffer.append(val, len);
+  mBuffer[mNumArgs]++;
+}
+
+//_____________________________________________________________________________
+/** Write the record to the binary log file, if open. */
+void LogRecord::write()
+{
+  std::lock_guard<std::mutex> lock(gBinaryLogMutex);
+  if(gBinaryLogFile) fwrite(mBuffer.data(), 1, mBuffer.size(), gBinaryLogFile);
+}
+
+//_____________________________________________________________________________
+/** Start logging binary records to a file, replacing it: printf-style
+    (loutf*) messages are recorded unformatted, stream (lout*) messages as
+    text. A running binary log is stopped first.
+    \return "success" boolean: true if the file was opened. */
+Bool_t StartBinaryLog(const string& fileName)
+{
+  StopBinaryLog();
+  std::lock_guard<std::mutex> lock(gBinaryLogMutex);
+  gBinaryLogFile = fopen(fileName.c_str(), "wb");
+  if(!gBinaryLogFile) return kFalse;
+  setvbuf(gBinaryLogFile, 0, _IOFBF, 1 << 16);
+  fwrite(gBinaryLogMagic, 1, sizeof(gBinaryLogMagic), gBinaryLogFile);
+  fwrite(&gBinaryLogVersion, sizeof(gBinaryLogVersion), 1, gBinaryLogFile);
+  for(UInt_t id=0; id<gLogFormats.size(); id++) WriteFormat(id);
+  gBinaryLogOn = kTrue;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Stop logging binary records; the file is closed. */
+void StopBinaryLog()
+{
+  gBinaryLogOn = kFalse;
+  std::lock_guard<std::mutex> lock(gBinaryLogMutex);
+  if(gBinaryLogFile){
+    fclose(gBinaryLogFile);
+    gBinaryLogFile = 0;
+  }
+}
+
+//_____________________________________________________________________________
+/** Is a binary log file open? */
+Bool_t IsBinaryLog()
+{
+  return gBinaryLogOn.load(std::memory_order_relaxed);
+}
+
+//_____________________________________________________________________________
+/** Register a format; defined in the binary log file, if open.
+    \return The format id. */
+UInt_t RegisterLogFormat(CChar_t* format)
+{
+  std::lock_guard<std::mutex> lock(gBinaryLogMutex);
+  UInt_t id = gLogFormats.size();
+  gLogFormats.push_back(format);
+  if(gBinaryLogFile) WriteFormat(id);
+  return id;
+}
+
+//_____________________________________________________________________________
+/** Record a formatted (stream) message; a final end-line is dropped. */
+void LogBinaryText(eLogLevel level, eLogTopic topic, const string& text)
+{
+  ULong_t length = text.size();
+  if(length > 0 && text[length-1] == '\n') length--;
+  LogRecord rec(level, topic, 0);
+  rec.putString(text.data(), length);
+  rec.write();
+}
+
+//_____________________________________________________________________________
+/** \struct LogArg_t
+    \brief Decoded argument of a message record. */
+struct LogArg_t {
+  Char_t   tag;  //!< type tag
+  Long_t   i;    //!< signed value
+  ULong_t  u;    //!< unsigned value
+  Double_t d;    //!< double value
+  string   s;    //!< string value
+};
+
+//_____________________________________________________________________________
+//! Read a value; false at the end of the stream.
+template <class T> static inline Bool_t Read(istream& is, T& val)
+{
+  return Bool_t(is.read(reinterpret_cast<Char_t*>(&val), sizeof(T)));
+}
+
+//_____________________________________________________________________________
+//! Format one argument by its conversion (spec without the conversion).
+static void RenderArg(string& out, string spec, Char_t conv, const LogArg_t& arg)
+{
+  Char_t buf[512];
+  Bool_t isFloat = (strchr("fFeEgGaA", conv) != 0);
+  if(arg.tag == 's' && spec == "%"){
+    out += arg.s;
+    return;
+  }
+  if(arg.tag == 's'){
+    spec += 's';
+    snprintf(buf, sizeof(buf), spec.c_str(), arg.s.c_str());
+  }
+  else if(arg.tag == 'd' || isFloat){
+    Double_t val = (arg.tag == 'd' ? arg.d : arg.tag == 'i' ? Double_t(arg.i) : Double_t(arg.u));
+    spec += (isFloat ? conv : 'g');
+    snprintf(buf, sizeof(buf), spec.c_str(), val);
+  }
+  else if(conv == 'c'){
+    spec += 'c';
+    snprintf(buf, sizeof(buf), spec.c_str(), Int_t(arg.tag == 'i' ? arg.i : Long_t(arg.u)));
+  }
+  else{
+    spec += "ll";
+    spec += (strchr("diouxX", conv) ? conv : (arg.tag == 'i' ? 'd' : 'u'));
+    if(arg.tag == 'i') snprintf(buf, sizeof(buf), spec.c_str(), (long long)arg.i);
+    else               snprintf(buf, sizeof(buf), spec.c_str(), (unsigned long long)arg.u);
+  }
+  out += buf;
+}
+
+//_____________________________________________________________________________
+/** Render a printf format with the recorded arguments, each converted as
+    recorded (flags, width & precision are kept). */
+static string Render(const string& format, const vector<LogArg_t>& args)
+{
+  string out;
+  Pos_t a(0);
+  for(Pos_t i=0; i<format.size(); i++){
+    if(format[i] != '%'){ out += format[i]; continue; }
+    if(i+1 < format.size() && format[i+1] == '%'){ out += '%'; i++; continue; }
+    // flags, width & precision; length modifiers are dropped
+    string spec("%");
+    for(i++; i < format.size() && strchr("-+ #0123456789.", format[i]); i++) spec += format[i];
+    while(i < format.size() && strchr("hlLqjzt", format[i])) i++;
+    if(i >= format.size()) break;
+    if(a < args.size()) RenderArg(out, spec, format[i], args[a++]);
+    else out += "<?>";
+  }
+  return out;
+}
+
+//_____________________________________________________________________________
+/** Render a binary log as text, one line per message: UTC time, level,
+    topic & message.
+    \return "success" boolean: false if the log is not a binary log or
+    ends within a record. */
+Bool_t DecodeBinaryLog(istream& is, ostream& os)
+{
+  Char_t magic[sizeof(gBinaryLogMagic)];
+  UInt_t version(0);
+  if(!is.read(magic, sizeof(magic)) || memcmp(magic, gBinaryLogMagic, sizeof(magic)) != 0 ||
+     !Read(is, version) || version != gBinaryLogVersion){
+    loutE(DataHandling) << "DecodeBinaryLog: Not a binary log (version "
+			<< gBinaryLogVersion << ")." << endl;
+    return kFalse;
+  }
+
+  vector<string> formats;
+  vector<LogArg_t> args;
+  Char_t type;
+  while(is.get(type)){
+    Bool_t ok(kFalse);
+    if(type == 'F'){
+      UInt_t id;
+      UShort_t length;
+      if(Read(is, id) && Read(is, length)){
+	string format(length, '\0');
+	if(length == 0 || is.read(&format[0], length)){
+	  if(formats.size() <= id) formats.resize(id + 1);
+	  formats[id] = format;
+	  ok = kTrue;
+	}
+      }
+    }
+    else if(type == 'M'){
+      Long_t ns;
+      Char_t level, topic;
+      UInt_t id;
+      UChar_t numArgs;
+      ok = Read(is, ns) && Read(is, level) && Read(is, topic) && Read(is, id) && Read(is, numArgs);
+      ok = ok && level >= kSilent && level <= kDebug;
+      ok = ok && topic >= None && topic <= Plotting && (topic & (topic - 1)) == 0;
+      args.resize(numArgs);
+      for(UInt_t a=0; ok && a<numArgs; a++){
+	LogArg_t& arg = args[a];
+	ok = Read(is, arg.tag);
+	if     (!ok) break;
+	else if(arg.tag == 'i') ok = Read(is, arg.i);
+	else if(arg.tag == 'u') ok = Read(is, arg.u);
+	else if(arg.tag == 'd') ok = Read(is, arg.d);
+	else if(arg.tag == 's'){
+	  UShort_t length;
+	  ok = Read(is, length);
+	  arg.s.assign(length, '\0');
+	  if(ok && length > 0) ok = Bool_t(is.read(&arg.s[0], length));
+	}
+	else ok = kFalse;
+      }
+      if(ok){
+	// time
+	time_t sec = time_t(ns / 1000000000);
+	Char_t when[64];
+	strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", gmtime(&sec));
+	Char_t frac[16];
+	snprintf(frac, sizeof(frac), ".%06u", UInt_t((ns % 1000000000) / 1000));
+	// message
+	os << when << frac << " " << LogLevelName(eLogLevel(level)) << ":"
+	   << LogTopicName(eLogTopic(UChar_t(topic)));
+	if(eLogTopic(topic) != None) os << " -- ";
+	else                         os << " ";
+	if(id < formats.size()) os << Render(formats[id], args) << '\n';
+	else                    os << "<unknown format " << id << ">\n";
+      }
+    }
+    if(!ok){
+      loutE(DataHandling) << "DecodeBinaryLog: Bad or truncated record." << endl;
+      return kFalse;
+    }
+  }
+  return kTrue;
+}
+
+} // end namespace Blobb
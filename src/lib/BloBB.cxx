@@ -7,9 +7,19 @@
 #include "blobb/BloBB.hh"        // this class
 #include "blobb/ClassImp.hh"     // blobb class implementation
 #include "blobb/LogService.hh"   // logging
+#include "blobb/StringTools.hh"  // string tools
 #include "blobb/CLUI.hh"         // command-line user interface
 #include "blobb/Options.hh"      // options
 #include "blobb/FightEngine.hh"  // fighting engine
+#include "blobb/Hash.hh"         // content hashing
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
+#include "blobb/MappedRoster.hh" // memory-mapped roster
+#include "blobb/JsonReader.hh"   // streaming JSON loader
+#include "blobb/XmlReader.hh"    // mapped XML loader
+#include "blobb/Journal.hh"      // change journal
+#include "blobb/StateDelta.hh"   // delta snapshots
+#include <fstream>               // cplusplus.com/reference/fstream/
+#include <memory>                // cplusplus.com/reference/memory/
 #include <sstream>               // cplusplus.com/reference/sstream/
 
 //! Blobb class implementation macro
@@ -35,17 +45,33 @@ BloBB::BloBB()
     mEndTime(-1),
     mRandom(),
     mWarriors(),
+    mMapped(),
+    mMappedFileName(""),
+    mIndex(),
+    mSavedHash(0),
+    mSavedFileName(""),
+    mJournal(0),
+    mSaver(),
+    mSaverHash(0),
     mClui()
 {}
 
 //_____________________________________________________________________________
-/** Copy constructor. */
+/** Copy constructor; the journal & background saver are not copied. */
 BloBB::BloBB(const BloBB& other, const string& newName)
   : Named(other),
     mStartTime(other.mStartTime),
     mEndTime(other.mEndTime),
     mRandom(other.mRandom),
     mWarriors(other.mWarriors),
+    mMapped(other.mMapped),
+    mMappedFileName(other.mMappedFileName),
+    mIndex(other.mIndex),
+    mSavedHash(other.mSavedHash),
+    mSavedFileName(other.mSavedFileName),
+    mJournal(0),
+    mSaver(),
+    mSaverHash(0),
     mClui(other.mClui)
 {
   if(newName != "")
@@ -53,7 +79,17 @@ BloBB::BloBB(const BloBB& other, const string& newName)
 }
 
 //_____________________________________________________________________________
-/** Assignment operator. */
+/** Destructor; waits for a background save and closes the journal. */
+BloBB::~BloBB()
+{
+  waitSave();
+  closeJournal();
+}
+
+//_____________________________________________________________________________
+/** Assignment operator. 
+    \note The journal & background saver are kept; the journal is not told 
+    of the new state. */
 BloBB& BloBB::operator=(const BloBB& rhs)
 {
   Named::operator=(rhs);
@@ -61,6 +97,11 @@ BloBB& BloBB::operator=(const BloBB& rhs)
   mEndTime   = rhs.mEndTime;
   mRandom    = rhs.mRandom;
   mWarriors  = rhs.mWarriors;
+  mMapped    = rhs.mMapped;
+  mMappedFileName = rhs.mMappedFileName;
+  mIndex     = rhs.mIndex;
+  mSavedHash = rhs.mSavedHash;
+  mSavedFileName = rhs.mSavedFileName;
   mClui      = rhs.mClui;
   return *this;
 }
@@ -73,9 +114,16 @@ Bool_t BloBB::isEmpty() const
 }
 
 //_____________________________________________________________________________
-/** Set all counts to zero. */
+/** Empty the roster (& its index, letting go of a mapped roster); the 
+    state matches no save anymore. Name, times & random state are kept. */
 void BloBB::clear()
-{}
+{
+  mMapped.reset();
+  mMappedFileName = "";
+  mWarriors.clear();
+  mIndex.clear();
+  mSavedHash = 0;
+}
 
 //_____________________________________________________________________________
 /** Equivalence. */
@@ -83,21 +131,87 @@ Bool_t BloBB::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const BloBB& b = static_cast<const BloBB&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const BloBB& b = dynamic_cast<const BloBB&>(other); 
-    // check members
-    if(!Named::isEqual(b))           return kFalse;
-    if(mStartTime != b.startTime())  return kFalse;
-    if(mEndTime   != b.endTime())    return kFalse;
-    if(mRandom    != b.random())     return kFalse;
-    if(mWarriors  != b.warriors())   return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(!Named::isEqual(b))           return kFalse;
+  if(mStartTime != b.startTime())  return kFalse;
+  if(mEndTime   != b.endTime())    return kFalse;
+  if(mRandom    != b.random())     return kFalse;
+  if(warriors() != b.warriors())   return kFalse;
+  return kTrue;
 }
   
+//_____________________________________________________________________________
+/** Add (or replace) a warrior, by name. */
+void BloBB::addWarrior(const Warrior& war)
+{
+  mWarriors[war.name()] = war;
+  commit(war.name());
+}
+
+//_____________________________________________________________________________
+/** Add warriors which are new or differ in content from the registered ones.
+    \return The number of warriors added or replaced. */
+Pos_t BloBB::importWarriors(const Warriors_t& wars)
+{
+  Pos_t nAdded(0);
+  for(warCIter it = wars.begin(); it != wars.end(); ++it){
+    fetch(it->first);
+    warCIter old = mWarriors.find(it->first);
+    if(old != mWarriors.end() && old->second.hash() == it->second.hash()) continue;
+    mWarriors[it->first] = it->second;
+    commit(it->first);
+    nAdded++;
+  }
+  return nAdded;
+}
+
+//_____________________________________________________________________________
+/** Content hash of the state: name, title, start-time, random generator and 
+    all warriors (by name).
+    The end-time is excluded; it only records when the state was last saved.
+    Not cached, since warriors can be modified in place through warriors().
+*/
+ULong_t BloBB::hash() const
+{
+  materialize();
+  ULong_t h = HashCombine(Named::computeHash(), ClassId());
+  h = HashCombine(h, mStartTime.hash());
+  h = HashCombine(h, mRandom.hash());
+  h = HashCombine(h, mWarriors.size());
+  for(warCIter it = mWarriors.begin(); it != mWarriors.end(); ++it)
+    h = HashCombine(HashString(h, it->first), it->second.hash());
+  return h;
+}
+
+//_____________________________________________________________________________
+/** Write the state to a streaming writer, one warrior at a time. */
+void BloBB::stream(StreamWriter& sw) const
+{
+  materialize();
+  sw.startNode("Named");
+  Named::stream(sw);
+  sw.finishNode();
+  sw.value("StartTime", mStartTime.asString());
+  sw.value("EndTime", mEndTime.asString());
+  sw.startNode("Random");
+  mRandom.stream(sw);
+  sw.finishNode();
+  sw.startArray("Warriors");
+  for(Warriors_t::const_iterator it = mWarriors.begin(); it != mWarriors.end(); ++it){
+    sw.startNode("");
+    sw.value("key", it->first);
+    sw.startNode("value");
+    it->second.stream(sw);
+    sw.finishNode();
+    sw.finishNode();
+  }
+  sw.finishNode();
+}
+
 //_____________________________________________________________________________
 /** Read (next) command. */
 string BloBB::readCommand()
@@ -122,6 +236,7 @@ Int_t BloBB::main()
   // command loop
   string cmd = readCommand();
   while(kTrue){
+    reportSave();
     // check commands
     if     (cmd=="Q" || cmd=="q" || cmd=="quit")     break;
     else if(cmd=="L" || cmd=="l" || cmd=="load")     loadState();
@@ -130,6 +245,7 @@ Int_t BloBB::main()
     else if(cmd=="W" || cmd=="w" || cmd=="warriors") printWarriors();
     else if(cmd=="R" || cmd=="r" || cmd=="register") registerWarrior();
     else if(cmd=="F" || cmd=="f" || cmd=="fight")    fight();
+    else if(cmd=="J" || cmd=="j" || cmd=="journal")  journalState();
     else{
       mClui.os() << "Unknown command: \"" << cmd << "\"" << endl;
       printMenu();
@@ -138,6 +254,12 @@ Int_t BloBB::main()
     cmd = readCommand();
   }
 
+  // finish a background save
+  if(mSaver.isPending()){
+    mClui.os() << "Waiting for the save to " << mSaver.fileName() << endl;
+    reportSave(kTrue);
+  }
+  mClui.flush();
   return 0;
 }
 
@@ -155,6 +277,7 @@ void BloBB::printMenu() const
   mClui.os() << "\tW|warriors  List currently available warriors" << endl;  
   mClui.os() << "\tR|register  Register new or update old warrior" << endl;  
   mClui.os() << "\tF|fight     Start a fight" << endl;  
+  mClui.os() << "\tJ|journal   Journal changes to a state file" << endl;  
   mClui.os() << "***********************************" << endl;
 }
 
@@ -165,6 +288,7 @@ void BloBB::printWarriors(Bool_t verbose) const
   mClui.os() << endl;
   mClui.os() << "***********************************" << endl;
   mClui.os() << "Warriors:" << endl;
+  materialize();
   for(warCIter it = mWarriors.begin(); it != mWarriors.end(); ++it){
     if(!verbose)
       it->second.printStream(mClui.os(), kName|kTitle|kValue|kExtras, 
@@ -184,7 +308,7 @@ void BloBB::fight()
   mClui.request("first fighter name");
   string w1Name = mClui.readString();
   Warrior* w1 = 0;
-  if(mWarriors.count(w1Name) == 1) w1 = &mWarriors[w1Name];
+  if(hasWarrior(w1Name)) w1 = &mWarriors[w1Name];
   else{
     loutE(InputArguments) << "Cannot find warrior named \"" << w1Name << " \"!" << endl;
     return;
@@ -194,7 +318,7 @@ void BloBB::fight()
   mClui.request("second fighter name");
   string w2Name = mClui.readString();
   Warrior* w2 = 0;
-  if(mWarriors.count(w2Name) == 1) w2 = &mWarriors[w2Name];
+  if(hasWarrior(w2Name)) w2 = &mWarriors[w2Name];
   else{
     loutE(InputArguments) << "Cannot find warrior named \"" << w2Name << " \"!" << endl;
     return;
@@ -202,8 +326,16 @@ void BloBB::fight()
 
   // set up engine
   FightEngine fe(&mClui, &mRandom, w1, w2);
-  // run fight
+  // run fight: the narration (nothing logs meanwhile) is written at each 
+  // prompt; elsewhere unbuffered, in order with the log messages
+  Bool_t unbuffered = !mClui.isBuffered() && !mClui.isLineAtomic();
+  if(unbuffered) mClui.setBuffered();
   fe.fight();
+  if(unbuffered) mClui.setBuffered(kFalse);
+  // fighters & generator were modified in place
+  commit(w1Name);
+  commit(w2Name);
+  if(mJournal) mJournal->putRandom(mRandom);
 
   // print main menu when done
   printMenu();
@@ -227,7 +359,7 @@ void BloBB::registerWarrior()
       return;
     }
     // check for over-write
-    if(mWarriors.count(w.name()) == 0) addWarrior(w);
+    if(!hasWarrior(w.name())) addWarrior(w);
     else {
       loutW(InputArguments) << "Warrior named \"" << w.name() << "\" already exists!" << endl;
       mClui.request("overwrite this warrior with new values? (Y/N)");
@@ -240,7 +372,10 @@ void BloBB::registerWarrior()
   // update existing
   else{
     // check for existence
-    if(mWarriors.count(wName) == 1) mWarriors[wName].readFromUI(mClui, kTrue);
+    if(hasWarrior(wName)){
+      mWarriors[wName].readFromUI(mClui, kTrue);
+      commit(wName);
+    }
     else {
       loutE(InputArguments) << "Warrior named \"" << wName << "\" not found!" << endl;
       return;
@@ -259,8 +394,96 @@ void BloBB::saveState()
   mClui.request("file name to save (" + defFileName + ")");
   string fileName = mClui.readString();
   if(fileName == "") fileName = defFileName;
+  // journaled: only the journal is written
+  if(mJournal && fileName == mJournal->fileName()){
+    if(mJournal->sync()){
+      mSavedHash = hash();
+      mClui.os() << "Journal of " << fileName << " synced (" 
+		 << mJournal->numRecords() << " records)" << endl;
+    }
+    return;
+  }
+  // skip re-writing an unchanged state
+  ULong_t h = hash();
+  if(fileName == mSavedFileName && h == mSavedHash){
+    mClui.os() << "No changes since last save to " << fileName << endl;
+    return;
+  }
   mEndTime = TimeStamp(-1);
-  save(fileName);
+  if(saveAsync(fileName))
+    mClui.os() << "Saving to " << fileName << " in the background" << endl;
+}
+
+//_____________________________________________________________________________
+/** Report a finished background save; failures are logged by the writer.
+    \param wait Wait for a running save (else it is reported later). */
+void BloBB::reportSave(Bool_t wait)
+{
+  if(!mSaver.isPending() || (mSaver.isBusy() && !wait)) return;
+  string fileName = mSaver.fileName();
+  if(waitSave()) mClui.os() << "Saved " << fileName << endl;
+}
+
+//_____________________________________________________________________________
+/** Save the state to file, with the fastest writer for its type: 
+    text archives are streamed, warrior by warrior. */
+Bool_t BloBB::saveFile(const string& fileName) const
+{
+  string ext = GetFileExt(fileName);
+  Bool_t streamed = IsArchiveExt(ext) && IsTextArchive(GetArchiveTypeFromExt(ext));
+  return (streamed ? saveStreamed(fileName) : save(fileName));
+}
+
+//_____________________________________________________________________________
+/** Save the state to file in the background. A snapshot (copy) of the 
+    state is taken on this thread; it is written, synced and moved over 
+    the file on a background thread, see SnapshotSaver. A running save is 
+    waited for first. 
+    \param done Called, on the background thread, when finished.
+    \return "success" boolean: true if started. */
+Bool_t BloBB::saveAsync(const string& fileName, const SnapshotSaver::Done_t& done)
+{
+  if(!IsArchiveExt(GetFileExt(fileName))){
+    loutE(InputArguments) << "BloBB::saveAsync: Unkonwn file extension '" 
+			  << GetFileExt(fileName) << "', no data writen." << endl;
+    return kFalse;
+  }
+  waitSave();
+  std::shared_ptr<const BloBB> snapshot(new BloBB(*this, ""));
+  // hashed in the background too; read once waited for
+  return mSaver.start(fileName, [this, snapshot](const string& tmp){
+      mSaverHash = snapshot->hash();
+      return snapshot->saveFile(tmp); 
+    }, done);
+}
+
+//_____________________________________________________________________________
+/** Wait for a background save.
+    \return "success" boolean: true if the last save succeeded. */
+Bool_t BloBB::waitSave()
+{
+  if(!mSaver.isPending()) return mSaver.success();
+  if(!mSaver.wait()) return kFalse;
+  mSavedHash = mSaverHash;
+  mSavedFileName = mSaver.fileName();
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Load a state from file, with the fastest loader for its type: 
+    (large) JSON files are streamed, XML files are mapped and delta 
+    files are rebuilt from their chain (StateDelta::Load).
+    The file's journal, if any, is replayed. */
+Bool_t BloBB::loadFile(const string& fileName)
+{
+  string ext = GetFileExt(fileName);
+  Bool_t loaded(kFalse);
+  if(StateDelta::IsDeltaFile(fileName)) loaded = StateDelta::Load(fileName, *this);
+  else if(ext == GetArchiveExt(kJson))  loaded = JsonReader().load(fileName, *this);
+  else if(ext == GetArchiveExt(kXml))   loaded = XmlReader().load(fileName, *this);
+  else                                  loaded = load(fileName);
+  if(loaded) Journal::Replay(fileName, *this);
+  return loaded;
 }
 
 //_____________________________________________________________________________
@@ -273,10 +496,182 @@ void BloBB::loadState()
   if(fileName == ""){
     mClui.os() << "No file given to load" << endl;
     printMenu();
+    return;
+  }
+  // the journal would not describe the loaded state
+  if(mJournal){
+    mClui.os() << "Closing journal of " << mJournal->fileName() << endl;
+    closeJournal();
+  }
+  if(loadFile(fileName)){
+    mSavedHash = hash();
+    mSavedFileName = fileName;
+  }
+}
+
+//_____________________________________________________________________________
+/** Journal changes to a state file. */
+void BloBB::journalState()
+{
+  std::stringstream ss;
+  ss << "blobb-" << mStartTime.uts() << GetArchiveExt(kBinary);
+  string defFileName = ss.str();
+  mClui.request("state file to journal (" + defFileName + ")");
+  string fileName = mClui.readString();
+  if(fileName == "") fileName = defFileName;
+  if(openJournal(fileName))
+    mClui.os() << "Journaling changes to " << fileName << endl;
+}
+
+//_____________________________________________________________________________
+/** Record a warrior modified in place: re-index and journal it. 
+    Compaction is started when the journal grows too large. */
+void BloBB::commit(const string& name)
+{
+  reindex(name);
+  if(!mJournal) return;
+  mJournal->putWarrior(name, mWarriors.at(name));
+  if(mJournal->needsCompaction()) mJournal->compact(*this);
+}
+
+//_____________________________________________________________________________
+/** Start journaling changes to a state file (the base). An existing base 
+    is loaded (with its journal); otherwise the current state is saved as 
+    the base. Changes are then appended to the journal, see Journal.
+    \return "success" boolean: true if journaling. */
+Bool_t BloBB::openJournal(const string& fileName)
+{
+  closeJournal();
+  if(!IsArchiveExt(GetFileExt(fileName))){
+    loutE(InputArguments) << "BloBB::openJournal: Unkonwn file extension '" 
+			  << GetFileExt(fileName) << "', not journaling." << endl;
+    return kFalse;
+  }
+  // resume a journaled state, or start one (without stale journals)
+  if(std::ifstream(fileName.c_str()).good()){
+    if(!loadFile(fileName)) return kFalse;
   }
   else{
-    load(fileName);
+    if(!save(fileName)) return kFalse;
+    remove(Journal::JournalName(fileName).c_str());
+    remove((Journal::JournalName(fileName) + ".1").c_str());
+  }
+  mJournal = new Journal();
+  if(!mJournal->open(fileName)){ closeJournal(); return kFalse; }
+  mSavedHash = hash();
+  mSavedFileName = fileName;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Stop journaling; waits for compaction and syncs the journal. */
+void BloBB::closeJournal()
+{
+  if(mJournal){ delete mJournal; mJournal = 0; }
+}
+
+//_____________________________________________________________________________
+/** Merge the journal into a new base, in the background.
+    \return "success" boolean: true if started. */
+Bool_t BloBB::compactJournal()
+{
+  return (mJournal && mJournal->compact(*this));
+}
+
+//_____________________________________________________________________________
+/** Write the state as a memory-mapped roster (kMapped). 
+    \note The object name is not used; a roster holds one state. */
+void BloBB::writeArchive(ostream& os, eArchiveType arcType, 
+			 const string& objName) const
+{
+  if(arcType != kMapped){ Named::writeArchive(os, arcType, objName); return; }
+  materialize();
+  MappedRoster::Write(os, name(), title(), mStartTime, mEndTime, mRandom, mWarriors);
+}
+
+//_____________________________________________________________________________
+/** Load the state from a memory-mapped roster (kMapped), lazily: the
+    roster stays mapped and warriors are built when asked for.
+    \param objName Empty, the class name or the state name; a roster 
+    holds one state. */
+void BloBB::loadMapped(const string& fileName, const string& objName)
+{
+  std::shared_ptr<MappedRoster> roster(new MappedRoster());
+  if(!roster->open(fileName))
+    throw Exception("BloBB::loadMapped: Cannot open roster '" + fileName + "'.");
+  if(objName != "" && objName != className() && objName != roster->name())
+    throw Exception("BloBB::loadMapped: Roster '" + fileName + "' holds '" 
+		    + roster->name() + "', not '" + objName + "'.");
+  setNameTitle(roster->name(), roster->title());
+  mStartTime = roster->startTime();
+  mEndTime   = roster->endTime();
+  mRandom    = roster->random();
+  mWarriors.clear();
+  mIndex.clear();
+  mMapped = roster;
+  mMappedFileName = fileName;
+}
+
+//_____________________________________________________________________________
+/** Build all warriors of a mapped roster (not yet built) & index them; 
+    the file is let go of. */
+void BloBB::materialize() const
+{
+  if(!mMapped) return;
+  for(ULong_t i=0; i<mMapped->size(); i++){
+    string key = mMapped->key(i);
+    Warriors_t::iterator it = mWarriors.lower_bound(key);
+    if(it == mWarriors.end() || it->first != key)
+      mWarriors.emplace_hint(it, key, mMapped->warrior(i));
+  }
+  mMapped.reset();
+  mIndex.rebuild(mWarriors);
+}
+
+//_____________________________________________________________________________
+/** Build one warrior of a mapped roster, if not yet built. */
+void BloBB::fetch(const string& name) const
+{
+  if(!mMapped || mWarriors.count(name) == 1) return;
+  Long_t i = mMapped->find(name);
+  if(i >= 0) mWarriors.emplace(name, mMapped->warrior(i));
+}
+
+//_____________________________________________________________________________
+/** Build the mapped roster before its file is overwritten. */
+void BloBB::releaseFile(const string& fileName) const
+{
+  if(mMapped && fileName == mMappedFileName) materialize();
+}
+
+//_____________________________________________________________________________
+/** Write the state to a binary archive, with footer index entries for
+    the state and for each warrior ("<objName>/<key>"). The bytes are
+    those of write(os, kBinary), written part by part to the stream,
+    whose positions give the ranges. */
+void BloBB::writeIndexed(ostream& os, const string& objName, 
+			 IndexEntries_t& entries) const
+{
+  materialize();
+  std::streamoff start = os.tellp();
+  entries.reserve(entries.size() + 1 + mWarriors.size());
+  Pos_t state = entries.size();
+  IndexEntry_t entry = {objName, 0, 0};
+  entries.push_back(entry);
+  {
+    cereal::BinaryOutputArchive ar(os);
+    ar(cereal::base_class<Named>(this), mStartTime, mEndTime, mRandom, 
+       cereal::make_size_tag(static_cast<cereal::size_type>(mWarriors.size())));
+    for(warCIter it = mWarriors.begin(); it != mWarriors.end(); ++it){
+      ar(it->first);
+      entry.name   = objName + "/" + it->first;
+      entry.offset = ULong_t(os.tellp() - start);
+      ar(it->second);
+      entry.length = ULong_t(os.tellp() - start) - entry.offset;
+      entries.push_back(entry);
+    }
   }
+  entries[state].length = ULong_t(os.tellp() - start);
 }
 
 //_____________________________________________________________________________
@@ -4,40 +4,157 @@
     \date      07.06.2014
     \copyright See License.txt
 */
-#include "blobb/CLUI.hh"        // this class
+#include "blobb/CLUI.hh"          // this class
+#include "blobb/SharedOutput.hh"  // line-atomic writes
+#include "blobb/Sink.hh"          // output sinks
+#include <cstring>                // cplusplus.com/reference/cstring/
+#include <streambuf>              // cplusplus.com/reference/streambuf/
 
 namespace Blobb {
 
 const string CLUI::Prefix = "\x1b[1;41m[BloBB]\x1b[m \x1b[1;31m\xE2\x9E\xB3\x1b[m ";
 // const string CLUI::Prefix = "[BloBB]> ";
 
+const Pos_t CLUI::DefBufferSize = 1 << 16;
+const Pos_t CLUI::LineBufferSize = 1 << 12;
+
+/** \class CLUIBuffer
+    \brief Output buffer of a buffered or line-atomic CLUI.
+
+    Collects the output and writes it to the out-stream in one block
+    (WriteShared): complete lines when full, everything when drained.
+    Syncs (endl, flush) write the complete lines if line-atomic, else
+    are ignored.
+*/
+class CLUIBuffer : public std::streambuf {
+public:
+  //! Constructor
+  CLUIBuffer(ostream* os, Pos_t size, Bool_t lineAtomic)
+    : mOs(os), mBuffer(size > 0 ? size : 1), mLineAtomic(lineAtomic)
+  { setp(&mBuffer[0], &mBuffer[0] + mBuffer.size()); }
+
+  //! Set out-stream; the buffer is drained to the previous one first
+  void setOutStream(ostream* os){ drain(); mOs = os; }
+
+  //! Write the buffered output, if any, to the out-stream and flush it
+  void drain(){ write(pptr() - pbase()); }
+
+  //! Write the complete lines, if any; a partial line is kept
+  void drainLines()
+  {
+    Char_t* end = pptr();
+    while(end != pbase() && end[-1] != '\n') end--;
+    write(end - pbase());
+  }
+
+protected:
+  //! Buffer full: write its complete lines (or all, if none), then buffer c
+  virtual int_type overflow(int_type c)
+  {
+    drainLines();
+    if(pptr() == epptr()) drain();
+    if(!traits_type::eq_int_type(c, traits_type::eof())){
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  //! Write n characters; blocks larger than the buffer go straight through
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n)
+  {
+    if(n > epptr() - pptr()){
+      drainLines();
+      if(n > epptr() - pptr()) drain();
+      if(n >= epptr() - pptr()){
+	WriteShared(*mOs, s, ULong_t(n));
+	return n;
+      }
+    }
+    memcpy(pptr(), s, n);
+    pbump(Int_t(n));
+    return n;
+  }
+
+  //! Sync: complete lines written if line-atomic, else at the next drain
+  virtual int sync()
+  {
+    if(mLineAtomic) drainLines();
+    return 0;
+  }
+
+private:
+  //! Write the first n buffered characters; the rest is moved to the front
+  void write(std::ptrdiff_t n)
+  {
+    if(n == 0) return;
+    WriteShared(*mOs, pbase(), ULong_t(n));
+    std::ptrdiff_t rest = pptr() - pbase() - n;
+    if(rest > 0) memmove(pbase(), pbase() + n, rest);
+    setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+    pbump(Int_t(rest));
+  }
+
+private:
+  ostream*       mOs;          //!< out-stream
+  vector<Char_t> mBuffer;      //!< buffer
+  Bool_t         mLineAtomic;  //!< complete lines written at syncs
+};
+
 //_____________________________________________________________________________
 /** Default constructor. */
 CLUI::CLUI()
   : mOs(&cout),
-    mIs(&cin)
+    mIs(&cin),
+    mBuffer(0),
+    mBufOs(0),
+    mLineAtomic(kFalse)
 {}
 
 //_____________________________________________________________________________
-/** Copy constructor. */
+/** Copy constructor; a buffered (or line-atomic) copy has its own buffer. */
 CLUI::CLUI(const CLUI& other)
   : mOs(other.mOs),
-    mIs(other.mIs)
-{}
+    mIs(other.mIs),
+    mBuffer(0),
+    mBufOs(0),
+    mLineAtomic(kFalse)
+{
+  if(other.isLineAtomic()) setLineAtomic();
+  else                     setBuffered(other.isBuffered());
+}
 
 //_____________________________________________________________________________
 /** Assignment operator. */
 CLUI& CLUI::operator=(const CLUI& rhs)
 {
+  if(this == &rhs) return *this;
+  setBuffered(kFalse);
   mOs = rhs.mOs;
   mIs = rhs.mIs;
+  if(rhs.isLineAtomic()) setLineAtomic();
+  else                   setBuffered(rhs.isBuffered());
   return *this;
 }
 
+//_____________________________________________________________________________
+/** Destructor; buffered output is flushed. */
+CLUI::~CLUI()
+{
+  setBuffered(kFalse);
+}
+
 //_____________________________________________________________________________
 //! Get out-stream
 ostream& CLUI::os(Bool_t prefix)
 { 
+  // failed (e.g. null sink): nothing is written
+  if(mOs->bad()) return (*mOs);
+  // buffered: written at the next prompt or flush (or endl, if line-atomic)
+  if(mBufOs){
+    if(prefix) (*mBufOs) << Prefix;
+    return (*mBufOs);
+  }
   // Flush any previous messages
   (*mOs).flush();
   // print the prefix
@@ -50,9 +167,62 @@ ostream& CLUI::os(Bool_t prefix)
 //! Set out-stream
 void CLUI::setOutStream(ostream* os)
 { 
+  if(mBuffer) mBuffer->setOutStream(os);
   mOs = os; 
 }
 
+//_____________________________________________________________________________
+/** Set the out-stream to a sink's (0: std::cout); the sink must outlive
+    its use. */
+void CLUI::setSink(Sink* sink)
+{
+  setOutStream(sink ? &sink->os() : &cout);
+}
+
+//_____________________________________________________________________________
+/** Set buffered output (or none: unbuffered, not line-atomic);
+    unbuffering flushes the buffer.
+    \param bufferSize Size of the buffer [bytes]. */
+void CLUI::setBuffered(Bool_t buffered, Pos_t bufferSize)
+{
+  resetBuffer(buffered ? bufferSize : 0, kFalse);
+}
+
+//_____________________________________________________________________________
+/** Set line-atomic output (or none: unbuffered, not line-atomic), for
+    sessions sharing the out-stream. */
+void CLUI::setLineAtomic(Bool_t lineAtomic)
+{
+  resetBuffer(lineAtomic ? LineBufferSize : 0, kTrue);
+}
+
+//_____________________________________________________________________________
+/** Replace the output buffer, after flushing it; none if size 0. */
+void CLUI::resetBuffer(Pos_t bufferSize, Bool_t lineAtomic)
+{
+  if(mBuffer){
+    mBuffer->drain();
+    delete mBufOs;
+    delete mBuffer;
+    mBufOs = 0;
+    mBuffer = 0;
+  }
+  mLineAtomic = (bufferSize > 0 && lineAtomic);
+  if(bufferSize > 0){
+    mBuffer = new CLUIBuffer(mOs, bufferSize, lineAtomic);
+    mBufOs = new ostream(mBuffer);
+    mBufOs->copyfmt(*mOs);
+  }
+}
+
+//_____________________________________________________________________________
+//! Write any buffered output & flush the out-stream
+void CLUI::flush()
+{
+  if(mBuffer) mBuffer->drain();
+  else        mOs->flush();
+}
+
 //_____________________________________________________________________________
 //! Get in-stream
 istream& CLUI::is()
@@ -72,6 +242,7 @@ void CLUI::setInStream(istream* is)
 void CLUI::request(const string& req)
 {
   os() << "Enter " << req << ": "; 
+  flush();
 }
 
 //_____________________________________________________________________________
@@ -79,6 +250,7 @@ void CLUI::request(const string& req)
 string CLUI::readString()
 {
   string str;
+  flush();
   std::getline(*mIs, str);
   return str;
 }
@@ -0,0 +1,242 @@
+/** \file      src/lib/Converter.cxx
+    \brief     Source for Converter
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Converter.hh"      // this class
+#include "blobb/LogService.hh"     // logging
+#include "blobb/LzStreamBuf.hh"    // codec threads
+#include "blobb/StateDelta.hh"     // delta snapshots
+#include "blobb/StringTools.hh"    // file-name tools
+#include <atomic>                  // cplusplus.com/reference/atomic/
+#include <cstdio>                  // cplusplus.com/reference/cstdio/
+#include <thread>                  // cplusplus.com/reference/thread/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Constructor.
+    \param numThreads Worker threads; 0 for the hardware concurrency. */
+Converter::Converter(eArchiveType outType, UInt_t numThreads)
+  : mOutType(outType),
+    mNumThreads(1),
+    mOutDir(""),
+    mOverwrite(kFalse),
+    mSync(kFalse),
+    mNumDone(0),
+    mNumFailed(0)
+{
+  setNumThreads(numThreads);
+}
+
+//_____________________________________________________________________________
+/** Set the number of worker threads; 0 for the hardware concurrency. */
+void Converter::setNumThreads(UInt_t numThreads)
+{
+  if(numThreads == 0) numThreads = std::thread::hardware_concurrency();
+  mNumThreads = (numThreads == 0 ? 1 : numThreads);
+}
+
+//_____________________________________________________________________________
+/** Set the output directory; a trailing "/" is added if needed. */
+void Converter::setOutDir(const string& dir)
+{
+  mOutDir = dir;
+  if(mOutDir != "" && mOutDir[mOutDir.size()-1] != '/') mOutDir += '/';
+}
+
+//_____________________________________________________________________________
+/** Output file of an input file: the output directory (or the input's),
+    the input's base name and the output type's extension. 
+    Delta files are rebuilt: their output has no ".delta" suffix. */
+string Converter::outFileName(const string& inFileName) const
+{
+  string dir = (mOutDir == "" ? GetFileDir(inFileName) : mOutDir);
+  string base = GetFileBase(inFileName);
+  if(StateDelta::IsDeltaFile(inFileName)) base = GetFileBase(base);
+  return dir + base + GetArchiveExt(mOutType);
+}
+
+//_____________________________________________________________________________
+/** Convert each file to outFileName(file), in parallel.
+    \return "success" boolean: true if all files were converted. */
+Bool_t Converter::convert(const vector<string>& fileNames)
+{
+  run(fileNames.size(), [this, &fileNames](UInt_t i){
+      const string& in = fileNames[i];
+      string out = outFileName(in);
+      if(out == in){
+	loutE(InputArguments) << "Converter::convert: '" << in
+			      << "' is already of the output type." << endl;
+	return kFalse;
+      }
+      if(!canWrite(out)) return kFalse;
+      BloBB blobb;
+      return blobb.loadFile(in) && write(blobb, out);
+    });
+  return mNumFailed == 0;
+}
+
+//_____________________________________________________________________________
+/** Merge the shards of a roster into one file; the shards are decoded in
+    parallel, then merged in shard order. Name, times & random state are
+    those of the first shard; a warrior in several shards is taken from
+    the first (lowest-numbered) of them, so the output does not depend on
+    the decoding order.
+    \return "success" boolean: true if all shards were read and merged. */
+Bool_t Converter::merge(const vector<string>& shardNames, const string& outFileName)
+{
+  BloBB merged;
+  vector<Warriors_t> shards(shardNames.size());
+  run(shardNames.size(), [&](UInt_t i){
+      BloBB shard;
+      if(!shard.loadFile(shardNames[i])) return kFalse;
+      // only this job touches merged
+      if(i == 0){
+	merged.setNameTitle(shard.name(), shard.title());
+	merged.setStartTime(shard.startTime());
+	merged.setEndTime(shard.endTime());
+	merged.setRandom(shard.random());
+      }
+      shards[i].swap(shard.warriors());
+      return kTrue;
+    });
+
+  // written only if complete
+  Bool_t ok(mNumFailed == 0);
+  mNumDone = 0;
+  if(!ok) return kFalse;
+  Warriors_t& wars = merged.warriors();
+  Pos_t numDuplicates(0);
+  for(Pos_t s=0; s<shards.size(); s++){
+    Pos_t size = wars.size();
+    wars.insert(shards[s].begin(), shards[s].end());
+    numDuplicates += size + shards[s].size() - wars.size();
+    Warriors_t().swap(shards[s]);
+  }
+  if(numDuplicates > 0)
+    loutW(DataHandling) << "Converter::merge: " << numDuplicates
+			<< " warrior(s) in more than one shard." << endl;
+  merged.reindex();
+  ok = write(merged, outFileName);
+  if(ok) mNumDone = 1;
+  else   mNumFailed++;
+  return ok;
+}
+
+//_____________________________________________________________________________
+/** Split a file into numShards shards, ShardName(outFileName(file), i),
+    of consecutive warriors; the shards are built & encoded in parallel.
+    \return "success" boolean: true if all shards were written. */
+Bool_t Converter::split(const string& fileName, UInt_t numShards)
+{
+  BloBB blobb;
+  if(numShards == 0 || !blobb.loadFile(fileName)){
+    mNumDone = 0;
+    mNumFailed = 1;
+    return kFalse;
+  }
+
+  // first warrior of each shard (and the end)
+  const Warriors_t& wars = blobb.warriors();
+  vector<Warriors_t::const_iterator> bounds(1, wars.begin());
+  Warriors_t::const_iterator it = wars.begin();
+  for(UInt_t s=1; s<=numShards; s++){
+    Pos_t size = wars.size()*s/numShards - wars.size()*(s-1)/numShards;
+    for(Pos_t w=0; w<size; w++) ++it;
+    bounds.push_back(it);
+  }
+
+  string out = outFileName(fileName);
+  run(numShards, [&](UInt_t s){
+      BloBB shard;
+      shard.setNameTitle(blobb.name(), blobb.title());
+      shard.setStartTime(blobb.startTime());
+      shard.setEndTime(blobb.endTime());
+      shard.setRandom(blobb.random());
+      shard.warriors().insert(bounds[s], bounds[s+1]);
+      shard.reindex();
+      return write(shard, ShardName(out, s));
+    });
+  return mNumFailed == 0;
+}
+
+//_____________________________________________________________________________
+/** Name of a shard: the file's base name with a 3-digit shard number,
+    e.g. roster-007.cnb. */
+string Converter::ShardName(const string& fileName, UInt_t shard)
+{
+  Char_t num[16];
+  snprintf(num, sizeof(num), "-%03u", shard);
+  return GetFileDir(fileName) + GetFileBase(fileName) + num + GetFileExt(fileName);
+}
+
+//_____________________________________________________________________________
+/** Can the file be written: not existing, or overwrite()?
+    \return "success" boolean: true if it can. */
+Bool_t Converter::canWrite(const string& fileName) const
+{
+  if(mOverwrite) return kTrue;
+  FILE* file = fopen(fileName.c_str(), "rb");
+  if(!file) return kTrue;
+  fclose(file);
+  loutE(InputArguments) << "Converter: '" << fileName << "' exists, not overwritten." << endl;
+  return kFalse;
+}
+
+//_____________________________________________________________________________
+/** Write a state to a temporary file & rename it over the target.
+    \return "success" boolean: true if written. */
+Bool_t Converter::write(const BloBB& blobb, const string& fileName) const
+{
+  if(!canWrite(fileName)) return kFalse;
+  string tmp = SnapshotSaver::TempName(fileName);
+  Bool_t ok = blobb.saveFile(tmp) && (!mSync || SnapshotSaver::SyncFile(tmp));
+  if(ok && rename(tmp.c_str(), fileName.c_str()) != 0){
+    loutE(DataHandling) << "Converter: Failed to replace '" << fileName << "'." << endl;
+    ok = kFalse;
+  }
+  if(!ok) remove(tmp.c_str());
+  else if(mSync) ok = SnapshotSaver::SyncDir(fileName);
+  return ok;
+}
+
+//_____________________________________________________________________________
+/** Run job(i), for i in [0, numJobs), on the worker threads; each worker
+    takes the next job when done with its last. Counts the results.
+    The workers share the cores: the compressed streams they open get
+    only their share of codec threads (SetLzThreads). */
+void Converter::run(UInt_t numJobs, const std::function<Bool_t(UInt_t)>& job)
+{
+  mNumDone = 0;
+  mNumFailed = 0;
+  if(numJobs == 0) return;
+  UInt_t nt = (numJobs < mNumThreads ? numJobs : mNumThreads);
+  UInt_t numCores = std::thread::hardware_concurrency();
+  UInt_t lzThreads = (numCores > nt ? numCores / nt : 1);
+  std::atomic<UInt_t> next(0);
+  std::atomic<Pos_t> numDone(0), numFailed(0);
+  auto work = [&](){
+    UInt_t defThreads = GetLzThreads();
+    if(nt > 1) SetLzThreads(lzThreads);
+    for(UInt_t i = next++; i < numJobs; i = next++){
+      Bool_t ok(kFalse);
+      try{ ok = job(i); }
+      catch(std::exception& e){
+	loutE(DataHandling) << "Converter: Job " << i << " failed; " << e.what() << endl;
+      }
+      if(ok) numDone++;
+      else   numFailed++;
+    }
+    SetLzThreads(defThreads);
+  };
+  vector<std::thread> threads;
+  for(UInt_t t=1; t<nt; t++) threads.push_back(std::thread(work));
+  work();
+  for(UInt_t t=0; t<threads.size(); t++) threads[t].join();
+  mNumDone = numDone;
+  mNumFailed = numFailed;
+}
+
+} // end namespace Blobb
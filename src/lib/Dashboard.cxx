@@ -0,0 +1,285 @@
+/** \file      src/lib/Dashboard.cxx
+    \brief     Source for Dashboard
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Dashboard.hh"     // this class
+#include "blobb/SharedOutput.hh"  // one write per frame
+#include <algorithm>              // cplusplus.com/reference/algorithm/
+#include <cstdio>                 // cplusplus.com/reference/cstdio/
+
+namespace Blobb {
+
+const Double_t Dashboard::DefMaxRate = 10.;
+
+//! Style of the title row (as CLUI's prefix).
+static const string gTitleStyle = "\x1b[1;41m";
+//! Style of the section headers.
+static const string gHeaderStyle = "\x1b[1m";
+//! Unchanged cells rewritten rather than skipped by a cursor move.
+static const Pos_t gMaxGap = 8;
+
+//_____________________________________________________________________________
+/** Constructor.
+    \param os      Terminal stream.
+    \param maxRate Maximum refresh rate [frames/s].
+    \param width   Screen width; 0: $COLUMNS, else 80.
+    \param height  Screen height; 0: $LINES, else 24. */
+Dashboard::Dashboard(ostream& os, Double_t maxRate, Pos_t width, Pos_t height)
+  : mOs(os),
+    mMaxRate(maxRate > 0. ? maxRate : DefMaxRate),
+    mWidth(width),
+    mHeight(height),
+    mTitle(""),
+    mNames(),
+    mNumMatches(0),
+    mWins(),
+    mLosses(),
+    mDraws(),
+    mSlots(),
+    mNumSlots(0),
+    mNumDone(0),
+    mStartTime(),
+    mLastTime(),
+    mLastDone(0),
+    mRate(0.),
+    mRows(),
+    mStyles(),
+    mNumFrames(0),
+    mNumBytes(0),
+    mThread(),
+    mMutex(),
+    mWake(),
+    mStop(kFalse)
+{
+  CChar_t* env(0);
+  if(mWidth == 0)  mWidth  = ((env = getenv("COLUMNS")) ? Pos_t(atoi(env)) : 80);
+  if(mHeight == 0) mHeight = ((env = getenv("LINES"))   ? Pos_t(atoi(env)) : 24);
+  mWidth  = std::max(mWidth, Pos_t(40));
+  mHeight = std::max(mHeight, Pos_t(10));
+}
+
+//_____________________________________________________________________________
+/** Destructor; a running dashboard is stopped. */
+Dashboard::~Dashboard()
+{
+  stop();
+}
+
+//_____________________________________________________________________________
+/** Clear the screen and start drawing a tournament; a running one is
+    stopped first.
+    \param names      Warriors, indexed by the workers' reports.
+    \param numMatches Matches to fight.
+    \param numSlots   Matches fought at once (workers). */
+void Dashboard::start(const string& title, const vector<string>& names, ULong_t numMatches,
+		      Pos_t numSlots)
+{
+  stop();
+  mTitle = title;
+  mNames = names;
+  mNumMatches = numMatches;
+  Pos_t n = mNames.size();
+  mWins.reset(new std::atomic<UInt_t>[n]);
+  mLosses.reset(new std::atomic<UInt_t>[n]);
+  mDraws.reset(new std::atomic<UInt_t>[n]);
+  for(Pos_t w=0; w<n; w++){
+    mWins[w].store(0);
+    mLosses[w].store(0);
+    mDraws[w].store(0);
+  }
+  mNumSlots = numSlots;
+  mSlots.reset(new std::atomic<ULong_t>[mNumSlots]);
+  for(Pos_t s=0; s<mNumSlots; s++) mSlots[s].store(0);
+  mNumDone.store(0);
+  mStartTime = mLastTime = Clock_t::now();
+  mLastDone = 0;
+  mRate = 0.;
+  mNumFrames = mNumBytes = 0;
+
+  // hide the cursor & clear the screen
+  const string clear("\x1b[?25l\x1b[H\x1b[2J");
+  WriteShared(mOs, clear.data(), clear.size());
+  mRows.assign(mHeight, string(mWidth, ' '));
+  mStyles.assign(mHeight, "");
+  mStop = kFalse;
+  mThread = std::thread(&Dashboard::run, this);
+}
+
+//_____________________________________________________________________________
+/** Stop drawing, after a final frame; the cursor is left below it. */
+void Dashboard::stop()
+{
+  if(!isRunning()) return;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = kTrue;
+  }
+  mWake.notify_all();
+  mThread.join();
+  draw();
+  Char_t leave[32];
+  Int_t size = snprintf(leave, sizeof(leave), "\x1b[%u;1H\x1b[?25h\n", mHeight);
+  WriteShared(mOs, leave, ULong_t(size));
+}
+
+//_____________________________________________________________________________
+/** A worker (slot) starts a match between two warriors. */
+void Dashboard::startMatch(Pos_t slot, Pos_t first, Pos_t second)
+{
+  if(slot >= mNumSlots) return;
+  mSlots[slot].store((ULong_t(first + 1) << 32) | ULong_t(second + 1), std::memory_order_relaxed);
+}
+
+//_____________________________________________________________________________
+/** A worker (slot) finished a match: won by the first (1) or the second
+    (2) warrior, else a draw (0). */
+void Dashboard::finishMatch(Pos_t slot, Pos_t first, Pos_t second, Int_t result)
+{
+  if     (result == 1){ mWins[first]++;  mLosses[second]++; }
+  else if(result == 2){ mWins[second]++; mLosses[first]++;  }
+  else                { mDraws[first]++; mDraws[second]++;  }
+  if(slot < mNumSlots) mSlots[slot].store(0, std::memory_order_relaxed);
+  mNumDone.fetch_add(1, std::memory_order_relaxed);
+}
+
+//_____________________________________________________________________________
+/** Drawing thread: a frame per period, until stopped. */
+void Dashboard::run()
+{
+  std::chrono::duration<Double_t> period(1./mMaxRate);
+  std::unique_lock<std::mutex> lock(mMutex);
+  while(!mStop){
+    lock.unlock();
+    draw();
+    lock.lock();
+    mWake.wait_for(lock, period, [this](){ return mStop; });
+  }
+}
+
+//_____________________________________________________________________________
+/** Draw a frame: the changed cells, in one write. */
+void Dashboard::draw()
+{
+  vector<string> rows, styles;
+  compose(rows, styles);
+  string out;
+  for(Pos_t r=0; r<mHeight; r++) diff(r, rows[r], styles[r], out);
+  mRows.swap(rows);
+  mStyles.swap(styles);
+  mNumFrames++;
+  if(out.empty()) return;
+  WriteShared(mOs, out.data(), out.size());
+  mNumBytes += out.size();
+}
+
+//_____________________________________________________________________________
+/** Compose a frame: rows of text (width cells) and their styles. */
+void Dashboard::compose(vector<string>& rows, vector<string>& styles)
+{
+  rows.assign(mHeight, "");
+  styles.assign(mHeight, "");
+  Char_t line[256];
+  Pos_t r(0);
+
+  // title
+  rows[r] = " BloBB " + mTitle;
+  styles[r++] = gTitleStyle;
+
+  // throughput: smoothed over the frames, ETA from the average
+  Clock_t::time_point now = Clock_t::now();
+  ULong_t done = mNumDone.load(std::memory_order_relaxed);
+  Double_t elapsed = std::chrono::duration<Double_t>(now - mStartTime).count();
+  Double_t dt = std::chrono::duration<Double_t>(now - mLastTime).count();
+  if(dt > 0.){
+    Double_t rate = (done - mLastDone)/dt;
+    mRate = (mNumFrames == 0 ? rate : 0.5*mRate + 0.5*rate);
+    mLastTime = now;
+    mLastDone = done;
+  }
+  Double_t eta = (done > 0 ? (mNumMatches - done)*elapsed/done : 0.);
+  snprintf(line, sizeof(line), " Fights %lu/%lu (%.1f%%)   %.0f fights/s   elapsed %.1f s   ETA %.1f s",
+	   (unsigned long)done, (unsigned long)mNumMatches,
+	   (mNumMatches > 0 ? 100.*done/mNumMatches : 100.), mRate, elapsed, eta);
+  rows[r++] = line;
+  r++;
+
+  // matches in progress
+  rows[r] = " In progress";
+  styles[r++] = gHeaderStyle;
+  for(Pos_t s=0; s<mNumSlots && r+3<mHeight; s++){
+    ULong_t match = mSlots[s].load(std::memory_order_relaxed);
+    if(match == 0) rows[r++] = "   -";
+    else rows[r++] = "   " + mNames[(match >> 32) - 1] + " vs. " + mNames[(match & 0xffffffff) - 1];
+  }
+  r++;
+
+  // standings: most wins, then fewest losses
+  Pos_t n = mNames.size();
+  vector<UInt_t> wins(n), losses(n), draws(n);
+  vector<Pos_t> order(n);
+  for(Pos_t w=0; w<n; w++){
+    wins[w] = mWins[w].load(std::memory_order_relaxed);
+    losses[w] = mLosses[w].load(std::memory_order_relaxed);
+    draws[w] = mDraws[w].load(std::memory_order_relaxed);
+    order[w] = w;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](Pos_t a, Pos_t b){
+      return (wins[a] != wins[b] ? wins[a] > wins[b] : losses[a] < losses[b]);
+    });
+  Int_t nameWidth = Int_t(mWidth) - 30;
+  if(r < mHeight){
+    snprintf(line, sizeof(line), " %4s  %-*.*s %6s %6s %6s", "#", nameWidth, nameWidth, "Warrior",
+	     "Wins", "Losses", "Draws");
+    rows[r] = line;
+    styles[r++] = gHeaderStyle;
+  }
+  for(Pos_t k=0; k<n && r<mHeight; k++){
+    Pos_t w = order[k];
+    snprintf(line, sizeof(line), " %4u  %-*.*s %6u %6u %6u", k+1, nameWidth, nameWidth,
+	     mNames[w].c_str(), wins[w], losses[w], draws[w]);
+    rows[r++] = line;
+  }
+
+  // fit the rows to the screen
+  for(Pos_t row=0; row<mHeight; row++) rows[row].resize(mWidth, ' ');
+}
+
+//_____________________________________________________________________________
+/** Append the redraw of a row's changed cells to out: runs of changed
+    cells (joined across short unchanged gaps), each after a cursor
+    move; the whole row if its style changed. */
+void Dashboard::diff(Pos_t row, const string& text, const string& style, string& out) const
+{
+  const string& old = mRows[row];
+  Bool_t restyled = (style != mStyles[row]);
+  Pos_t c(0), n(text.size());
+  while(c < n){
+    if(!restyled && text[c] == old[c]){
+      c++;
+      continue;
+    }
+    // the run ends before gMaxGap unchanged cells
+    Pos_t begin(c), end(c + 1);
+    if(restyled) end = n;
+    for(Pos_t same = 0; end < n && same < gMaxGap; ){
+      Pos_t next = end + same;
+      if(next >= n) break;
+      if(text[next] == old[next]) same++;
+      else{
+	end = next + 1;
+	same = 0;
+      }
+    }
+    Char_t move[32];
+    snprintf(move, sizeof(move), "\x1b[%u;%uH", row + 1, begin + 1);
+    out += move;
+    if(style != "") out += style;
+    out.append(text, begin, end - begin);
+    if(style != "") out += "\x1b[m";
+    c = end;
+  }
+}
+
+} // end namespace Blobb
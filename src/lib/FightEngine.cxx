@@ -5,6 +5,8 @@
     \copyright See License.txt
 */
 #include "blobb/FightEngine.hh"        // this class
+#include "blobb/BinaryLog.hh"          // printf-style debug messages
+#include "blobb/Format.hh"             // formatting into buffers
 
 namespace Blobb {
 
@@ -46,6 +48,7 @@ Int_t FightEngine::fight()
     cmd = readCommand();
   }
 
+  mClui->flush();
   return 0;
 }
 
@@ -133,6 +136,8 @@ void FightEngine::swing() const
 		<< mW2->name() << ": " << w2swing << endl;
     Double_t swingResult = w1swing - w2swing;
     mClui->os() << "swing result: " << swingResult << endl;
+    loutfD(Evaluation, "FightEngine::swing: %s %g vs %s %g, result %g",
+	   mW1->name(), w1swing, mW2->name(), w2swing, swingResult);
 
     // after calculating swingresult (who came out ahead in the swing), 
     // resolve damage
@@ -182,16 +187,33 @@ void FightEngine::swing() const
   mW2->mHealth.incrValue(-w2bleedH);
   mW2->mFatigue.incrValue(-w2bleedF);
 
-  // show snapshot of fight.
-  mClui->os() << mW1->name() 
-	      << " health: " << mW1->mHealth.value()  << "-" << w1bleedH << " per rd, " 
-	      << "fatigue: " << mW1->mFatigue.value() << "-" << w1bleedF << " per rd" << endl;
+  loutfD(Evaluation, "FightEngine::swing: %s health %g fatigue %g, %s health %g fatigue %g",
+	 mW1->name(), mW1->mHealth.value(), mW1->mFatigue.value(),
+	 mW2->name(), mW2->mHealth.value(), mW2->mFatigue.value());
+
+  // show snapshot of fight: each line formatted in a buffer, one write & flush.
+  Char_t storage[160];
+  {
+    ostream& os = mClui->os();
+    FormatBuffer fb(os, storage, sizeof(storage));
+    fb << mW1->name() 
+       << " health: " << mW1->mHealth.value()  << '-' << w1bleedH << " per rd, " 
+       << "fatigue: " << mW1->mFatigue.value() << '-' << w1bleedF << " per rd" << '\n';
+    fb.flush();
+    os.flush();
+  }
   if(mW1->collapsed())
     mClui->os() << mW1->name() << " collapses. *****" << endl;
 
-  mClui->os() << mW2->name() 
-	      << " health: " << mW2->mHealth.value()  << "-" << w2bleedH << " per rd, " 
-	      << "fatigue: " << mW2->mFatigue.value() << "-" << w2bleedF << " per rd" << endl;
+  {
+    ostream& os = mClui->os();
+    FormatBuffer fb(os, storage, sizeof(storage));
+    fb << mW2->name() 
+       << " health: " << mW2->mHealth.value()  << '-' << w2bleedH << " per rd, " 
+       << "fatigue: " << mW2->mFatigue.value() << '-' << w2bleedF << " per rd" << '\n';
+    fb.flush();
+    os.flush();
+  }
   if(mW2->collapsed())
     mClui->os() << mW2->name() << " collapses. *****" << endl;
         
@@ -220,11 +242,12 @@ void FightEngine::swing() const
 }
 
 //_____________________________________________________________________________
-/** A death match between fighters. */
+/** A death match between fighters; a buffered CLUI is flushed at the end. */
 void FightEngine::death() const
 {
   while(!fightEnded())
     swing();
+  mClui->flush();
 }
 
 } // end namespace Blobb
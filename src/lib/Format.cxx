@@ -0,0 +1,221 @@
+/** \file      src/lib/Format.cxx
+    \brief     Source for formatting into caller-provided buffers
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Format.hh"  // these functions
+#include <cmath>            // cplusplus.com/reference/cmath/
+#include <cstdio>           // cplusplus.com/reference/cstdio/
+#include <cstring>          // cplusplus.com/reference/cstring/
+#include <locale>           // cplusplus.com/reference/locale/
+#include <sstream>          // cplusplus.com/reference/sstream/
+#include <locale.h>         // newlocale & uselocale (C locale)
+#ifdef __APPLE__
+  #include <xlocale.h>      // uselocale
+#endif
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** %.*g of value in the C locale, as a classic-locale stream prints it
+    (whatever the process' LC_NUMERIC); snprintf's return. */
+static Int_t PrintC(Char_t* first, Pos_t size, Int_t precision, Double_t value)
+{
+#if defined(_MSC_VER)
+  static const _locale_t c = _create_locale(LC_NUMERIC, "C");
+  return _snprintf_l(first, size, "%.*g", c, precision, value);
+#elif defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+  static const locale_t c = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+  locale_t old = uselocale(c);
+  Int_t n = snprintf(first, size, "%.*g", precision, value);
+  uselocale(old);
+  return n;
+#else
+  std::ostringstream os;
+  os.imbue(std::locale::classic());
+  os.precision(precision);
+  os << value;
+  string s = os.str();
+  if(s.size() < size) memcpy(first, s.c_str(), s.size() + 1);
+  return Int_t(s.size());
+#endif
+}
+
+//_____________________________________________________________________________
+/** Integers below 10^precision are printed by %g as their digits: those
+    are converted directly, the others by snprintf. */
+Char_t* FormatChars(Char_t* first, Char_t* last, Double_t value, Int_t precision)
+{
+  static const Double_t powers[] = {1., 1.e1, 1.e2, 1.e3, 1.e4, 1.e5, 1.e6, 1.e7, 1.e8,
+				    1.e9, 1.e10, 1.e11, 1.e12, 1.e13, 1.e14, 1.e15};
+  Int_t p = (precision > 0 ? precision : (precision == 0 ? 1 : 6));
+  if(p < 16 && std::fabs(value) < powers[p] && value == std::floor(value) &&
+     !(value == 0. && std::signbit(value)))
+    return FormatChars(first, last, Long_t(value));
+
+  if(last - first <= 0) return 0;
+  Int_t n = PrintC(first, Pos_t(last - first), p, value);
+  if(n < 0 || n >= last - first) return 0;
+  return first + n;
+}
+
+//_____________________________________________________________________________
+Char_t* FormatChars(Char_t* first, Char_t* last, Long_t value)
+{
+  if(value >= 0) return FormatChars(first, last, ULong_t(value));
+  if(last - first < 2) return 0;
+  *first = '-';
+  return FormatChars(first + 1, last, ULong_t(0) - ULong_t(value));
+}
+
+//_____________________________________________________________________________
+Char_t* FormatChars(Char_t* first, Char_t* last, ULong_t value)
+{
+  // digits backwards, then copied
+  Char_t digits[20];
+  Char_t* d = digits + sizeof(digits);
+  do{
+    *--d = Char_t('0' + value % 10);
+    value /= 10;
+  } while(value > 0);
+  Pos_t n = Pos_t(digits + sizeof(digits) - d);
+  if(last - first < Long_t(n)) return 0;
+  memcpy(first, d, n);
+  return first + n;
+}
+
+//_____________________________________________________________________________
+/** Constructor.
+    \param os       Target stream; its precision is used.
+    \param storage  Caller-provided storage.
+    \param capacity Size of the storage [bytes]. */
+FormatBuffer::FormatBuffer(ostream& os, Char_t* storage, Pos_t capacity)
+  : mOs(os),
+    mBegin(storage),
+    mEnd(storage + capacity),
+    mPos(storage),
+    mPrecision(Int_t(os.precision())),
+    mByStream((os.flags() & (std::ios_base::floatfield | std::ios_base::showpos |
+			     std::ios_base::showpoint | std::ios_base::uppercase |
+			     std::ios_base::showbase)) != 0 ||
+	      (os.flags() & std::ios_base::basefield) != std::ios_base::dec ||
+	      os.width() != 0 || os.getloc() != std::locale::classic())
+{}
+
+//_____________________________________________________________________________
+/** Append n characters; the storage is written out first if they do not
+    fit, and a block larger than the storage is written directly. */
+void FormatBuffer::append(CChar_t* s, Pos_t n)
+{
+  if(mOs.bad()) return;
+  if(n > Pos_t(mEnd - mPos)){
+    flush();
+    if(n > Pos_t(mEnd - mPos)){
+      mOs.write(s, n);
+      return;
+    }
+  }
+  memcpy(mPos, s, n);
+  mPos += n;
+}
+
+//_____________________________________________________________________________
+/** Write the text out, in one piece; the storage is emptied. */
+void FormatBuffer::flush()
+{
+  if(mPos == mBegin) return;
+  mOs.write(mBegin, mPos - mBegin);
+  mPos = mBegin;
+}
+
+//_____________________________________________________________________________
+//! Append a C-string
+FormatBuffer& FormatBuffer::operator<<(CChar_t* s)
+{
+  append(s, Pos_t(strlen(s)));
+  return *this;
+}
+
+//_____________________________________________________________________________
+//! Append a character
+FormatBuffer& FormatBuffer::operator<<(Char_t c)
+{
+  if(mPos == mEnd) flush();
+  if(mPos == mEnd) mOs.put(c);
+  else *mPos++ = c;
+  return *this;
+}
+
+//_____________________________________________________________________________
+/** Append a double; if it does not fit even in the emptied storage, or
+    the stream's format is not the default, it is formatted by the
+    stream. Nothing is formatted for a bad stream (e.g. a NullSink's). */
+FormatBuffer& FormatBuffer::operator<<(Double_t value)
+{
+  if(mOs.bad()) return *this;
+  if(mByStream){
+    flush();
+    mOs << value;
+    return *this;
+  }
+  Char_t* end = FormatChars(mPos, mEnd, value, mPrecision);
+  if(!end){
+    flush();
+    end = FormatChars(mPos, mEnd, value, mPrecision);
+    if(!end){
+      mOs << value;
+      return *this;
+    }
+  }
+  mPos = end;
+  return *this;
+}
+
+//_____________________________________________________________________________
+//! Append an integer
+FormatBuffer& FormatBuffer::operator<<(Long_t value)
+{
+  if(mOs.bad()) return *this;
+  if(mByStream){
+    flush();
+    mOs << value;
+    return *this;
+  }
+  Char_t* end = FormatChars(mPos, mEnd, value);
+  if(!end){
+    flush();
+    end = FormatChars(mPos, mEnd, value);
+    if(!end){
+      mOs << value;
+      return *this;
+    }
+  }
+  mPos = end;
+  return *this;
+}
+
+//_____________________________________________________________________________
+//! Append an unsigned integer
+FormatBuffer& FormatBuffer::operator<<(ULong_t value)
+{
+  if(mOs.bad()) return *this;
+  if(mByStream){
+    flush();
+    mOs << value;
+    return *this;
+  }
+  Char_t* end = FormatChars(mPos, mEnd, value);
+  if(!end){
+    flush();
+    end = FormatChars(mPos, mEnd, value);
+    if(!end){
+      mOs << value;
+      return *this;
+    }
+  }
+  mPos = end;
+  return *this;
+}
+
+} // end namespace Blobb
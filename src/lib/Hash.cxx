@@ -0,0 +1,152 @@
+/** \file      src/lib/Hash.cxx
+    \brief     Source for content hashing helpers.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Hash.hh"  // these methods
+#include <cstring>        // cplusplus.com/reference/cstring/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// XXH64 primes
+static const ULong_t gPrime1 = 0x9E3779B185EBCA87ULL;  //!< XXH64 prime 1
+static const ULong_t gPrime2 = 0xC2B2AE3D27D4EB4FULL;  //!< XXH64 prime 2
+static const ULong_t gPrime3 = 0x165667B19E3779F9ULL;  //!< XXH64 prime 3
+static const ULong_t gPrime4 = 0x85EBCA77C2B2AE63ULL;  //!< XXH64 prime 4
+static const ULong_t gPrime5 = 0x27D4EB2F165667C5ULL;  //!< XXH64 prime 5
+
+//_____________________________________________________________________________
+//! Rotate left.
+static inline ULong_t RotL(ULong_t x, Int_t r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+//_____________________________________________________________________________
+//! Read 8 little-endian bytes.
+static inline ULong_t Read64(const Byte_t* p)
+{
+  return  ULong_t(p[0])        | (ULong_t(p[1]) <<  8) |
+         (ULong_t(p[2]) << 16) | (ULong_t(p[3]) << 24) |
+         (ULong_t(p[4]) << 32) | (ULong_t(p[5]) << 40) |
+         (ULong_t(p[6]) << 48) | (ULong_t(p[7]) << 56);
+}
+
+//_____________________________________________________________________________
+//! Read 4 little-endian bytes.
+static inline ULong_t Read32(const Byte_t* p)
+{
+  return  ULong_t(p[0])        | (ULong_t(p[1]) <<  8) |
+         (ULong_t(p[2]) << 16) | (ULong_t(p[3]) << 24);
+}
+
+//_____________________________________________________________________________
+//! Write 8 little-endian bytes.
+static inline void Write64(Byte_t* p, ULong_t v)
+{
+  for(Int_t i=0; i<8; i++) p[i] = Byte_t(v >> (8*i));
+}
+
+//_____________________________________________________________________________
+//! XXH64 accumulator round.
+static inline ULong_t Round(ULong_t acc, ULong_t input)
+{
+  acc += input * gPrime2;
+  acc  = RotL(acc, 31);
+  return acc * gPrime1;
+}
+
+//_____________________________________________________________________________
+//! XXH64 accumulator merge.
+static inline ULong_t MergeRound(ULong_t acc, ULong_t val)
+{
+  acc ^= Round(0, val);
+  return acc * gPrime1 + gPrime4;
+}
+
+//_____________________________________________________________________________
+/** 64-bit hash of a block of bytes (XXH64). */
+ULong_t Hash64(const void* data, ULong_t length, ULong_t seed)
+{
+  const Byte_t* p   = static_cast<const Byte_t*>(data);
+  const Byte_t* end = p + length;
+  ULong_t h;
+
+  // 32-byte stripes
+  if(length >= 32){
+    const Byte_t* limit = end - 32;
+    ULong_t v1 = seed + gPrime1 + gPrime2;
+    ULong_t v2 = seed + gPrime2;
+    ULong_t v3 = seed;
+    ULong_t v4 = seed - gPrime1;
+    do {
+      v1 = Round(v1, Read64(p));  p += 8;
+      v2 = Round(v2, Read64(p));  p += 8;
+      v3 = Round(v3, Read64(p));  p += 8;
+      v4 = Round(v4, Read64(p));  p += 8;
+    } while(p <= limit);
+    h = RotL(v1, 1) + RotL(v2, 7) + RotL(v3, 12) + RotL(v4, 18);
+    h = MergeRound(h, v1);
+    h = MergeRound(h, v2);
+    h = MergeRound(h, v3);
+    h = MergeRound(h, v4);
+  }
+  else
+    h = seed + gPrime5;
+  h += length;
+
+  // tail
+  for(; p + 8 <= end; p += 8){
+    h ^= Round(0, Read64(p));
+    h  = RotL(h, 27) * gPrime1 + gPrime4;
+  }
+  if(p + 4 <= end){
+    h ^= Read32(p) * gPrime1;
+    h  = RotL(h, 23) * gPrime2 + gPrime3;
+    p += 4;
+  }
+  for(; p < end; p++){
+    h ^= (*p) * gPrime5;
+    h  = RotL(h, 11) * gPrime1;
+  }
+
+  // avalanche
+  h ^= h >> 33;
+  h *= gPrime2;
+  h ^= h >> 29;
+  h *= gPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+//_____________________________________________________________________________
+/** Combine a hash (seed) with a 64-bit value. */
+ULong_t HashCombine(ULong_t seed, ULong_t value)
+{
+  Byte_t buf[8];
+  Write64(buf, value);
+  return Hash64(buf, 8, seed);
+}
+
+//_____________________________________________________________________________
+/** Combine a hash (seed) with a floating-point value.
+    Zeros (+0, -0) and NaNs are canonicalized before hashing.
+*/
+ULong_t HashDouble(ULong_t seed, Double_t value)
+{
+  ULong_t bits(0);
+  if(value != value)    bits = 0x7FF8000000000000ULL;
+  else if(value != 0.)  memcpy(&bits, &value, sizeof(bits));
+  return HashCombine(seed, bits);
+}
+
+//_____________________________________________________________________________
+/** Combine a hash (seed) with a string (length and characters). */
+ULong_t HashString(ULong_t seed, const string& value)
+{
+  return Hash64(value.data(), value.size(), HashCombine(seed, value.size()));
+}
+
+} // end namespace Blobb
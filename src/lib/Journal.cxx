@@ -0,0 +1,310 @@
+/** \file      src/lib/Journal.cxx
+    \brief     Source for Journal
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Journal.hh"        // this class
+#include "blobb/BloBB.hh"          // journaled state
+#include "blobb/Hash.hh"           // content hashing
+#include "blobb/SnapshotSaver.hh"  // file & directory sync
+#include "blobb/StringTools.hh"    // string tools
+#include "blobb/LogService.hh"     // logging
+#include <fstream>                 // cplusplus.com/reference/fstream/
+#include <sstream>                 // cplusplus.com/reference/sstream/
+
+#ifdef HAVE_UNISTD_H
+  #include <unistd.h>              // fsync
+#endif // end HAVE_UNISTD_H
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Format constants
+static const ULong_t gJnlHeaderSize = 5;        //!< type & payload length
+static const ULong_t gJnlCheckSize = 4;         //!< check
+static const ULong_t gJnlMaxPayload = 1 << 30;  //!< largest payload
+
+//_____________________________________________________________________________
+//! Append 4 little-endian bytes.
+static void Put32(string& s, UInt_t v)
+{
+  Char_t b[4] = {Char_t(v), Char_t(v >> 8), Char_t(v >> 16), Char_t(v >> 24)};
+  s.append(b, 4);
+}
+
+//_____________________________________________________________________________
+//! Read 4 little-endian bytes.
+static UInt_t Get32(CChar_t* p)
+{
+  const Byte_t* b = reinterpret_cast<const Byte_t*>(p);
+  return UInt_t(b[0]) | (UInt_t(b[1]) << 8) | (UInt_t(b[2]) << 16) | (UInt_t(b[3]) << 24);
+}
+
+//_____________________________________________________________________________
+//! Record check: XXH64, low 32 bits, of the payload seeded with the type.
+static UInt_t Check(Byte_t type, const string& payload)
+{
+  return UInt_t(Hash64(payload.data(), payload.size(), type));
+}
+
+//_____________________________________________________________________________
+//! Size of a file [bytes]; 0 if missing.
+static ULong_t FileSize(const string& fileName)
+{
+  std::ifstream ifs(fileName.c_str(), std::ios::binary | std::ios::ate);
+  return (ifs.is_open() ? ULong_t(ifs.tellg()) : 0);
+}
+
+//_____________________________________________________________________________
+/** Constructor. */
+Journal::Journal()
+  : mFileName(""),
+    mFile(0),
+    mBytes(0),
+    mBaseBytes(0),
+    mNumRecords(0),
+    mCompactSize(kDefCompactSize),
+    mCompactor(),
+    mCompactOk(kTrue),
+    mCompactBytes(0)
+{}
+
+//_____________________________________________________________________________
+/** Destructor; waits for compaction and closes the journal. */
+Journal::~Journal()
+{
+  close();
+}
+
+//_____________________________________________________________________________
+/** Open the journal of a base state file for appending.
+    A torn last record (e.g. from a crash) is cut off.
+    \return "success" boolean: true if opened. */
+Bool_t Journal::open(const string& fileName)
+{
+  close();
+  string jnl = JournalName(fileName);
+  Pos_t numRecords(0);
+  ULong_t valid = Scan(jnl, 0, numRecords);
+  ULong_t size = FileSize(jnl);
+  if(valid < size){
+    loutW(DataHandling) << "Journal::open: Dropping " << size - valid 
+			<< " bytes of torn records from '" << jnl << "'." << endl;
+    string prefix(valid, '\0');
+    std::ifstream ifs(jnl.c_str(), std::ios::binary);
+    ifs.read(&prefix[0], valid);
+    ifs.close();
+    std::ofstream ofs(jnl.c_str(), std::ios::binary | std::ios::trunc);
+    ofs.write(prefix.data(), prefix.size());
+  }
+  mFile = fopen(jnl.c_str(), "ab");
+  if(!mFile){
+    loutE(InputArguments) << "Journal::open: Failed to open journal '" << jnl << "'." << endl;
+    return kFalse;
+  }
+  mFileName   = fileName;
+  mBytes      = valid;
+  mBaseBytes  = FileSize(fileName);
+  mNumRecords = numRecords;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Wait for compaction, then sync & close the journal. */
+void Journal::close()
+{
+  wait();
+  if(!mFile) return;
+  sync();
+  fclose(mFile);
+  mFile = 0;
+}
+
+//_____________________________________________________________________________
+/** Record an added or modified warrior. */
+void Journal::putWarrior(const string& key, const Warrior& war)
+{
+  string payload;
+  Put32(payload, key.size());
+  payload += key;
+  std::ostringstream oss;
+  war.write(oss, kBinary);
+  payload += oss.str();
+  append(kWarriorRecord, payload);
+}
+
+//_____________________________________________________________________________
+/** Record the state of the random generator. */
+void Journal::putRandom(const Random& rnd)
+{
+  string payload;
+  Put32(payload, rnd.seed());
+  Put32(payload, rnd.numIter());
+  append(kRandomRecord, payload);
+}
+
+//_____________________________________________________________________________
+/** Write the records to disk (flush & fsync).
+    \return "success" boolean: true if written. */
+Bool_t Journal::sync()
+{
+  if(!mFile) return kFalse;
+  Bool_t ok = (fflush(mFile) == 0);
+#ifdef HAVE_UNISTD_H
+  ok = ok && (fsync(fileno(mFile)) == 0);
+#endif // end HAVE_UNISTD_H
+  if(!ok) loutE(DataHandling) << "Journal::sync: Failed to write journal of '" 
+			      << mFileName << "'." << endl;
+  return ok;
+}
+
+//_____________________________________________________________________________
+/** Start compaction: save a copy of the state as the new base, in the 
+    background, and start a fresh journal.
+    \return "success" boolean: true if started. */
+Bool_t Journal::compact(const BloBB& state)
+{
+  if(!mFile) return kFalse;
+  wait();
+  sync();
+  fclose(mFile);
+  mFile = 0;
+
+  // set the journal aside (appended to one left by a failed compaction)
+  string jnl = JournalName(mFileName);
+  string old = jnl + ".1";
+  if(FileSize(old) > 0){
+    std::ifstream ifs(jnl.c_str(), std::ios::binary);
+    std::ofstream ofs(old.c_str(), std::ios::binary | std::ios::app);
+    ofs << ifs.rdbuf();
+    ifs.close();
+    ofs.close();
+    remove(jnl.c_str());
+  }
+  else rename(jnl.c_str(), old.c_str());
+  mFile = fopen(jnl.c_str(), "ab");
+  mBytes = 0;
+  mNumRecords = 0;
+  if(!mFile){
+    loutE(InputArguments) << "Journal::compact: Failed to open journal '" << jnl << "'." << endl;
+    return kFalse;
+  }
+
+  // snapshot on this thread, save in the background
+  BloBB* snapshot = new BloBB(state, "");
+  snapshot->setEndTime(TimeStamp(-1));
+  string base = mFileName;
+  string tmp = GetFileDir(base) + GetFileBase(base) + ".compact" + GetFileExt(base);
+  mCompactOk = kFalse;
+  mCompactor = std::thread([this, snapshot, base, tmp, old](){
+      // the old journal goes only once the new base is on disk
+      Bool_t ok = snapshot->save(tmp) && SnapshotSaver::SyncFile(tmp) &&
+	rename(tmp.c_str(), base.c_str()) == 0 && SnapshotSaver::SyncDir(base);
+      if(ok){
+	remove(old.c_str());
+	mCompactBytes = FileSize(base);
+      }
+      else loutE(DataHandling) << "Journal::compact: Failed to compact '" << base 
+			       << "'; its journal is kept." << endl;
+      delete snapshot;
+      mCompactOk = ok;
+    });
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Wait for a running compaction.
+    \return "success" boolean: true if the last compaction succeeded. */
+Bool_t Journal::wait()
+{
+  if(!mCompactor.joinable()) return mCompactOk;
+  mCompactor.join();
+  if(mCompactOk) mBaseBytes = mCompactBytes;
+  return mCompactOk;
+}
+
+//_____________________________________________________________________________
+/** Apply the journal(s) of a base state file to a state loaded from it.
+    \return The number of records applied. */
+Pos_t Journal::Replay(const string& fileName, BloBB& blobb)
+{
+  string jnl = JournalName(fileName);
+  Pos_t numOld(0), num(0);
+  Scan(jnl + ".1", &blobb, numOld);
+  Scan(jnl, &blobb, num);
+  if(numOld + num > 0){
+    blobb.reindex();
+    loutI(DataHandling) << "Replayed " << numOld + num << " journal records of " 
+			<< fileName << endl;
+  }
+  return numOld + num;
+}
+
+//_____________________________________________________________________________
+/** Append a record. */
+void Journal::append(eRecord type, const string& payload)
+{
+  if(!mFile) return;
+  string record;
+  record.reserve(gJnlHeaderSize + payload.size() + gJnlCheckSize);
+  record += Char_t(type);
+  Put32(record, payload.size());
+  record += payload;
+  Put32(record, Check(type, payload));
+  if(fwrite(record.data(), 1, record.size(), mFile) != record.size()){
+    loutE(DataHandling) << "Journal: Failed to append to the journal of '" 
+			<< mFileName << "'." << endl;
+    return;
+  }
+  mBytes += record.size();
+  mNumRecords++;
+}
+
+//_____________________________________________________________________________
+/** Read the valid records of a journal file, applying them to blobb
+    (if given); stops at the first torn or corrupt record.
+    Only the last random generator record is applied.
+    \return The number of valid bytes. */
+ULong_t Journal::Scan(const string& jnlName, BloBB* blobb, Pos_t& numRecords)
+{
+  numRecords = 0;
+  std::ifstream ifs(jnlName.c_str(), std::ios::binary);
+  if(!ifs.is_open()) return 0;
+  ULong_t valid(0);
+  string payload;
+  UInt_t rndSeed(0), rndIter(0);
+  Bool_t hasRnd(kFalse);
+  while(kTrue){
+    Char_t header[gJnlHeaderSize], check[gJnlCheckSize];
+    if(!ifs.read(header, gJnlHeaderSize)) break;
+    Byte_t type = Byte_t(header[0]);
+    UInt_t length = Get32(header + 1);
+    if(length > gJnlMaxPayload) break;
+    payload.resize(length);
+    if(length > 0 && !ifs.read(&payload[0], length)) break;
+    if(!ifs.read(check, gJnlCheckSize) || Get32(check) != Check(type, payload)) break;
+    // apply
+    if(blobb && type == kWarriorRecord && length >= 4){
+      UInt_t keyLength = Get32(payload.data());
+      if(4 + keyLength > length) break;
+      std::istringstream iss(payload.substr(4 + keyLength));
+      Warrior war;
+      try{ war.read(iss, kBinary); }
+      catch(std::exception&){ break; }
+      blobb->warriors()[payload.substr(4, keyLength)] = war;
+    }
+    else if(blobb && type == kRandomRecord && length == 8){
+      rndSeed = Get32(payload.data());
+      rndIter = Get32(payload.data() + 4);
+      hasRnd = kTrue;
+    }
+    valid += gJnlHeaderSize + length + gJnlCheckSize;
+    numRecords++;
+  }
+  // re-seeding iterates the generator: once, for the last record
+  if(hasRnd) blobb->setRandom(Random(rndSeed, rndIter));
+  return valid;
+}
+
+} // end namespace Blobb
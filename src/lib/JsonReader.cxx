@@ -0,0 +1,344 @@
+/** \file      src/lib/JsonReader.cxx
+    \brief     Source for JsonReader
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/JsonReader.hh"       // this class
+#include "blobb/LogService.hh"       // logging
+#include <cereal/archives/json.hpp>  // cereal JSON archive (& rapidjson reader)
+#include <fstream>                   // cplusplus.com/reference/fstream/
+#include <sstream>                   // cplusplus.com/reference/sstream/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** \struct JsonSource_t
+    \brief Buffered input shared by (copies of) a JsonStream. */
+struct JsonSource_t {
+  istream&       is;      //!< input stream
+  vector<Char_t> buffer;  //!< read buffer
+  CChar_t*       cur;     //!< next character
+  CChar_t*       end;     //!< end of the read characters
+  ULong_t        offset;  //!< stream offset of the buffer start
+
+  //! Constructor.
+  JsonSource_t(istream& i, ULong_t size)
+    : is(i), buffer(size), cur(&buffer[0]), end(&buffer[0]), offset(0) {}
+  //! Refill the buffer; false at the end of the stream.
+  Bool_t fill()
+  {
+    offset += end - &buffer[0];
+    is.read(&buffer[0], buffer.size());
+    cur = &buffer[0];
+    end = cur + is.gcount();
+    return cur < end;
+  }
+};
+
+//_____________________________________________________________________________
+/** \class JsonStream
+    \brief rapidjson input stream over a JsonSource_t.
+    rapidjson copies streams for local use; all copies share the source. */
+class JsonStream {
+public:
+  typedef Char_t Ch;  //!< character type
+  //! Constructor.
+  JsonStream(JsonSource_t& src) : mSrc(&src) {}
+  //! Next character, '\0' at the end.
+  inline Ch Peek() const
+  { return (mSrc->cur < mSrc->end || mSrc->fill()) ? *mSrc->cur : '\0'; }
+  //! Take the next character, '\0' at the end.
+  inline Ch Take()
+  { Ch c = Peek(); if(mSrc->cur < mSrc->end) ++mSrc->cur; return c; }
+  //! Offset of the next character.
+  inline size_t Tell() const
+  { return mSrc->offset + (mSrc->cur - &mSrc->buffer[0]); }
+  // output: not implemented
+  void Put(Ch)       { RAPIDJSON_ASSERT(false); }
+  void Flush()       { RAPIDJSON_ASSERT(false); }
+  Ch* PutBegin()     { RAPIDJSON_ASSERT(false); return 0; }
+  size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+private:
+  JsonSource_t* mSrc;  //!< shared source
+};
+
+//_____________________________________________________________________________
+//! Thrown by the handler when the filter stops parsing.
+struct JsonStop_t {};
+
+//_____________________________________________________________________________
+//! Warrior parameters, by name.
+static const std::pair<CChar_t*, Parameter Warrior::*> gJsonParams[] =
+  {
+    {"Prowess",      &Warrior::mProwess},
+    {"Agility",      &Warrior::mAgility},
+    {"Intelligence", &Warrior::mIntelligence},
+    {"Personality",  &Warrior::mPersonality},
+    {"Health",       &Warrior::mHealth},
+    {"Fatigue",      &Warrior::mFatigue},
+    {"Stun",         &Warrior::mStun},
+    {"Disarm",       &Warrior::mDisarm},
+    {"Fallen",       &Warrior::mFallen},
+    {"FatigueTime",  &Warrior::mFatigueTime},
+    {"HealthTime",   &Warrior::mHealthTime}
+  };
+
+//_____________________________________________________________________________
+/** \class JsonHandler
+    \brief rapidjson SAX handler for the cereal layout of a BloBB.
+
+    Depth (number of open containers) of the values handled:
+    - 2: BloBB (StartTime, EndTime); 3: BloBB Named, Random,
+    - 4: Warriors element (key); 5: element value (the Warrior),
+    - 6: Warrior Named & Parameter's; 7: Parameter Named.
+*/
+class JsonHandler : public rapidjson::BaseReaderHandler<> {
+public:
+  //! Constructor.
+  JsonHandler(BloBB& blobb, const JsonReader::Filter_t& filter)
+    : mBlobb(blobb), mFilter(filter), mLevels(), mKey(""),
+      mSeed(0), mNumIter(0), mWar(), mWarKey(""), mParam(0), mNumParsed(0)
+  {}
+
+  //! Number of warriors parsed
+  inline Pos_t numParsed() const { return mNumParsed; }
+
+  // values
+  void Null_()             { key(); }
+  void Bool_(bool)         { key(); }
+  void Int(int i)          { number(i); }
+  void Uint(unsigned i)    { number(i); }
+  void Int64(int64_t i)    { number(Double_t(i)); }
+  void Uint64(uint64_t i)  { number(Double_t(i)); }
+  void Double(double d)    { number(d); }
+  //! String value or object key
+  void String(CChar_t* str, rapidjson::SizeType length, bool)
+  {
+    if(!mLevels.empty() && mLevels.back().isObject && mLevels.back().expectKey){
+      mKey.assign(str, length);
+      mLevels.back().expectKey = kFalse;
+      return;
+    }
+    const string& k = key();
+    string val(str, length);
+    switch(mLevels.size()){
+    case 2:
+      if(k == "StartTime")    mBlobb.setStartTime(TimeStamp(val));
+      else if(k == "EndTime") mBlobb.setEndTime(TimeStamp(val));
+      break;
+    case 3:
+      if(mLevels[2].name == "Named"){
+	if(k == "Name")       mBlobb.setName(val);
+	else if(k == "Title") mBlobb.setTitle(val);
+      }
+      break;
+    case 4:
+      if(k == "key") mWarKey = val;
+      break;
+    case 6:
+      if(!mParam){
+	if(k == "Name")       mWar.setName(val);
+	else if(k == "Title") mWar.setTitle(val);
+      }
+      break;
+    case 7:
+      if(mParam){
+	if(k == "Name")       mParam->setName(val);
+	else if(k == "Title") mParam->setTitle(val);
+      }
+      break;
+    }
+  }
+
+  // containers
+  //! Start object
+  void StartObject()
+  {
+    Level_t level = {key(), kTrue, kTrue};
+    mLevels.push_back(level);
+    if(mLevels.size() == 4){
+      mWar = Warrior();
+      mWarKey = "";
+    }
+    else if(mLevels.size() == 6){
+      mParam = 0;
+      for(UInt_t p=0; p<sizeof(gJsonParams)/sizeof(gJsonParams[0]); p++)
+	if(level.name == gJsonParams[p].first){ mParam = &(mWar.*gJsonParams[p].second); break; }
+    }
+  }
+  //! End object
+  void EndObject(rapidjson::SizeType)
+  {
+    if(mLevels.size() == 3 && mLevels[2].name == "Random")
+      mBlobb.setRandom(Random(mSeed, mNumIter));
+    else if(mLevels.size() == 6)
+      mParam = 0;
+    else if(mLevels.size() == 4)
+      finishWarrior();
+    mLevels.pop_back();
+  }
+  //! Start array
+  void StartArray()
+  {
+    Level_t level = {key(), kFalse, kFalse};
+    mLevels.push_back(level);
+  }
+  //! End array
+  void EndArray(rapidjson::SizeType)
+  {
+    mLevels.pop_back();
+  }
+
+private:
+  /** \struct Level_t
+      \brief Open container. */
+  struct Level_t {
+    string name;       //!< key of the container in its parent
+    Bool_t isObject;   //!< object (true) or array (false)
+    Bool_t expectKey;  //!< next string is a key
+  };
+
+  //! Key of the current value (empty in arrays); the next string is a key again.
+  const string& key()
+  {
+    static const string gNoKey("");
+    if(mLevels.empty() || !mLevels.back().isObject) return gNoKey;
+    mLevels.back().expectKey = kTrue;
+    return mKey;
+  }
+
+  //! Numeric value
+  void number(Double_t val)
+  {
+    const string& k = key();
+    switch(mLevels.size()){
+    case 3:
+      if(mLevels[2].name == "Random"){
+	if(k == "Seed")         mSeed = UInt_t(val);
+	else if(k == "NumIter") mNumIter = UInt_t(val);
+      }
+      break;
+    case 6:
+      if(mParam){
+	if(k == "Value")      mParam->setValue(val);
+	else if(k == "Error") mParam->setError(val);
+	else if(k == "Min")   mParam->setMin(val);
+	else if(k == "Max")   mParam->setMax(val);
+      }
+      break;
+    }
+  }
+
+  //! Filter & store the parsed warrior
+  void finishWarrior()
+  {
+    mNumParsed++;
+    JsonReader::eFilter f = (mFilter ? mFilter(mWarKey, mWar) : JsonReader::kKeep);
+    if(f != JsonReader::kSkip){
+      Warriors_t& wars = mBlobb.warriors();
+      wars.emplace_hint(wars.end(), mWarKey, mWar);
+    }
+    if(f == JsonReader::kStop) throw JsonStop_t();
+  }
+
+private:
+  BloBB&                       mBlobb;      //!< state filled
+  const JsonReader::Filter_t&  mFilter;     //!< warrior filter
+  vector<Level_t>              mLevels;     //!< open containers
+  string                       mKey;        //!< last object key
+  UInt_t                       mSeed;       //!< random seed
+  UInt_t                       mNumIter;    //!< random iterations
+  Warrior                      mWar;        //!< warrior being parsed
+  string                       mWarKey;     //!< its registered name
+  Parameter*                   mParam;      //!< parameter being parsed
+  Pos_t                        mNumParsed;  //!< warriors parsed
+};
+
+//_____________________________________________________________________________
+/** Constructor. */
+JsonReader::JsonReader(const Filter_t& filter, ULong_t domSize)
+  : mFilter(filter),
+    mDomSize(domSize),
+    mNumParsed(0),
+    mStopped(kFalse)
+{}
+
+//_____________________________________________________________________________
+/** Load a state from a JSON file.
+    Files smaller than domSize(), when there is no filter, are loaded
+    with BloBB::load (cereal).
+    \return "success" boolean: true if successfully loaded (or stopped). */
+Bool_t JsonReader::load(const string& fileName, BloBB& blobb)
+{
+  std::ifstream ifs(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if(!ifs.is_open()){
+    loutE(InputArguments) << "JsonReader::load: Failed to open file '" << fileName
+			  << "', no data loaded." << endl;
+    return kFalse;
+  }
+  ULong_t size = ifs.tellg();
+  ifs.seekg(0);
+
+  // small: DOM
+  if(!mFilter && size < mDomSize){
+    ifs.close();
+    mStopped = kFalse;
+    if(!blobb.load(fileName)) return kFalse;
+    mNumParsed = blobb.warriors().size();
+    return kTrue;
+  }
+
+  // large: SAX
+  try{
+    loutI(DataHandling) << "Streaming file " << fileName << endl;
+    read(ifs, blobb);
+  }
+  catch(std::exception& e){
+    loutE(InputArguments) << "JsonReader::load: Failed to read file '" << fileName
+			  << "'; " << e.what() << endl;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Read a state from a JSON stream, warrior by warrior.
+    \warning Throws Exception on parse errors. */
+void JsonReader::read(istream& is, BloBB& blobb)
+{
+  blobb.clear();
+  mNumParsed = 0;
+  mStopped = kFalse;
+
+  JsonSource_t src(is, kDefBufferSize);
+  JsonStream stream(src);
+  JsonHandler handler(blobb, mFilter);
+  rapidjson::Reader reader;
+  Bool_t ok(kTrue);
+  try{ ok = reader.Parse<rapidjson::kParseDefaultFlags>(stream, handler); }
+  catch(const JsonStop_t&){ mStopped = kTrue; }
+  mNumParsed = handler.numParsed();
+  blobb.reindex();
+  if(!ok){
+    std::stringstream ss;
+    ss << "JsonReader::read: " << reader.GetParseError()
+       << " (offset " << reader.GetErrorOffset() << ")";
+    throw Exception(ss.str());
+  }
+}
+
+//_____________________________________________________________________________
+/** Load the single warrior registered as key; parsing stops once found.
+    \return true if found. */
+Bool_t JsonReader::LoadWarrior(const string& fileName, const string& key, Warrior& war)
+{
+  JsonReader reader([&key](const string& k, const Warrior&)
+		    { return (k == key ? kStop : kSkip); });
+  BloBB blobb;
+  if(!reader.load(fileName, blobb) || !reader.stopped()) return kFalse;
+  war = blobb.warrior(key);
+  return kTrue;
+}
+
+} // end namespace Blobb
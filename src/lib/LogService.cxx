@@ -5,10 +5,19 @@
     \copyright See License.txt
 */
 #include "blobb/LogService.hh"  // these methods
+#include "blobb/BinaryLog.hh"   // binary log records
 #include "blobb/Common.hh"      // common includes
 #include "blobb/Exception.hh"   // exception handler
+#include "blobb/SharedOutput.hh"  // line-atomic writes
+#include <atomic>               // cplusplus.com/reference/atomic/
+#include <cctype>               // cplusplus.com/reference/cctype/
+#include <chrono>               // cplusplus.com/reference/chrono/
+#include <cstdlib>              // cplusplus.com/reference/cstdlib/
 #include <fstream>              // cplusplus.com/reference/ofstream/
-#include <map>                  // cplusplus.com/reference/map/
+#include <memory>               // cplusplus.com/reference/memory/
+#include <sstream>              // cplusplus.com/reference/sstream/
+#include <streambuf>            // cplusplus.com/reference/streambuf/
+#include <thread>               // cplusplus.com/reference/thread/
 using std::cout;
 using std::clog;
 using std::cerr;
@@ -25,95 +34,89 @@ namespace Blobb {
 #endif
 
 //_____________________________________________________________________________
-//! Prefix for log messages.
-static string gLogPrefix = "\x1b[1;41m[BloBB]\x1b[m \x1b[1;31m\xE2\x9E\xB3\x1b[m ";
-// static string gLogPrefix = "BloBB";
+//! Process-wide log configuration: level, topic mask & prefix.
+LogConfig gLogConfig = 
+  {kInfo, kAllLogTopics, "\x1b[1;41m[BloBB]\x1b[m \x1b[1;31m\xE2\x9E\xB3\x1b[m "};
+// {kInfo, kAllLogTopics, "BloBB"};
 
 //_____________________________________________________________________________
-/** Set the prefix for log messages. */
-void SetLogPrefix(const char* prefix)
+//! Log configuration of the thread: its LogContext, if any, else gLogConfig.
+thread_local LogConfig* gThreadLogConfig = &gLogConfig;
+
+//_____________________________________________________________________________
+/** Constructor: the calling thread's current configuration is copied
+    and used by the thread until destruction. */
+LogContext::LogContext()
+  : mConfig(*gThreadLogConfig),
+    mPrevious(gThreadLogConfig)
 {
-  string spre(prefix);
-  gLogPrefix = spre;
+  gThreadLogConfig = &mConfig;
 }
 
 //_____________________________________________________________________________
-//! Global logging level.
-static eLogLevel gLogLevel = kInfo;
+/** Destructor: the thread's previous configuration is restored. */
+LogContext::~LogContext()
+{
+  gThreadLogConfig = mPrevious;
+}
+
+//_____________________________________________________________________________
+/** Set the prefix for log messages (of the thread's configuration). */
+void SetLogPrefix(const char* prefix)
+{
+  string spre(prefix);
+  gThreadLogConfig->prefix = spre;
+}
 
 //_____________________________________________________________________________
-/** Set the log level. */
+/** Set the log level (of the thread's configuration). */
 void SetLogLevel(eLogLevel level)
 {
-  gLogLevel = level;
+  gThreadLogConfig->level = level;
 }
 
 //_____________________________________________________________________________
-/** Get the log level. */
+/** Get the log level (of the thread's configuration). */
 eLogLevel GetLogLevel()
 {
-  return gLogLevel;
+  return gThreadLogConfig->level;
 }
 
 //_____________________________________________________________________________
-//! Message level names.
-static std::map<eLogLevel,string> gLevelNames = 
-  {
-    {kDebug,    "Debug"},
-    {kInfo,     "Info"},
-    {kProgress, "Progress"},
-    {kWarning,  "Warning"},
-    {kError,    "Error"},
-    {kFatal,    "Fatal"},
-    {kSilent,   "Silent"}
-  };
+//! Message level names, indexed by level+1 (kSilent first).
+static const char* const gLevelNames[] = 
+  {"Silent", "Fatal", "Error", "Warning", "Progress", "Info", "Debug"};
 
-//! Message topic names.
 //_____________________________________________________________________________
-static std::map<eLogTopic,string> gTopicNames = 
-  {
-    {None,           "None"},
-    {InputArguments, "InputArguments"},
-    {Evaluation,     "Evaluation"},
-    {ObjectHandling, "ObjectHandling"},
-    {DataHandling,   "DataHandling"},
-    {Plotting,       "Plotting"}
-  };
+//! Message topic names, indexed by bit of the topic (None first).
+static const char* const gTopicNames[] = 
+  {"None", "InputArguments", "Evaluation", "ObjectHandling", "DataHandling", "Plotting"};
 
+//_____________________________________________________________________________
+/** Name of a log level. */
+const char* LogLevelName(eLogLevel level)
+{
+  return gLevelNames[level - kSilent];
+}
 
-// //_____________________________________________________________________________
-// /** Initialize the algorithm enumerated value-maps. */
-// void InitLogDefs()
-// {
-//   if(gLevelNames.size() == 0){
-//     gLevelNames[kDebug]    = "Debug";    
-//     gLevelNames[kInfo]     = "Info";    
-//     gLevelNames[kProgress] = "Progress";
-//     gLevelNames[kWarning]  = "Warning";    
-//     gLevelNames[kError]    = "Error";    
-//     gLevelNames[kFatal]    = "Fatal";    
-//     gLevelNames[kSilent]   = "Silent";    
-//   }
-//   if(gTopicNames.size() == 0){
-//     gTopicNames[None]           = " ";
-//     gTopicNames[InputArguments] = "InputArguments";
-//     gTopicNames[Evaluation]     = "Evaluation";
-//     gTopicNames[ObjectHandling] = "ObjectHandling";
-//     gTopicNames[DataHandling]   = "DataHandling";
-//   }
-// }
+//_____________________________________________________________________________
+/** Name of a log topic. */
+const char* LogTopicName(eLogTopic topic)
+{
+  Int_t bit(0);
+  for(UInt_t t = topic; t > 1; t >>= 1) bit++;
+  return gTopicNames[bit];
+}
 
 //_____________________________________________________________________________
 /** Get an log-level enumerated value from the name string. */
 eLogLevel LogLevel(const char* name)
 {
   string sname(name);
-  // map iterator
-  std::map<eLogLevel,string>::const_iterator it = gLevelNames.begin();
-  // loop to find value and return key
-  for(it = gLevelNames.begin(); it != gLevelNames.end(); ++it)
-    if(it->second == sname)
-      return it->first;
+  // loop to find name and return level
+  for(Int_t l = kSilent; l <= kDebug; l++)
+    if(sname == LogLevelName(eLogLevel(l)))
+      return eLogLevel(l);
   // value not found
   throw Exception("LogLevel: Unknown log-level '" + sname + 
 		  "', choose from: Debug, Info, Progress, Warning, Error, Fatal, Silent.");
@@ -136,36 +139,436 @@ eLogLevel IntToLogLevel(Int_t val)
   }
 }
 
+//_____________________________________________________________________________
+/** Set the log topic mask (of the thread's configuration): an OR of
+    eLogTopic values. Messages less severe than warnings are only logged
+    for the topics in the mask. */
+void SetLogTopics(UInt_t mask)
+{
+  gThreadLogConfig->topics = mask;
+}
+
+//_____________________________________________________________________________
+/** Get the log topic mask (of the thread's configuration). */
+UInt_t GetLogTopics()
+{
+  return gThreadLogConfig->topics;
+}
+
+//_____________________________________________________________________________
+/** Get a log topic mask from a comma-separated list of topic names (or
+    "All"), or from a number, e.g. "Evaluation,Plotting" or 36.
+    \warning Throws Exception for unknown names. */
+UInt_t LogTopics(const char* names)
+{
+  string snames(names);
+  if(snames != "" && isdigit((unsigned char)snames[0])) return UInt_t(strtoul(names, 0, 0));
+  UInt_t mask(0);
+  std::istringstream iss(snames);
+  string sname;
+  while(std::getline(iss, sname, ',')){
+    if(sname == "All"){
+      mask |= kAllLogTopics;
+      continue;
+    }
+    UInt_t topic(1);
+    while(topic <= Plotting && sname != LogTopicName(eLogTopic(topic))) topic <<= 1;
+    if(topic > Plotting)
+      throw Exception("LogTopics: Unknown log-topic '" + sname + "', choose from: All, None, "
+		      "InputArguments, Evaluation, ObjectHandling, DataHandling, Plotting.");
+    mask |= topic;
+  }
+  return mask;
+}
+
+//_____________________________________________________________________________
+//! Stream of the messages of a level.
+static ostream& LevelStream(eLogLevel level)
+{
+  switch(level){
+  case kDebug:    return clog;
+  case kInfo:     return clog;
+  case kProgress: return clog;
+  case kWarning:  return cerr;
+  case kError:    return cerr;
+  case kFatal:    return cerr;
+  default:        return cout;
+  }
+}
+
+/** \class LogRing
+    \brief Bounded lock-free multi-producer, single-consumer ring of log
+    records (after D. Vyukov's bounded queue).
+
+    Each cell has a sequence number: a producer claims the cell at the
+    enqueue position when its sequence equals the position, fills it and
+    publishes it (position+1); the consumer takes it back the same way.
+    Record texts are swapped in & out, so their buffers are reused.
+*/
+class LogRing {
+public:
+  //! Constructor; the capacity is rounded up to a power of 2
+  explicit LogRing(ULong_t capacity)
+    : mMask(0), mCells(), mEnqueue(0), mDequeue(0)
+  {
+    ULong_t size(2);
+    while(size < capacity) size <<= 1;
+    mMask = size - 1;
+    mCells.reset(new Cell_t[size]);
+    for(ULong_t i=0; i<size; i++) mCells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  //! Push a record (any thread); text is swapped with a free buffer
+  //! \return "success" boolean: false if the ring is full.
+  Bool_t push(eLogLevel level, string& text)
+  {
+    ULong_t pos = mEnqueue.load(std::memory_order_relaxed);
+    Cell_t* cell;
+    while(kTrue){
+      cell = &mCells[pos & mMask];
+      ULong_t seq = cell->seq.load(std::memory_order_acquire);
+      Long_t diff = Long_t(seq) - Long_t(pos);
+      if(diff == 0){
+	if(mEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      }
+      else if(diff < 0) return kFalse;
+      else pos = mEnqueue.load(std::memory_order_relaxed);
+    }
+    cell->level = level;
+    cell->text.swap(text);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return kTrue;
+  }
+
+  //! Pop a record (consumer thread only); text is swapped in
+  //! \return "success" boolean: false if the ring is empty.
+  Bool_t pop(eLogLevel& level, string& text)
+  {
+    ULong_t pos = mDequeue.load(std::memory_order_relaxed);
+    Cell_t& cell = mCells[pos & mMask];
+    if(cell.seq.load(std::memory_order_acquire) != pos + 1) return kFalse;
+    level = cell.level;
+    text.swap(cell.text);
+    cell.seq.store(pos + mMask + 1, std::memory_order_release);
+    mDequeue.store(pos + 1, std::memory_order_release);
+    return kTrue;
+  }
+
+  //! Number of records taken by the consumer
+  inline ULong_t numPopped() const { return mDequeue.load(std::memory_order_acquire); }
+  //! Number of records claimed by producers
+  inline ULong_t numPushed() const { return mEnqueue.load(std::memory_order_acquire); }
+
+private:
+  /** \struct Cell_t
+      \brief Record slot. */
+  struct Cell_t {
+    std::atomic<ULong_t> seq;    //!< sequence number
+    eLogLevel            level;  //!< message level
+    string               text;   //!< message text
+  };
+  ULong_t                   mMask;     //!< capacity - 1
+  std::unique_ptr<Cell_t[]> mCells;    //!< cells
+  std::atomic<ULong_t>      mEnqueue;  //!< next position to fill
+  std::atomic<ULong_t>      mDequeue;  //!< next position to take
+};
+
+/** \class AsyncLog
+    \brief Background writer of the asynchronous logging backend.
+
+    Records pushed to the ring are written by one thread to the level's
+    stream (clog/cerr) or to a file; the output is flushed whenever the
+    ring runs empty. Stopped, and the ring drained, by StopAsyncLog or
+    at exit.
+*/
+class AsyncLog {
+public:
+  //! Constructor; starts the writer thread
+  AsyncLog(eLogOverflow overflow, ULong_t capacity, const string& fileName)
+    : mRing(capacity), mOverflow(overflow), mFile(), mStop(kFalse),
+      mNumWritten(0), mNumDropped(0), mThread()
+  {
+    if(fileName != ""){
+      mFile.open(fileName.c_str(), std::ios::app);
+      if(!mFile.is_open())
+	throw Exception("StartAsyncLog: Cannot open log file '" + fileName + "'.");
+    }
+    mThread = std::thread(&AsyncLog::write, this);
+  }
+
+  //! Destructor; drains the ring & stops the writer thread
+  ~AsyncLog()
+  {
+    mStop.store(kTrue, std::memory_order_release);
+    mThread.join();
+  }
+
+  //! Push a record
+  //! \return "success" boolean: false if dropped.
+  Bool_t push(eLogLevel level, string& text)
+  {
+    while(!mRing.push(level, text)){
+      if(mOverflow == kLogDrop){ mNumDropped++; return kFalse; }
+      std::this_thread::yield();
+    }
+    return kTrue;
+  }
+
+  //! Wait until the records pushed so far are written
+  void flush() const
+  {
+    ULong_t pushed = mRing.numPushed();
+    while(mNumWritten.load(std::memory_order_acquire) < pushed) std::this_thread::yield();
+  }
+
+  //! Number of records dropped
+  inline ULong_t numDropped() const { return mNumDropped.load(); }
+
+private:
+  //! Writer thread: write records, in batches of up to 64 kB, until
+  //! stopped & drained
+  void write()
+  {
+    eLogLevel level;
+    string text, batch;
+    batch.reserve(1 << 16);
+    ostream* last(0);
+    UInt_t idle(0);
+    while(kTrue){
+      if(mRing.pop(level, text)){
+	ostream* os = (mFile.is_open() ? &mFile : &LevelStream(level));
+	if(last != os || batch.size() + text.size() > batch.capacity()) drain(last, batch);
+	batch += text;
+	last = os;
+	text.clear();
+	idle = 0;
+	continue;
+      }
+      // ring empty: write, then back off
+      drain(last, batch);
+      if(mStop.load(std::memory_order_acquire) && mRing.numPopped() == mRing.numPushed()) break;
+      if(++idle < 64) std::this_thread::yield();
+      else std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  }
+
+  //! Write & flush a batch of records
+  void drain(ostream* os, string& batch)
+  {
+    if(os && batch != ""){
+      os->write(batch.data(), batch.size());
+      os->flush();
+    }
+    batch.clear();
+    mNumWritten.store(mRing.numPopped(), std::memory_order_release);
+  }
+
+private:
+  LogRing              mRing;        //!< record ring
+  eLogOverflow         mOverflow;    //!< full-ring policy
+  std::ofstream        mFile;        //!< log file, if any
+  std::atomic<Bool_t>  mStop;        //!< stop requested
+  std::atomic<ULong_t> mNumWritten;  //!< records written
+  std::atomic<ULong_t> mNumDropped;  //!< records dropped
+  std::thread          mThread;      //!< writer thread
+};
+
+//_____________________________________________________________________________
+//! Asynchronous backend (0: synchronous).
+static std::unique_ptr<AsyncLog> gAsyncLogOwner;
+//! Asynchronous backend, as seen by the producers.
+static std::atomic<AsyncLog*> gAsyncLog(0);
+//! Threads using the backend (see AsyncLogUse); outside of it, so it
+//! is counted before the backend is even loaded.
+static std::atomic<UInt_t> gAsyncLogUsers(0);
+//! Stops the asynchronous backend at exit (destroyed before the above).
+static struct AsyncLogGuard { ~AsyncLogGuard(){ StopAsyncLog(); } } gAsyncLogGuard;
+
+/** \struct AsyncLogUse
+    \brief Use of the asynchronous backend by a thread, in a scope: the
+    user is counted before the backend is loaded, so StopAsyncLog, which
+    unpublishes the backend and then waits for the count to drop to 0,
+    cannot delete a backend still in use. */
+struct AsyncLogUse {
+  //! Constructor; counts the user, then loads the backend (0: none)
+  AsyncLogUse() : async(0) { gAsyncLogUsers++; async = gAsyncLog.load(); }
+  //! Destructor
+  ~AsyncLogUse(){ gAsyncLogUsers--; }
+  AsyncLog* async;  //!< backend, valid in the scope
+};
+
+//_____________________________________________________________________________
+/** Hand a formatted message to the asynchronous backend, if running,
+    else write it to the level's stream in one piece. */
+static void LogText(eLogLevel level, string& text)
+{
+  {
+    AsyncLogUse use;
+    if(use.async){
+      use.async->push(level, text);
+      text.clear();
+      return;
+    }
+  }
+  WriteShared(LevelStream(level), text.data(), text.size());
+  text.clear();
+}
+
+/** \class LogRecordBuffer
+    \brief Thread-local buffer formatting one log message; the message is
+    handed to the binary log, to the asynchronous backend or to the
+    level's stream when the stream is flushed (endl), so messages of
+    concurrent threads are not interleaved.
+*/
+class LogRecordBuffer : public std::streambuf {
+public:
+  //! Constructor
+  LogRecordBuffer() : mLevel(kInfo), mTopic(None), mText() { mText.reserve(256); }
+  //! Destructor; a pending (unflushed) message is sent
+  virtual ~LogRecordBuffer(){ send(); }
+
+  //! Start a message; a pending (unflushed) one is sent first
+  void start(eLogLevel level, eLogTopic topic)
+  {
+    send();
+    mLevel = level;
+    mTopic = topic;
+  }
+
+protected:
+  //! Append a character
+  virtual int_type overflow(int_type c)
+  {
+    if(!traits_type::eq_int_type(c, traits_type::eof())) mText += traits_type::to_char_type(c);
+    return traits_type::not_eof(c);
+  }
+  //! Append n characters
+  virtual std::streamsize xsputn(const char_type* s, std::streamsize n)
+  {
+    mText.append(s, n);
+    return n;
+  }
+  //! Send the message
+  virtual int sync()
+  {
+    send();
+    return 0;
+  }
+
+private:
+  //! Send the message, if any
+  void send()
+  {
+    if(mText == "") return;
+    if(IsBinaryLog()){
+      LogBinaryText(mLevel, mTopic, mText);
+      mText.clear();
+    }
+    else LogText(mLevel, mText);
+  }
+
+private:
+  eLogLevel mLevel;  //!< message level
+  eLogTopic mTopic;  //!< message topic
+  string    mText;   //!< message text
+};
+
+//_____________________________________________________________________________
+/** \struct LogRecordStream
+    \brief Thread-local stream of log messages. */
+struct LogRecordStream {
+  LogRecordBuffer buffer;  //!< message buffer
+  ostream         os;      //!< stream on the buffer
+  //! Constructor
+  LogRecordStream() : buffer(), os(&buffer) { }
+};
+
+//_____________________________________________________________________________
+//! The thread's log message stream.
+static LogRecordStream& ThreadRecord()
+{
+  static thread_local LogRecordStream record;
+  return record;
+}
+
+//_____________________________________________________________________________
+/** Start the asynchronous backend: Log() then formats each message into
+    a thread-local buffer, and a background thread writes it. A running
+    backend is stopped first.
+    \param overflow What to do with a message while the ring is full.
+    \param capacity Number of messages held by the ring.
+    \param fileName Log file, appended; empty: the levels' streams.
+    \warning Throws Exception if the file cannot be opened. */
+void StartAsyncLog(eLogOverflow overflow, ULong_t capacity, const string& fileName)
+{
+  StopAsyncLog();
+  gAsyncLogOwner.reset(new AsyncLog(overflow, capacity, fileName));
+  gAsyncLog.store(gAsyncLogOwner.get(), std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+/** Stop the asynchronous backend, after writing its pending messages;
+    Log() writes directly to the streams again. */
+void StopAsyncLog()
+{
+  AsyncLog* async = gAsyncLog.exchange(0);
+  if(!async) return;
+  // users that loaded the backend were counted before the exchange
+  while(gAsyncLogUsers.load() > 0) std::this_thread::yield();
+  gAsyncLogOwner.reset();
+}
+
+//_____________________________________________________________________________
+/** Is the asynchronous backend running? */
+Bool_t IsAsyncLog()
+{
+  return gAsyncLog.load(std::memory_order_acquire) != 0;
+}
+
+//_____________________________________________________________________________
+/** Wait until the messages logged so far are written; a pending
+    (unflushed) message of the calling thread is sent first. */
+void FlushLog()
+{
+  ThreadRecord().os.flush();
+  AsyncLogUse use;
+  if(use.async) use.async->flush();
+  else{ clog.flush(); cerr.flush(); }
+}
+
+//_____________________________________________________________________________
+/** Number of messages dropped by the running asynchronous backend. */
+ULong_t GetLogDropped()
+{
+  AsyncLogUse use;
+  return (use.async ? use.async->numDropped() : 0);
+}
+
 //_____________________________________________________________________________
 /** Log a message to a stream. 
+    The stream is thread-local; the message is sent by endl (or flush),
+    or when the thread's next message is started.
     \return C++ std::ostream associated with given message configuration
 */
 ostream& Log(eLogLevel level, eLogTopic topic, Bool_t skipPrefix)
 {
   // the stream
   std::ostream* os;
-  // check global level
-  if(level > gLogLevel && gDevNull.is_open()) 
+  // check global level & topics
+  if(!LogEnabled(level, topic) && gDevNull.is_open()) 
     os = &gDevNull;
   else {
-    // assign the stream
-    switch(level){
-    case kDebug:    os = &clog; break;
-    case kInfo:     os = &clog; break;
-    case kProgress: os = &clog; break;
-    case kWarning:  os = &cerr; break;
-    case kError:    os = &cerr; break;
-    case kFatal:    os = &cerr; break;
-    default:        os = &cout; break;
-    }
-
-    // Flush any previous messages
-    (*os).flush();
+    // assign the stream; any previous message is sent
+    LogRecordStream& record = ThreadRecord();
+    record.buffer.start(level, topic);
+    os = &record.os;
+    // level & topic are recorded
+    if(IsBinaryLog()) return (*os);
     // print the prefix?
     if(!skipPrefix){
-      (*os) << "[" << gLogPrefix << "]> ";
+      (*os) << "[" << gThreadLogConfig->prefix << "]> ";
       // print the message
-      (*os) << gLevelNames.at(level) << ":" << gTopicNames.at(topic);
+      (*os) << LogLevelName(level) << ":" << LogTopicName(topic);
       // None topic is special
       if(topic != None) (*os) << " -- ";
     }
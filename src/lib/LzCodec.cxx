@@ -0,0 +1,165 @@
+/** \file      src/lib/LzCodec.cxx
+    \brief     Source for the LZ block codec.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/LzCodec.hh"  // these methods
+#include <cstring>           // cplusplus.com/reference/cstring/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Format constants
+static const ULong_t gLzMinMatch = 4;        //!< shortest match
+static const ULong_t gLzMaxOffset = 0xFFFF;  //!< farthest match
+static const ULong_t gLzLastLiterals = 5;    //!< block ends with literals
+static const ULong_t gLzMatchLimit = 12;     //!< no match starts this close to the end
+static const UInt_t  gLzHashLog = 14;        //!< hash table size (log2)
+
+//_____________________________________________________________________________
+//! Read 4 bytes (host order; only compared).
+static inline UInt_t Read32(const Byte_t* p)
+{
+  UInt_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+//_____________________________________________________________________________
+//! Hash of 4 bytes.
+static inline UInt_t Hash4(UInt_t v)
+{
+  return (v * 2654435761u) >> (32 - gLzHashLog);
+}
+
+//_____________________________________________________________________________
+//! Write a length extension (runs of 255).
+static inline Byte_t* WriteLength(Byte_t* op, ULong_t length)
+{
+  for(; length >= 255; length -= 255) *op++ = 255;
+  *op++ = Byte_t(length);
+  return op;
+}
+
+//_____________________________________________________________________________
+/** Largest compressed size of a block of length bytes. */
+ULong_t LzBound(ULong_t length)
+{
+  return length + length/255 + 16;
+}
+
+//_____________________________________________________________________________
+/** Compress a block.
+    \return The compressed length, 0 if it does not fit in capacity. */
+ULong_t LzCompress(const Byte_t* src, ULong_t length, Byte_t* dst, ULong_t capacity)
+{
+  UInt_t table[1 << gLzHashLog];
+  memset(table, 0, sizeof(table));
+  const Byte_t* ip     = src;
+  const Byte_t* anchor = src;
+  const Byte_t* end    = src + length;
+  const Byte_t* mlimit = (length > gLzMatchLimit ? end - gLzMatchLimit : src);
+  Byte_t* op   = dst;
+  Byte_t* oend = dst + capacity;
+
+  while(ip < mlimit){
+    // find a match
+    UInt_t seq = Read32(ip);
+    UInt_t h = Hash4(seq);
+    const Byte_t* ref = src + table[h];
+    table[h] = UInt_t(ip - src);
+    if(ref >= ip || ULong_t(ip - ref) > gLzMaxOffset || Read32(ref) != seq){
+      // skip faster through incompressible data
+      ip += 1 + ((ip - anchor) >> 6);
+      continue;
+    }
+    // extend it
+    const Byte_t* mend = end - gLzLastLiterals;
+    ULong_t mlen = gLzMinMatch;
+    while(ip + mlen < mend && ref[mlen] == ip[mlen]) mlen++;
+
+    // sequence: token, literals, offset, match
+    ULong_t lit = ip - anchor;
+    if(op + 1 + lit + lit/255 + 2 + mlen/255 + 2 > oend) return 0;
+    Byte_t* token = op++;
+    *token = Byte_t((lit < 15 ? lit : 15) << 4);
+    if(lit >= 15) op = WriteLength(op, lit - 15);
+    memcpy(op, anchor, lit);
+    op += lit;
+    ULong_t offset = ip - ref;
+    *op++ = Byte_t(offset);
+    *op++ = Byte_t(offset >> 8);
+    ULong_t m = mlen - gLzMinMatch;
+    *token |= Byte_t(m < 15 ? m : 15);
+    if(m >= 15) op = WriteLength(op, m - 15);
+
+    ip += mlen;
+    anchor = ip;
+    // index the position before the next search
+    if(ip < mlimit) table[Hash4(Read32(ip - 2))] = UInt_t(ip - 2 - src);
+  }
+
+  // last literals
+  ULong_t lit = end - anchor;
+  if(op + 1 + lit + lit/255 + 1 > oend) return 0;
+  *op++ = Byte_t((lit < 15 ? lit : 15) << 4);
+  if(lit >= 15) op = WriteLength(op, lit - 15);
+  memcpy(op, anchor, lit);
+  op += lit;
+  return op - dst;
+}
+
+//_____________________________________________________________________________
+/** Decompress a block of exactly rawLength bytes.
+    \return false on corrupt input. */
+Bool_t LzDecompress(const Byte_t* src, ULong_t length, Byte_t* dst, ULong_t rawLength)
+{
+  const Byte_t* ip   = src;
+  const Byte_t* iend = src + length;
+  Byte_t* op   = dst;
+  Byte_t* oend = dst + rawLength;
+
+  while(ip < iend){
+    // literals
+    UInt_t token = *ip++;
+    ULong_t lit = token >> 4;
+    if(lit == 15){
+      Byte_t b;
+      do{
+	if(ip >= iend) return kFalse;
+	b = *ip++;
+	lit += b;
+      } while(b == 255);
+    }
+    if(lit > ULong_t(iend - ip) || lit > ULong_t(oend - op)) return kFalse;
+    memcpy(op, ip, lit);
+    ip += lit;
+    op += lit;
+    if(ip == iend) break;  // last sequence
+
+    // match
+    if(iend - ip < 2) return kFalse;
+    ULong_t offset = ULong_t(ip[0]) | (ULong_t(ip[1]) << 8);
+    ip += 2;
+    if(offset == 0 || offset > ULong_t(op - dst)) return kFalse;
+    ULong_t mlen = token & 15;
+    if(mlen == 15){
+      Byte_t b;
+      do{
+	if(ip >= iend) return kFalse;
+	b = *ip++;
+	mlen += b;
+      } while(b == 255);
+    }
+    mlen += gLzMinMatch;
+    if(mlen > ULong_t(oend - op)) return kFalse;
+    const Byte_t* ref = op - offset;
+    if(offset >= mlen) memcpy(op, ref, mlen);
+    else for(ULong_t i=0; i<mlen; i++) op[i] = ref[i];  // overlapping
+    op += mlen;
+  }
+  return op == oend;
+}
+
+} // end namespace Blobb
@@ -0,0 +1,458 @@
+/** \file      src/lib/LzStreamBuf.cxx
+    \brief     Source for LzOStreamBuf & LzIStreamBuf
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/LzStreamBuf.hh"  // these classes
+#include "blobb/LzCodec.hh"      // LZ block codec
+#include "blobb/Hash.hh"         // content hashing
+#include "blobb/Exception.hh"    // exception handler
+#include <condition_variable>    // cplusplus.com/reference/condition_variable/
+#include <cstring>               // cplusplus.com/reference/cstring/
+#include <exception>             // cplusplus.com/reference/exception/
+#include <functional>            // cplusplus.com/reference/functional/
+#include <mutex>                 // cplusplus.com/reference/mutex/
+#include <thread>                // cplusplus.com/reference/thread/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// Format constants
+static CChar_t gLzMagic[4] = {'B','L','Z','1'};  //!< stream magic
+static const UInt_t gLzStored = 0x80000000u;     //!< stored-raw flag
+static const UInt_t gLzMaxBlockSize = 1 << 26;   //!< largest block size
+static const UInt_t gLzMaxThreads = 16;          //!< most threads
+static const UInt_t gLzThreadBytes = 1 << 20;    //!< raw bytes per thread & batch
+
+//_____________________________________________________________________________
+//! Write 4 little-endian bytes.
+static inline void Put32(Byte_t* p, UInt_t v)
+{
+  p[0] = Byte_t(v); p[1] = Byte_t(v >> 8); p[2] = Byte_t(v >> 16); p[3] = Byte_t(v >> 24);
+}
+
+//_____________________________________________________________________________
+//! Read 4 little-endian bytes.
+static inline UInt_t Get32(const Byte_t* p)
+{
+  return UInt_t(p[0]) | (UInt_t(p[1]) << 8) | (UInt_t(p[2]) << 16) | (UInt_t(p[3]) << 24);
+}
+
+//_____________________________________________________________________________
+//! Default codec threads of the streams created on this thread (0: hardware concurrency)
+static thread_local UInt_t gLzDefThreads = 0;
+
+//_____________________________________________________________________________
+/** Set the default number of codec threads of the streams created on
+    this thread (0: hardware concurrency); e.g. 1 on threads which are
+    already one of many workers. */
+void SetLzThreads(UInt_t numThreads)
+{
+  gLzDefThreads = numThreads;
+}
+
+//_____________________________________________________________________________
+//! Get the default number of codec threads of the streams created on this thread.
+UInt_t GetLzThreads()
+{
+  return gLzDefThreads;
+}
+
+//_____________________________________________________________________________
+//! Number of threads to use (0: this thread's default).
+static UInt_t NumThreads(UInt_t numThreads)
+{
+  if(numThreads == 0) numThreads = gLzDefThreads;
+  if(numThreads == 0) numThreads = std::thread::hardware_concurrency();
+  if(numThreads == 0) numThreads = 1;
+  return (numThreads > gLzMaxThreads ? gLzMaxThreads : numThreads);
+}
+
+//_____________________________________________________________________________
+//! Number of blocks in a batch.
+static UInt_t BatchSize(UInt_t numThreads, UInt_t blockSize)
+{
+  return numThreads * (blockSize < gLzThreadBytes ? gLzThreadBytes / blockSize : 1);
+}
+
+/** \class LzWorkers
+    \brief Codec threads of a stream: started with its first parallel
+    batch and kept, waiting for the next one, until it is destroyed.
+*/
+class LzWorkers {
+public:
+  LzWorkers(UInt_t numThreads);
+  ~LzWorkers();
+
+  void run(UInt_t n, const std::function<void(UInt_t)>& work);
+
+private:
+  // not copyable
+  LzWorkers(const LzWorkers&);
+  LzWorkers& operator=(const LzWorkers&);
+
+  void loop(UInt_t t);
+
+private:
+  UInt_t                  mNumThreads;  //!< threads, with the caller's
+  vector<std::thread>     mThreads;     //!< other threads
+  std::mutex              mMutex;       //!< guards the batch
+  std::condition_variable mWake;        //!< wakes the threads: batch or stop
+  std::condition_variable mDone;        //!< wakes the caller: batch done
+  const std::function<void(UInt_t)>* mWork;  //!< work of the batch
+  UInt_t                  mN;           //!< items of the batch
+  UInt_t                  mStride;      //!< threads working on the batch
+  ULong_t                 mBatch;       //!< batch counter
+  UInt_t                  mBusy;        //!< threads still working on the batch
+  std::exception_ptr      mError;       //!< first failure of the batch
+  Bool_t                  mStop;        //!< threads to end
+};
+
+//_____________________________________________________________________________
+/** Constructor; no thread is started yet. */
+LzWorkers::LzWorkers(UInt_t numThreads)
+  : mNumThreads(numThreads),
+    mThreads(),
+    mMutex(),
+    mWake(),
+    mDone(),
+    mWork(0),
+    mN(0),
+    mStride(1),
+    mBatch(0),
+    mBusy(0),
+    mError(),
+    mStop(kFalse)
+{}
+
+//_____________________________________________________________________________
+/** Destructor; ends the threads. */
+LzWorkers::~LzWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = kTrue;
+  }
+  mWake.notify_all();
+  for(UInt_t t=0; t<mThreads.size(); t++) mThreads[t].join();
+}
+
+//_____________________________________________________________________________
+/** Run work(i) for i in [0, n), spread over (at most) numThreads threads,
+    the caller's included; returns when all are done. */
+void LzWorkers::run(UInt_t n, const std::function<void(UInt_t)>& work)
+{
+  UInt_t nt = (n < mNumThreads ? n : mNumThreads);
+  if(nt <= 1){
+    for(UInt_t i=0; i<n; i++) work(i);
+    return;
+  }
+  while(mThreads.size() + 1 < mNumThreads)
+    mThreads.push_back(std::thread(&LzWorkers::loop, this, UInt_t(mThreads.size() + 1)));
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWork = &work;
+    mN = n;
+    mStride = nt;
+    mBusy = nt - 1;
+    mError = std::exception_ptr();
+    mBatch++;
+  }
+  mWake.notify_all();
+
+  // the threads refer to work until done, even if this share throws
+  std::exception_ptr error;
+  try{ for(UInt_t i=0; i<n; i+=nt) work(i); }
+  catch(...){ error = std::current_exception(); }
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDone.wait(lock, [this](){ return mBusy == 0; });
+  if(!error) error = mError;
+  if(error) std::rethrow_exception(error);
+}
+
+//_____________________________________________________________________________
+/** Thread t: work on its share of each batch it is needed for. */
+void LzWorkers::loop(UInt_t t)
+{
+  ULong_t batch(0);
+  std::unique_lock<std::mutex> lock(mMutex);
+  for(;;){
+    mWake.wait(lock, [this, batch](){ return mStop || mBatch != batch; });
+    if(mStop) return;
+    batch = mBatch;
+    if(t >= mStride) continue;
+    const std::function<void(UInt_t)>& work = *mWork;
+    UInt_t n(mN), nt(mStride);
+    lock.unlock();
+    std::exception_ptr error;
+    try{ for(UInt_t i=t; i<n; i+=nt) work(i); }
+    catch(...){ error = std::current_exception(); }
+    lock.lock();
+    if(error && !mError) mError = error;
+    if(--mBusy == 0) mDone.notify_one();
+  }
+}
+
+//_____________________________________________________________________________
+/** Constructor; writes the stream header. */
+LzOStreamBuf::LzOStreamBuf(ostream& sink, UInt_t blockSize, UInt_t numThreads)
+  : std::streambuf(),
+    mSink(sink),
+    mBlockSize(blockSize == 0 ? kDefBlockSize :
+	       (blockSize > gLzMaxBlockSize ? gLzMaxBlockSize : blockSize)),
+    mNumThreads(NumThreads(numThreads)),
+    mWorkers(new LzWorkers(mNumThreads)),
+    mRaw(BatchSize(mNumThreads, mBlockSize), vector<Byte_t>(mBlockSize)),
+    mRawSizes(mRaw.size(), 0),
+    mBlock(0),
+    mRawBytes(0),
+    mStoredBytes(0),
+    mClosed(kFalse),
+    mBlocks()
+{
+  Byte_t header[8];
+  memcpy(header, gLzMagic, 4);
+  Put32(header + 4, mBlockSize);
+  mSink.write(reinterpret_cast<CChar_t*>(header), sizeof(header));
+  mStoredBytes += sizeof(header);
+  Char_t* b = reinterpret_cast<Char_t*>(&mRaw[0][0]);
+  setp(b, b + mBlockSize);
+}
+
+//_____________________________________________________________________________
+/** Destructor; closes the stream. */
+LzOStreamBuf::~LzOStreamBuf()
+{
+  try{ close(); }
+  catch(...){}
+  delete mWorkers;
+}
+
+//_____________________________________________________________________________
+/** Write the buffered blocks and the end marker. */
+void LzOStreamBuf::close()
+{
+  if(mClosed) return;
+  sync();
+  Byte_t end[4];
+  Put32(end, 0);
+  mSink.write(reinterpret_cast<CChar_t*>(end), sizeof(end));
+  mStoredBytes += sizeof(end);
+  mSink.flush();
+  mClosed = kTrue;
+  if(!mSink) throw Exception("LzOStreamBuf::close: Failed to write the stream.");
+}
+
+//_____________________________________________________________________________
+/** Current block is full: move to the next one. */
+LzOStreamBuf::int_type LzOStreamBuf::overflow(int_type c)
+{
+  if(mClosed) return traits_type::eof();
+  if(pptr() == epptr()) nextBlock();
+  if(!traits_type::eq_int_type(c, traits_type::eof())){
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+//_____________________________________________________________________________
+/** Compress & write all buffered bytes (ends the current block). */
+int LzOStreamBuf::sync()
+{
+  if(mClosed) return 0;
+  mRawSizes[mBlock] = pptr() - pbase();
+  mBlock += (mRawSizes[mBlock] > 0 ? 1 : 0);
+  writeBatch();
+  return (mSink ? 0 : -1);
+}
+
+//_____________________________________________________________________________
+/** Position in the raw stream (tellp); the stream cannot be moved. */
+LzOStreamBuf::pos_type LzOStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+					     std::ios_base::openmode which)
+{
+  if(off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out))
+    return pos_type(off_type(-1));
+  ULong_t pos = mRawBytes + (pptr() - pbase());
+  for(UInt_t b=0; b<mBlock; b++) pos += mRawSizes[b];
+  return pos_type(off_type(pos));
+}
+
+//_____________________________________________________________________________
+/** Close the current block; write the batch when all blocks are used. */
+void LzOStreamBuf::nextBlock()
+{
+  mRawSizes[mBlock] = pptr() - pbase();
+  mBlock++;
+  if(mBlock == mRaw.size()) writeBatch();
+  else{
+    Char_t* b = reinterpret_cast<Char_t*>(&mRaw[mBlock][0]);
+    setp(b, b + mBlockSize);
+  }
+}
+
+//_____________________________________________________________________________
+/** Compress the used blocks in parallel and write them in order. */
+void LzOStreamBuf::writeBatch()
+{
+  UInt_t n = mBlock;
+  vector< vector<Byte_t> > out(n);
+  vector<UInt_t> stored(n, 0), checks(n, 0);
+  mWorkers->run(n, [&](UInt_t i){
+      const Byte_t* raw = &mRaw[i][0];
+      ULong_t size = mRawSizes[i];
+      out[i].resize(LzBound(size));
+      ULong_t length = LzCompress(raw, size, &out[i][0], size);  // no gain: store raw
+      stored[i] = (length > 0 ? UInt_t(length) : (UInt_t(size) | gLzStored));
+      checks[i] = UInt_t(Hash64(raw, size));
+    });
+
+  for(UInt_t i=0; i<n; i++){
+    Block_t block = {mRawBytes, mStoredBytes};
+    mBlocks.push_back(block);
+    Byte_t header[12];
+    Put32(header,     UInt_t(mRawSizes[i]));
+    Put32(header + 4, stored[i]);
+    Put32(header + 8, checks[i]);
+    mSink.write(reinterpret_cast<CChar_t*>(header), sizeof(header));
+    if(stored[i] & gLzStored)
+      mSink.write(reinterpret_cast<CChar_t*>(&mRaw[i][0]), mRawSizes[i]);
+    else
+      mSink.write(reinterpret_cast<CChar_t*>(&out[i][0]), stored[i]);
+    mRawBytes += mRawSizes[i];
+    mStoredBytes += sizeof(header) + (stored[i] & ~gLzStored);
+  }
+
+  // restart the batch
+  mBlock = 0;
+  Char_t* b = reinterpret_cast<Char_t*>(&mRaw[0][0]);
+  setp(b, b + mBlockSize);
+}
+
+//_____________________________________________________________________________
+/** Constructor. The header is read with the first batch. */
+LzIStreamBuf::LzIStreamBuf(istream& source, UInt_t numThreads)
+  : std::streambuf(),
+    mSource(source),
+    mBlockSize(0),
+    mNumThreads(NumThreads(numThreads)),
+    mWorkers(new LzWorkers(mNumThreads)),
+    mRaw(),
+    mRawSizes(),
+    mBlock(0),
+    mNumBlocks(0),
+    mEnd(kFalse)
+{}
+
+//_____________________________________________________________________________
+/** Destructor. */
+LzIStreamBuf::~LzIStreamBuf()
+{
+  delete mWorkers;
+}
+
+//_____________________________________________________________________________
+/** Read & decompress the single block starting at the stream position.
+    \warning Throws Exception on corrupt input. */
+void LzIStreamBuf::ReadBlock(istream& is, vector<Byte_t>& raw)
+{
+  Byte_t header[12];
+  is.read(reinterpret_cast<Char_t*>(header), sizeof(header));
+  if(is.gcount() != sizeof(header)) throw Exception("LzIStreamBuf: Truncated stream.");
+  UInt_t rawSize = Get32(header);
+  UInt_t stored = Get32(header + 4);
+  ULong_t length = stored & ~gLzStored;
+  if(rawSize == 0 || rawSize > gLzMaxBlockSize || length > LzBound(rawSize))
+    throw Exception("LzIStreamBuf: Corrupt block header.");
+  vector<Byte_t> in(length + 1);
+  is.read(reinterpret_cast<Char_t*>(&in[0]), length);
+  if(ULong_t(is.gcount()) != length) throw Exception("LzIStreamBuf: Truncated stream.");
+  raw.resize(rawSize);
+  Bool_t ok(kTrue);
+  if(stored & gLzStored){
+    ok = (length == rawSize);
+    if(ok) memcpy(&raw[0], &in[0], length);
+  }
+  else ok = LzDecompress(&in[0], length, &raw[0], rawSize);
+  if(!ok || UInt_t(Hash64(&raw[0], rawSize)) != Get32(header + 8))
+    throw Exception("LzIStreamBuf: Corrupt block.");
+}
+
+//_____________________________________________________________________________
+/** Current block is consumed: move to the next one (or batch). */
+LzIStreamBuf::int_type LzIStreamBuf::underflow()
+{
+  while(gptr() == egptr()){
+    if(mBlock + 1 < mNumBlocks) mBlock++;
+    else{
+      if(mEnd) return traits_type::eof();
+      readBatch();
+      mBlock = 0;
+      if(mNumBlocks == 0) return traits_type::eof();
+    }
+    Char_t* b = reinterpret_cast<Char_t*>(&mRaw[mBlock][0]);
+    setg(b, b, b + mRawSizes[mBlock]);
+  }
+  return traits_type::to_int_type(*gptr());
+}
+
+//_____________________________________________________________________________
+/** Read a batch of blocks and decompress them in parallel. */
+void LzIStreamBuf::readBatch()
+{
+  // header
+  if(mBlockSize == 0){
+    Byte_t header[8];
+    mSource.read(reinterpret_cast<Char_t*>(header), sizeof(header));
+    if(mSource.gcount() != sizeof(header) || memcmp(header, gLzMagic, 4) != 0)
+      throw Exception("LzIStreamBuf: Not an LZ-compressed stream.");
+    mBlockSize = Get32(header + 4);
+    if(mBlockSize == 0 || mBlockSize > gLzMaxBlockSize)
+      throw Exception("LzIStreamBuf: Invalid block size.");
+    mRaw.assign(BatchSize(mNumThreads, mBlockSize), vector<Byte_t>(mBlockSize));
+    mRawSizes.assign(mRaw.size(), 0);
+  }
+
+  // blocks
+  vector< vector<Byte_t> > in(mRaw.size());
+  vector<UInt_t> stored(mRaw.size(), 0), checks(mRaw.size(), 0);
+  mNumBlocks = 0;
+  while(mNumBlocks < mRaw.size()){
+    Byte_t header[12];
+    mSource.read(reinterpret_cast<Char_t*>(header), 4);
+    if(mSource.gcount() != 4) throw Exception("LzIStreamBuf: Truncated stream.");
+    UInt_t rawSize = Get32(header);
+    if(rawSize == 0){ mEnd = kTrue; break; }
+    mSource.read(reinterpret_cast<Char_t*>(header + 4), 8);
+    if(mSource.gcount() != 8) throw Exception("LzIStreamBuf: Truncated stream.");
+    UInt_t i = mNumBlocks++;
+    stored[i] = Get32(header + 4);
+    checks[i] = Get32(header + 8);
+    ULong_t length = stored[i] & ~gLzStored;
+    if(rawSize > mBlockSize || length > LzBound(mBlockSize))
+      throw Exception("LzIStreamBuf: Corrupt block header.");
+    mRawSizes[i] = rawSize;
+    in[i].resize(length + 1);
+    mSource.read(reinterpret_cast<Char_t*>(&in[i][0]), length);
+    if(ULong_t(mSource.gcount()) != length) throw Exception("LzIStreamBuf: Truncated stream.");
+  }
+
+  // decompress
+  vector<Char_t> ok(mNumBlocks, 0);
+  mWorkers->run(mNumBlocks, [&](UInt_t i){
+      ULong_t length = stored[i] & ~gLzStored;
+      Byte_t* raw = &mRaw[i][0];
+      if(stored[i] & gLzStored){
+	if(length != mRawSizes[i]) return;
+	memcpy(raw, &in[i][0], length);
+      }
+      else if(!LzDecompress(&in[i][0], length, raw, mRawSizes[i])) return;
+      ok[i] = (UInt_t(Hash64(raw, mRawSizes[i])) == checks[i]);
+    });
+  for(UInt_t i=0; i<mNumBlocks; i++)
+    if(!ok[i]) throw Exception("LzIStreamBuf: Corrupt block.");
+}
+
+} // end namespace Blobb
@@ -0,0 +1,124 @@
+/** \file      src/lib/MappedFile.cxx
+    \brief     Source for MappedFile
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/MappedFile.hh"  // this class
+#include "blobb/LogService.hh"  // logging
+#include <fstream>              // cplusplus.com/reference/fstream/
+
+#ifdef HAVE_SYS_MMAN_H
+  #include <sys/mman.h>         // mmap, munmap
+  #include <sys/stat.h>         // fstat
+  #include <fcntl.h>            // open
+  #include <unistd.h>           // close
+#endif // end HAVE_SYS_MMAN_H
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Default constructor. */
+MappedFile::MappedFile()
+  : mFileName(""),
+    mData(0),
+    mSize(0),
+    mIsMapped(kFalse)
+{}
+
+//_____________________________________________________________________________
+/** Constructor; maps the file. */
+MappedFile::MappedFile(const string& fileName, Bool_t terminated)
+  : mFileName(""),
+    mData(0),
+    mSize(0),
+    mIsMapped(kFalse)
+{
+  open(fileName, terminated);
+}
+
+//_____________________________________________________________________________
+/** Destructor; un-maps the file. */
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+//_____________________________________________________________________________
+/** Map a file (read-only).
+    \param terminated Guarantee a null character after the last byte.
+    \return true if the file is mapped (and not empty). */
+Bool_t MappedFile::open(const string& fileName, Bool_t terminated)
+{
+  close();
+  mFileName = fileName;
+
+#ifdef HAVE_SYS_MMAN_H
+  // map the file
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if(fd < 0){
+    loutE(InputArguments) << "MappedFile::open: Failed to open file '" << fileName << "'." << endl;
+    return kFalse;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size <= 0){
+    loutE(InputArguments) << "MappedFile::open: Empty or unreadable file '" << fileName << "'." << endl;
+    ::close(fd);
+    return kFalse;
+  }
+  // the rest of the last page reads as zeros; a full last page has no rest
+  if(terminated && st.st_size % sysconf(_SC_PAGESIZE) == 0){
+    ::close(fd);
+    return read(fileName);
+  }
+  void* addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(addr == MAP_FAILED){
+    loutE(InputArguments) << "MappedFile::open: Failed to map file '" << fileName << "'." << endl;
+    return kFalse;
+  }
+  mData = static_cast<const Byte_t*>(addr);
+  mSize = st.st_size;
+  mIsMapped = kTrue;
+  return kTrue;
+#else
+  (void)terminated;
+  return read(fileName);
+#endif // end HAVE_SYS_MMAN_H
+}
+
+//_____________________________________________________________________________
+/** Read a file into (terminated) memory. */
+Bool_t MappedFile::read(const string& fileName)
+{
+  std::ifstream ifs(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if(!ifs.is_open() || ifs.tellg() <= 0){
+    loutE(InputArguments) << "MappedFile::open: Failed to open file '" << fileName << "'." << endl;
+    return kFalse;
+  }
+  mSize = ifs.tellg();
+  Byte_t* buf = new Byte_t[mSize + 1];
+  buf[mSize] = 0;
+  ifs.seekg(0);
+  ifs.read(reinterpret_cast<Char_t*>(buf), mSize);
+  mData = buf;
+  mIsMapped = kFalse;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Un-map the file. */
+void MappedFile::close()
+{
+  if(mData){
+#ifdef HAVE_SYS_MMAN_H
+    if(mIsMapped) munmap(const_cast<Byte_t*>(mData), mSize);
+#endif // end HAVE_SYS_MMAN_H
+    if(!mIsMapped) delete[] mData;
+  }
+  mData = 0;
+  mSize = 0;
+  mIsMapped = kFalse;
+}
+
+} // end namespace Blobb
@@ -0,0 +1,408 @@
+/** \file      src/lib/MappedRoster.cxx
+    \brief     Source for MappedRoster
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/MappedRoster.hh"  // this class
+#include "blobb/Exception.hh"     // exception handler
+#include "blobb/LogService.hh"    // logging
+#include <cstring>                // cplusplus.com/reference/cstring/
+#include <unordered_map>          // cplusplus.com/reference/unordered_map/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+// File layout
+
+//! Magic bytes at the start of the file.
+static CChar_t gMapMagic[8] = {'B','L','O','B','B','M','A','P'};
+//! Byte-order mark, as written by the host.
+static const UInt_t gMapByteOrder = 0x01020304;
+//! Layout version.
+static const UInt_t gMapVersion = 1;
+
+/** \struct MapString_t
+    \brief Reference into the string pool. */
+struct MapString_t {
+  ULong_t offset;  //!< offset from the start of the pool
+  ULong_t length;  //!< number of characters
+};
+
+/** \struct MapParameter_t
+    \brief Fixed-size Parameter record. */
+struct MapParameter_t {
+  MapString_t name;   //!< name
+  MapString_t title;  //!< title
+  Double_t    value;  //!< value
+  Double_t    error;  //!< error
+  Double_t    min;    //!< minimum
+  Double_t    max;    //!< maximum
+};
+
+//! Number of Parameter's in a Warrior.
+static const UInt_t gMapNumParams = 11;
+
+/** \struct MapWarrior_t
+    \brief Fixed-size Warrior record. */
+struct MapWarrior_t {
+  MapString_t    name;                   //!< name
+  MapString_t    title;                  //!< title
+  MapParameter_t params[gMapNumParams];  //!< attributes & disabilities
+};
+
+/** \struct MapIndex_t
+    \brief Name index entry; entries are sorted by key. */
+struct MapIndex_t {
+  MapString_t key;     //!< registered (map) name
+  ULong_t     record;  //!< record number
+};
+
+/** \struct MapHeader_t
+    \brief File header. */
+struct MapHeader_t {
+  Char_t      magic[8];       //!< gMapMagic
+  UInt_t      byteOrder;      //!< gMapByteOrder
+  UInt_t      version;        //!< gMapVersion
+  ULong_t     recordSize;     //!< sizeof(MapWarrior_t)
+  ULong_t     numWarriors;    //!< number of warriors
+  ULong_t     indexOffset;    //!< offset of the name index
+  ULong_t     recordsOffset;  //!< offset of the records
+  ULong_t     stringsOffset;  //!< offset of the string pool
+  ULong_t     stringsSize;    //!< size of the string pool
+  MapString_t name;           //!< state name
+  MapString_t title;          //!< state title
+  Long_t      startTime;      //!< start-time (UTS)
+  Long_t      endTime;        //!< end-time (UTS)
+  UInt_t      seed;           //!< random seed
+  UInt_t      numIter;        //!< random iterations
+};
+
+static_assert(sizeof(MapParameter_t) == 64,  "MapParameter_t must be packed");
+static_assert(sizeof(MapWarrior_t)   == 736, "MapWarrior_t must be packed");
+static_assert(sizeof(MapHeader_t) % 8 == 0,  "MapHeader_t must be 8-byte aligned");
+
+//! Warrior parameters, in record order.
+static Parameter Warrior::* const gMapParams[gMapNumParams] =
+  {
+    &Warrior::mProwess,
+    &Warrior::mAgility,
+    &Warrior::mIntelligence,
+    &Warrior::mPersonality,
+    &Warrior::mHealth,
+    &Warrior::mFatigue,
+    &Warrior::mStun,
+    &Warrior::mDisarm,
+    &Warrior::mFallen,
+    &Warrior::mFatigueTime,
+    &Warrior::mHealthTime
+  };
+
+//_____________________________________________________________________________
+/** Default constructor. */
+MappedRoster::MappedRoster()
+  : mFile()
+{}
+
+//_____________________________________________________________________________
+/** Constructor; opens the roster file. */
+MappedRoster::MappedRoster(const string& fileName)
+  : mFile()
+{
+  open(fileName);
+}
+
+//_____________________________________________________________________________
+/** Map a roster file and check its header.
+    \return true if the file is a valid roster for this host. */
+Bool_t MappedRoster::open(const string& fileName)
+{
+  if(!mFile.open(fileName)) return kFalse;
+
+  // check the header
+  string err("");
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(mFile.data());
+  if(mFile.size() < sizeof(MapHeader_t) || memcmp(h->magic, gMapMagic, 8) != 0)
+    err = "not a mapped roster file";
+  else if(h->byteOrder != gMapByteOrder)
+    err = "file byte-order differs from this host";
+  else if(h->version != gMapVersion || h->recordSize != sizeof(MapWarrior_t))
+    err = "unsupported layout version";
+  else if(!fits(h->indexOffset, h->numWarriors, sizeof(MapIndex_t)) ||
+	  !fits(h->recordsOffset, h->numWarriors, sizeof(MapWarrior_t)) ||
+	  !fits(h->stringsOffset, h->stringsSize, 1))
+    err = "file is truncated or corrupt";
+  if(err != ""){
+    loutE(InputArguments) << "MappedRoster::open: Cannot use '" << fileName
+			  << "'; " << err << "." << endl;
+    mFile.close();
+    return kFalse;
+  }
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Does a section of num items of the given size, at offset, lie after
+    the header and within the file (and is it aligned)? Overflow-safe. */
+Bool_t MappedRoster::fits(ULong_t offset, ULong_t num, ULong_t size) const
+{
+  ULong_t fileSize = mFile.size();
+  if(offset < sizeof(MapHeader_t) || offset > fileSize || offset % 8 != 0) return kFalse;
+  return (num <= (fileSize - offset)/size);
+}
+
+//_____________________________________________________________________________
+/** Un-map the roster file. */
+void MappedRoster::close()
+{
+  mFile.close();
+}
+
+//_____________________________________________________________________________
+/** Pointer into the mapped file. */
+const Byte_t* MappedRoster::section(ULong_t offset) const
+{
+  if(!isOpen()) throw Exception("MappedRoster: No roster file open.");
+  return mFile.data() + offset;
+}
+
+//_____________________________________________________________________________
+/** String from the pool. */
+string MappedRoster::str(ULong_t offset, ULong_t length) const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  if(offset > h->stringsSize || length > h->stringsSize - offset)
+    throw Exception("MappedRoster::str: String out of range.");
+  return string(reinterpret_cast<CChar_t*>(section(h->stringsOffset + offset)), length);
+}
+
+//_____________________________________________________________________________
+/** State name. */
+string MappedRoster::name() const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  return str(h->name.offset, h->name.length);
+}
+
+//_____________________________________________________________________________
+/** State title. */
+string MappedRoster::title() const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  return str(h->title.offset, h->title.length);
+}
+
+//_____________________________________________________________________________
+/** State start-time. */
+TimeStamp MappedRoster::startTime() const
+{
+  return TimeStamp(reinterpret_cast<const MapHeader_t*>(section(0))->startTime);
+}
+
+//_____________________________________________________________________________
+/** State end-time. */
+TimeStamp MappedRoster::endTime() const
+{
+  return TimeStamp(reinterpret_cast<const MapHeader_t*>(section(0))->endTime);
+}
+
+//_____________________________________________________________________________
+/** State random generator. */
+Random MappedRoster::random() const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  return Random(h->seed, h->numIter);
+}
+
+//_____________________________________________________________________________
+/** Number of warriors. */
+ULong_t MappedRoster::size() const
+{
+  return (isOpen() ? reinterpret_cast<const MapHeader_t*>(section(0))->numWarriors : 0);
+}
+
+//_____________________________________________________________________________
+/** Registered name of the i-th warrior (in name order). */
+string MappedRoster::key(ULong_t i) const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  if(i >= h->numWarriors) throw out_of_range("MappedRoster::key");
+  const MapIndex_t* idx = reinterpret_cast<const MapIndex_t*>(section(h->indexOffset)) + i;
+  return str(idx->key.offset, idx->key.length);
+}
+
+//_____________________________________________________________________________
+/** Position of the warrior registered as key (binary search of the index).
+    \return -1 if not found. */
+Long_t MappedRoster::find(const string& key) const
+{
+  if(!isOpen()) return -1;
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  const MapIndex_t* idx = reinterpret_cast<const MapIndex_t*>(section(h->indexOffset));
+  CChar_t* pool = reinterpret_cast<CChar_t*>(section(h->stringsOffset));
+  ULong_t lo(0), hi(h->numWarriors);
+  while(lo < hi){
+    ULong_t mid = lo + (hi - lo)/2;
+    const MapString_t& k = idx[mid].key;
+    if(k.offset > h->stringsSize || k.length > h->stringsSize - k.offset)
+      throw Exception("MappedRoster::find: Key out of range.");
+    Int_t cmp = key.compare(0, string::npos, pool + k.offset, k.length);
+    if(cmp == 0) return Long_t(mid);
+    if(cmp < 0) hi = mid;
+    else        lo = mid + 1;
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+/** Build the i-th warrior (in name order) from its record. */
+Warrior MappedRoster::warrior(ULong_t i) const
+{
+  const MapHeader_t* h = reinterpret_cast<const MapHeader_t*>(section(0));
+  if(i >= h->numWarriors) throw out_of_range("MappedRoster::warrior");
+  const MapIndex_t* idx = reinterpret_cast<const MapIndex_t*>(section(h->indexOffset)) + i;
+  if(idx->record >= h->numWarriors) throw Exception("MappedRoster::warrior: Corrupt index.");
+  const MapWarrior_t* rec =
+    reinterpret_cast<const MapWarrior_t*>(section(h->recordsOffset)) + idx->record;
+
+  Warrior w(str(rec->name.offset, rec->name.length),
+	    str(rec->title.offset, rec->title.length));
+  for(UInt_t p=0; p<gMapNumParams; p++){
+    const MapParameter_t& mp = rec->params[p];
+    Parameter& par = w.*gMapParams[p];
+    par.setNameTitle(str(mp.name.offset, mp.name.length),
+		     str(mp.title.offset, mp.title.length));
+    par.set(mp.value, mp.error);
+    par.setRange(mp.min, mp.max);
+  }
+  return w;
+}
+
+//_____________________________________________________________________________
+/** Build the warrior registered as key.
+    \warning Throws out_of_range if not found. */
+Warrior MappedRoster::warrior(const string& key) const
+{
+  Long_t i = find(key);
+  if(i < 0) throw out_of_range("MappedRoster::warrior: '" + key + "' not found");
+  return warrior(ULong_t(i));
+}
+
+//_____________________________________________________________________________
+/** Build all warriors (i.e. touch the whole file). */
+void MappedRoster::warriors(Warriors_t& wars) const
+{
+  wars.clear();
+  for(ULong_t i=0; i<size(); i++)
+    wars.insert(wars.end(), Warriors_t::value_type(key(i), warrior(i)));
+}
+
+//_____________________________________________________________________________
+/** \class MapStringPool
+    \brief Helper for writing the string pool.
+*/
+class MapStringPool {
+public:
+  //! Append a string, re-using an identical one if shared is true.
+  MapString_t add(const string& s, Bool_t shared = kTrue)
+  {
+    if(shared){
+      std::unordered_map<string,ULong_t>::const_iterator it = mShared.find(s);
+      if(it != mShared.end()){ MapString_t ref = {it->second, s.size()}; return ref; }
+      mShared[s] = mPool.size();
+    }
+    MapString_t ref = {mPool.size(), s.size()};
+    mPool += s;
+    return ref;
+  }
+  string                              mPool;    //!< pool of characters
+  std::unordered_map<string,ULong_t>  mShared;  //!< offsets of shared strings
+};
+
+//_____________________________________________________________________________
+/** Write a roster file, sequentially (no seeks: any stream, at any
+    position). The string pool is built first, so that the header is
+    complete; the index and the records then only look strings up.
+    Warriors are written in name order; the registered names are not
+    de-duplicated (except when they equal the warrior name) since they are
+    (mostly) unique.
+*/
+void MappedRoster::Write(ostream& os, const string& name, const string& title,
+			 const TimeStamp& startTime, const TimeStamp& endTime,
+			 const Random& random, const Warriors_t& wars)
+{
+  MapStringPool pool;
+
+  // header
+  MapHeader_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, gMapMagic, 8);
+  h.byteOrder     = gMapByteOrder;
+  h.version       = gMapVersion;
+  h.recordSize    = sizeof(MapWarrior_t);
+  h.numWarriors   = wars.size();
+  h.indexOffset   = sizeof(MapHeader_t);
+  h.recordsOffset = h.indexOffset + h.numWarriors*sizeof(MapIndex_t);
+  h.stringsOffset = h.recordsOffset + h.numWarriors*sizeof(MapWarrior_t);
+  h.name          = pool.add(name);
+  h.title         = pool.add(title);
+  h.startTime     = startTime.uts();
+  h.endTime       = endTime.uts();
+  h.seed          = random.seed();
+  h.numIter       = random.numIter();
+
+  // the pool: keys first, then the records' strings
+  vector<MapString_t> keys, names;
+  keys.reserve(wars.size());
+  names.reserve(wars.size());
+  for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it)
+    keys.push_back(pool.add(it->first, kFalse));
+  ULong_t rec(0);
+  for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it, ++rec){
+    const Warrior& w = it->second;
+    names.push_back(w.name() == it->first ? keys[rec] : pool.add(w.name(), kFalse));
+    pool.add(w.title());
+    for(UInt_t p=0; p<gMapNumParams; p++){
+      const Parameter& par = w.*gMapParams[p];
+      pool.add(par.name());
+      pool.add(par.title());
+    }
+  }
+  h.stringsSize = pool.mPool.size();
+  os.write(reinterpret_cast<CChar_t*>(&h), sizeof(h));
+
+  // name index
+  for(rec=0; rec<keys.size(); rec++){
+    MapIndex_t idx;
+    idx.key    = keys[rec];
+    idx.record = rec;
+    os.write(reinterpret_cast<CChar_t*>(&idx), sizeof(idx));
+  }
+
+  // records (shared strings: found in the pool)
+  rec = 0;
+  for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it, ++rec){
+    const Warrior& w = it->second;
+    MapWarrior_t mw;
+    memset(&mw, 0, sizeof(mw));
+    mw.name  = names[rec];
+    mw.title = pool.add(w.title());
+    for(UInt_t p=0; p<gMapNumParams; p++){
+      const Parameter& par = w.*gMapParams[p];
+      MapParameter_t& mp = mw.params[p];
+      mp.name  = pool.add(par.name());
+      mp.title = pool.add(par.title());
+      mp.value = par.value();
+      mp.error = par.error();
+      mp.min   = par.min();
+      mp.max   = par.max();
+    }
+    os.write(reinterpret_cast<CChar_t*>(&mw), sizeof(mw));
+  }
+
+  // strings
+  os.write(pool.mPool.data(), pool.mPool.size());
+  if(!os) throw Exception("MappedRoster::Write: Failed to write the roster.");
+}
+
+} // end namespace Blobb
@@ -7,6 +7,8 @@
 #include "blobb/Named.hh"        // this class
 #include "blobb/ClassImp.hh"     // blobb class implementation
 #include "blobb/CLUI.hh"         // command-line user interface
+#include "blobb/Hash.hh"         // content hashing
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
 
 //! Blobb class implementation macro
 BLOBB_CLASS_IMP(Named)
@@ -18,7 +20,8 @@ namespace Blobb {
 Named::Named(const string& name, const string& title)
   : AbsObject(),
     mName(name),
-    mTitle(title)
+    mTitle(title),
+    mHash(0)
 {}
 
 //_____________________________________________________________________________
@@ -26,7 +29,8 @@ Named::Named(const string& name, const string& title)
 Named::Named(const Named& other, const string& newName)
   : AbsObject(other),
     mName(other.mName),
-    mTitle(other.mTitle)
+    mTitle(other.mTitle),
+    mHash(0)
 {
   if(newName != "")
     mName = newName;
@@ -39,6 +43,7 @@ Named& Named::operator=(const Named& rhs)
   AbsObject::operator=(rhs);
   mName  = rhs.mName;
   mTitle = rhs.mTitle;
+  mHash  = rhs.mHash;
   return *this;
 }
 
@@ -57,6 +62,7 @@ void Named::clear()
 {
   mName  = "";
   mTitle = "";
+  invalidateHash();
 }
 
 //_____________________________________________________________________________
@@ -65,16 +71,37 @@ Bool_t Named::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const Named& n = static_cast<const Named&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const Named& n = dynamic_cast<const Named&>(other); 
-    // check members
-    if(mName  != n.name())  return kFalse;
-    if(mTitle != n.title()) return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(mName  != n.name())  return kFalse;
+  if(mTitle != n.title()) return kFalse;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Content hash, cached until the next mutation. */
+ULong_t Named::hash() const
+{
+  if(mHash == 0) mHash = computeHash();
+  return mHash;
+}
+
+//_____________________________________________________________________________
+/** Compute the content hash of name and title. */
+ULong_t Named::computeHash() const
+{
+  return HashString(HashString(ClassId(), mName), mTitle);
+}
+
+//_____________________________________________________________________________
+/** Write name & title to a streaming writer. */
+void Named::stream(StreamWriter& sw) const
+{
+  sw.value("Name", mName);
+  sw.value("Title", mTitle);
 }
 
 //_____________________________________________________________________________
@@ -99,6 +126,7 @@ Bool_t Named::readFromUI(CLUI& clui, Bool_t /*verbose*/)
   mName = clui.readString();
   clui.request("Title");
   mTitle = clui.readString();
+  invalidateHash();
   return kTrue;
 }
 
@@ -49,7 +49,11 @@ Options::Options()
     mCopyright(kFalse),
     mBatch(kFalse),
     mProgName(""),
-    mInFileName("")
+    mInFileName(""),
+    mScriptFileName(""),
+    mOutFileName(""),
+    mDashboard(kFalse),
+    mBinaryLogFileName("")
 {}
 
 //_____________________________________________________________________________
@@ -63,7 +67,11 @@ Options::Options(Int_t argc, Char_t** argv)
     mCopyright(kFalse),
     mBatch(kFalse),
     mProgName(""),
-    mInFileName("")
+    mInFileName(""),
+    mScriptFileName(""),
+    mOutFileName(""),
+    mDashboard(kFalse),
+    mBinaryLogFileName("")
 {
   set(argc, argv);
 }
@@ -77,7 +85,11 @@ Options::Options(const Options& other, const string& /*newName*/)
     mCopyright(other.mCopyright),
     mBatch(other.mBatch),
     mProgName(other.mProgName),
-    mInFileName(other.mInFileName)
+    mInFileName(other.mInFileName),
+    mScriptFileName(other.mScriptFileName),
+    mOutFileName(other.mOutFileName),
+    mDashboard(other.mDashboard),
+    mBinaryLogFileName(other.mBinaryLogFileName)
 {}
 
 //_____________________________________________________________________________
@@ -91,6 +103,10 @@ Options& Options::operator=(const Options& rhs)
   mBatch       = rhs.mBatch;
   mProgName    = rhs.mProgName;
   mInFileName  = rhs.mInFileName;
+  mScriptFileName = rhs.mScriptFileName;
+  mOutFileName    = rhs.mOutFileName;
+  mDashboard      = rhs.mDashboard;
+  mBinaryLogFileName = rhs.mBinaryLogFileName;
   return *this;
 }
 
@@ -104,6 +120,10 @@ Bool_t Options::isEmpty() const
   if(mBatch)             return kFalse;
   if(mProgName != "")    return kFalse;
   if(mInFileName != "")  return kFalse;
+  if(mScriptFileName != "") return kFalse;
+  if(mOutFileName != "")    return kFalse;
+  if(mDashboard)            return kFalse;
+  if(mBinaryLogFileName != "") return kFalse;
   return kTrue;
 }
 
@@ -117,6 +137,10 @@ void Options::clear()
   mBatch       = kFalse;
   mProgName    = "";
   mInFileName  = "";
+  mScriptFileName = "";
+  mOutFileName    = "";
+  mDashboard      = kFalse;
+  mBinaryLogFileName = "";
 }
 
 //_____________________________________________________________________________
@@ -125,20 +149,22 @@ Bool_t Options::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const Options& r = static_cast<const Options&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const Options& r = dynamic_cast<const Options&>(other); 
-    // check members
-    if(mHelp        != r.help())             return kFalse;
-    if(mVersion     != r.version())          return kFalse;
-    if(mBatch       != r.copyright())        return kFalse;
-    if(mBatch       != r.batch())            return kFalse;
-    if(mProgName    != r.progName())         return kFalse;
-    if(mInFileName  != r.inFileName())       return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(mHelp        != r.help())             return kFalse;
+  if(mVersion     != r.version())          return kFalse;
+  if(mBatch       != r.copyright())        return kFalse;
+  if(mBatch       != r.batch())            return kFalse;
+  if(mProgName    != r.progName())         return kFalse;
+  if(mInFileName  != r.inFileName())       return kFalse;
+  if(mScriptFileName != r.scriptFileName()) return kFalse;
+  if(mOutFileName    != r.outFileName())    return kFalse;
+  if(mDashboard      != r.dashboard())      return kFalse;
+  if(mBinaryLogFileName != r.binaryLogFileName()) return kFalse;
+  return kTrue;
 }
 
 //_____________________________________________________________________________
@@ -169,7 +195,12 @@ void Options::set(Int_t argc, Char_t** argv)
       {"version",             no_argument,       0, 'v'},
       {"license",             no_argument,       0, 'L'},
       {"batch",               no_argument,       0, 'b'},
+      {"script",              required_argument, 0, 's'},
+      {"output",              required_argument, 0, 'o'},
+      {"dashboard",           no_argument,       0, 'd'},
+      {"binary-log",          required_argument, 0, 'B'},
       {"print-level",         required_argument, 0, 'p'},
+      {"print-topics",        required_argument, 0, 'T'},
       {0, 0, 0, 0}
     };
 
@@ -179,7 +210,7 @@ void Options::set(Int_t argc, Char_t** argv)
   while(1){
     // GNU getopt_long parser
     // '' = no argument, ':' = required argument, '::' = optional argument
-    optChar = getopt_long(argc, argv, "vLh?bp:", gGnuLongOpts, &optIdx);
+    optChar = getopt_long(argc, argv, "vLh?bs:o:dB:p:T:", gGnuLongOpts, &optIdx);
     
     // Detect the end of the options.
     if(optChar == -1) break;
@@ -206,6 +237,23 @@ void Options::set(Int_t argc, Char_t** argv)
 	break;
       }
 
+    case 's': 
+      mBatch = kTrue; 
+      mScriptFileName = string(optarg);
+      break;
+
+    case 'o': 
+      mOutFileName = string(optarg);
+      break;
+
+    case 'd': 
+      mDashboard = kTrue; 
+      break;
+
+    case 'B': 
+      mBinaryLogFileName = string(optarg);
+      break;
+
     case 'p': 
       {
 	string pl(optarg);
@@ -229,6 +277,14 @@ void Options::set(Int_t argc, Char_t** argv)
 	break;
       }
 
+    case 'T': 
+      try{ SetLogTopics(LogTopics(optarg)); }
+      catch(const Exception& e){
+	loutW(InputArguments) << "Options::set: " << e.what() << " Using all print-topics." << endl;
+	SetLogTopics(kAllLogTopics);
+      }
+      break;
+
     default:
       throw Exception("Options::set: PC LOAD LETTER.");
     } // end option switch
@@ -267,7 +323,19 @@ void Options::PrintOptions(std::ostream& os)
   os << "  -L|--license              false       Print the license/copyright and exit." << endl;
   // os << "  -p|--print-level          Info        The logging verbosity of the program:" << endl;
   // os << "                                        Debug (loudest), Info, Progress, Warning, Error, Fatal, Silent" << endl;
-  // os << "  -b|--batch                false       Run in batch (silent) mode." << endl;
+  os << "  -T|--print-topics list    All         Topics of progress, info & debug messages, e.g." << endl;
+  os << "                                        Evaluation,DataHandling (or a mask, e.g. 20)" << endl;
+  os << "  -b|--batch                false       Run in batch mode: commands are read from the script," << endl;
+  os << "                                        results written one JSON object per line." << endl;
+  os << "  -s|--script file          stdin       Batch script (implies --batch)." << endl;
+  os << "  -o|--output file          stdout      Batch results." << endl;
+  os << "  -d|--dashboard            false       Batch tournaments show a live dashboard on stderr." << endl;
+  os << "  -B|--binary-log file      none        Log binary records to the file instead of text" << endl;
+  os << "                                        (rendered by blobb-logdump)." << endl;
+  os << "Batch commands:" << endl;
+  os << "  load file | save file | save-delta file base |" << endl;
+  os << "  register name p a i pe h [title] |" << endl;
+  os << "  fight name1 name2 | tournament [name ...] | warriors | quit" << endl;
 }
 
 
@@ -8,6 +8,9 @@
 #include "blobb/ClassImp.hh"   // blobb class implementation
 #include "blobb/Random.hh"     // random number
 #include "blobb/CLUI.hh"       // command-line user interface
+#include "blobb/Hash.hh"       // content hashing
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
+#include "blobb/Format.hh"     // formatting into buffers
 
 //! Blobb class implementation macro
 BLOBB_CLASS_IMP(Parameter)
@@ -70,6 +73,7 @@ void Parameter::clear()
   mError = 0.;
   mMin   = 0.;
   mMax   = 0.;
+  invalidateHash();
 }
 
 //_____________________________________________________________________________
@@ -78,19 +82,17 @@ Bool_t Parameter::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const Parameter& p = static_cast<const Parameter&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const Parameter& p = dynamic_cast<const Parameter&>(other); 
-    // check members
-    if(!Named::isEqual(p))  return kFalse;
-    if(mValue != p.value()) return kFalse;
-    if(mError != p.error()) return kFalse;
-    if(mMin   != p.min())   return kFalse;
-    if(mMax   != p.max())   return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(!Named::isEqual(p))  return kFalse;
+  if(mValue != p.value()) return kFalse;
+  if(mError != p.error()) return kFalse;
+  if(mMin   != p.min())   return kFalse;
+  if(mMax   != p.max())   return kFalse;
+  return kTrue;
 }
 
 //_____________________________________________________________________________
@@ -99,6 +101,7 @@ void Parameter::set(Double_t value, Double_t error)
 {
   mValue = value;
   mError = error;
+  invalidateHash();
 }
 
 //_____________________________________________________________________________
@@ -115,6 +118,31 @@ void Parameter::setRange(Double_t min, Double_t max)
 {
   mMin = min;
   mMax = max;
+  invalidateHash();
+}
+
+//_____________________________________________________________________________
+/** Compute the content hash of name, title, value, error and range. */
+ULong_t Parameter::computeHash() const
+{
+  ULong_t h = Named::computeHash();
+  h = HashDouble(h, mValue);
+  h = HashDouble(h, mError);
+  h = HashDouble(h, mMin);
+  return HashDouble(h, mMax);
+}
+
+//_____________________________________________________________________________
+/** Write name, title, value, error and range to a streaming writer. */
+void Parameter::stream(StreamWriter& sw) const
+{
+  sw.startNode("Named");
+  Named::stream(sw);
+  sw.finishNode();
+  sw.value("Value", mValue);
+  sw.value("Error", mError);
+  sw.value("Min", mMin);
+  sw.value("Max", mMax);
 }
 
 //_____________________________________________________________________________
@@ -128,14 +156,18 @@ Double_t Parameter::getRandom(const Random& random)
 //! Interface to print value of object
 void Parameter::printValue(ostream& os) const
 {
-  os << mValue << " +/- " << mError;
+  Char_t storage[64];
+  FormatBuffer fb(os, storage, sizeof(storage));
+  fb << mValue << " +/- " << mError;
 }
 
 //_____________________________________________________________________________
 //! Interface to print extras
 void Parameter::printExtras(ostream& os) const
 {
-  os << "[" << mMin << ", " << mMax << "]";
+  Char_t storage[64];
+  FormatBuffer fb(os, storage, sizeof(storage));
+  fb << '[' << mMin << ", " << mMax << ']';
 }
 
 //_____________________________________________________________________________
@@ -155,6 +187,7 @@ Bool_t Parameter::readFromUI(CLUI& clui, Bool_t verbose)
     clui.request(name()+" Error");
     mError = clui.readDouble();
   }
+  invalidateHash();
   return kTrue;
 }
 
@@ -168,10 +201,36 @@ void Parameter::printToUI(CLUI& clui, Bool_t /*verbose*/) const
   if(hasTitle()) clui.os(kFalse) << " (" << title() << ")";
 
   // values
-  clui.os(kFalse) << " = ";
-  clui.os(kFalse) << mValue << " +/- " << mError;
-  if(isFree()) clui.os(kFalse) << " [" << mMin << ", " << mMax << "]";
+  {
+    Char_t storage[128];
+    FormatBuffer fb(clui.os(kFalse), storage, sizeof(storage));
+    fb << " = " << mValue << " +/- " << mError;
+    if(isFree()) fb << " [" << mMin << ", " << mMax << ']';
+  }
   clui.os(kFalse) << endl;
 }
 
+//_____________________________________________________________________________
+/** cerealize to a portable binary archive: the same bytes as serialize, 
+    with the values written as one block. */
+void Parameter::serialize(cereal::PortableBinaryOutputArchive& ar)
+{
+  Double_t values[4] = {mValue, mError, mMin, mMax};
+  ar(cereal::base_class<Named>(this), cereal::binary_data(&values[0], sizeof(values)));
+}
+
+//_____________________________________________________________________________
+/** cerealize from a portable binary archive: the values are read as one 
+    block, byte-swapped only if the archive's endianness differs. */
+void Parameter::serialize(cereal::PortableBinaryInputArchive& ar)
+{
+  Double_t values[4];
+  ar(cereal::base_class<Named>(this), cereal::binary_data(&values[0], sizeof(values)));
+  mValue = values[0];
+  mError = values[1];
+  mMin   = values[2];
+  mMax   = values[3];
+  invalidateHash();
+}
+
 } // end namespace Blobb
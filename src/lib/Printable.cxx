@@ -6,6 +6,7 @@
 */
 #include "blobb/Printable.hh"  // this class
 #include "blobb/CLUI.hh"       // command-line user interface
+#include "blobb/Sink.hh"       // output sinks
 #include <iomanip>             // cplusplus.com/reference/iomanip/
 
 namespace Blobb {
@@ -92,6 +93,13 @@ void Printable::print(CLUI& clui, const string& indent) const
   print(clui.os(), indent);
 }
 
+//_____________________________________________________________________________
+//! Print object to an output sink.
+void Printable::print(Sink& sink, const string& indent) const
+{
+  print(sink.os(), indent);
+}
+
 //_____________________________________________________________________________
 //! Print object to std::cout.
 void Printable::print(const string& indent) const
@@ -8,6 +8,8 @@
 #include "blobb/ClassImp.hh"  // blobb class implementation
 #include "blobb/CLUI.hh"      // command-line user interface
 #include "blobb/Math.hh"      // math helpers
+#include "blobb/Hash.hh"      // content hashing
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
 
 //! Blobb class implementation macro
 BLOBB_CLASS_IMP(Random)
@@ -75,16 +77,29 @@ Bool_t Random::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const Random& n = static_cast<const Random&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const Random& n = dynamic_cast<const Random&>(other); 
-    // check members
-    if(mSeed    != n.seed())  return kFalse;
-    if(mNumIter != n.numIter()) return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(mSeed    != n.seed())  return kFalse;
+  if(mNumIter != n.numIter()) return kFalse;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Content hash of seed and number of iterations. */
+ULong_t Random::hash() const
+{
+  return HashCombine(HashCombine(ClassId(), mSeed), mNumIter);
+}
+
+//_____________________________________________________________________________
+/** Write seed & number of iterations to a streaming writer. */
+void Random::stream(StreamWriter& sw) const
+{
+  sw.value("Seed", mSeed);
+  sw.value("NumIter", mNumIter);
 }
 
 //_____________________________________________________________________________
@@ -0,0 +1,213 @@
+/** \file      src/lib/RosterIndex.cxx
+    \brief     Source for RosterIndex
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/RosterIndex.hh"  // this class
+#include "blobb/Exception.hh"    // exception handler
+#include <algorithm>             // cplusplus.com/reference/algorithm/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Default constructor. */
+RosterIndex::RosterIndex()
+  : mNames(),
+    mRows(),
+    mColumns()
+{}
+
+//_____________________________________________________________________________
+/** Constructor from a roster. */
+RosterIndex::RosterIndex(const Warriors_t& wars)
+  : mNames(),
+    mRows(),
+    mColumns()
+{
+  rebuild(wars);
+}
+
+//_____________________________________________________________________________
+/** Remove all rows. */
+void RosterIndex::clear()
+{
+  mNames.clear();
+  mRows.clear();
+  for(Pos_t c=0; c<2*kNumAttributes; c++) mColumns[c].clear();
+}
+
+//_____________________________________________________________________________
+/** Re-build all rows from a roster.
+    Rows follow the (name) order of the roster.
+*/
+void RosterIndex::rebuild(const Warriors_t& wars)
+{
+  clear();
+  mNames.reserve(wars.size());
+  mRows.reserve(wars.size());
+  for(Pos_t c=0; c<2*kNumAttributes; c++) mColumns[c].resize(wars.size());
+  for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it){
+    mRows[it->first] = mNames.size();
+    mNames.push_back(it->first);
+    setRow(mNames.size()-1, it->second);
+  }
+}
+
+//_____________________________________________________________________________
+/** Insert (append) or update the row of the warrior registered as name. */
+void RosterIndex::update(const string& name, const Warrior& war)
+{
+  std::unordered_map<string,Pos_t>::const_iterator it = mRows.find(name);
+  if(it != mRows.end()){
+    setRow(it->second, war);
+    return;
+  }
+  mRows[name] = mNames.size();
+  mNames.push_back(name);
+  for(Pos_t c=0; c<2*kNumAttributes; c++) mColumns[c].push_back(0.);
+  setRow(mNames.size()-1, war);
+}
+
+//_____________________________________________________________________________
+/** Remove the row of a warrior name.
+    The last row is moved into the freed row.
+    \return true if a row was removed. */
+Bool_t RosterIndex::remove(const string& name)
+{
+  std::unordered_map<string,Pos_t>::iterator it = mRows.find(name);
+  if(it == mRows.end()) return kFalse;
+  Pos_t row = it->second;
+  Pos_t last = mNames.size()-1;
+  mRows.erase(it);
+  if(row != last){
+    mNames[row] = mNames[last];
+    mRows[mNames[row]] = row;
+    for(Pos_t c=0; c<2*kNumAttributes; c++) mColumns[c][row] = mColumns[c][last];
+  }
+  mNames.pop_back();
+  for(Pos_t c=0; c<2*kNumAttributes; c++) mColumns[c].pop_back();
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Rows passing a single cut. */
+vector<Pos_t> RosterIndex::select(const Cut& cut) const
+{
+  return select(vector<Cut>(1, cut));
+}
+
+//_____________________________________________________________________________
+/** Rows passing all (AND-ed) cuts, in row order.
+    E.g. prowess > 70 and health < 40:
+    \code
+    vector<RosterIndex::Cut> cuts;
+    cuts.push_back(RosterIndex::Cut(RosterIndex::kProwess, 70.));
+    cuts.push_back(RosterIndex::Cut(RosterIndex::kHealth, kMinD, 40.));
+    vector<Pos_t> rows = index.select(cuts);
+    \endcode
+*/
+vector<Pos_t> RosterIndex::select(const vector<Cut>& cuts) const
+{
+  // branch-free mask over each column (vectorizes)
+  const Pos_t n = size();
+  vector<UChar_t> mask(n, 1);
+  UChar_t* m = mask.data();
+  for(Pos_t c=0; c<cuts.size(); c++){
+    const Double_t* v = mColumns[columnNumber(cuts[c].mAttribute, cuts[c].mField)].data();
+    const Double_t lo = cuts[c].mMin;
+    const Double_t hi = cuts[c].mMax;
+    for(Pos_t i=0; i<n; i++)
+      m[i] &= UChar_t((v[i] > lo) & (v[i] < hi));
+  }
+
+  // gather rows
+  vector<Pos_t> rows;
+  for(Pos_t i=0; i<n; i++)
+    if(m[i]) rows.push_back(i);
+  return rows;
+}
+
+//_____________________________________________________________________________
+/** All rows sorted by an attribute field (ascending by default). */
+vector<Pos_t> RosterIndex::sorted(eAttribute attribute, Bool_t descending,
+				  eField field) const
+{
+  const vector<Double_t>& v = column(attribute, field);
+  vector<Pos_t> rows(size());
+  for(Pos_t i=0; i<rows.size(); i++) rows[i] = i;
+  if(descending)
+    std::stable_sort(rows.begin(), rows.end(),
+		     [&v](Pos_t a, Pos_t b){ return v[a] > v[b]; });
+  else
+    std::stable_sort(rows.begin(), rows.end(),
+		     [&v](Pos_t a, Pos_t b){ return v[a] < v[b]; });
+  return rows;
+}
+
+//_____________________________________________________________________________
+/** The k rows with the largest attribute field, in descending order. */
+vector<Pos_t> RosterIndex::top(eAttribute attribute, Pos_t k, eField field) const
+{
+  const vector<Double_t>& v = column(attribute, field);
+  vector<Pos_t> rows(size());
+  for(Pos_t i=0; i<rows.size(); i++) rows[i] = i;
+  if(k > rows.size()) k = rows.size();
+  std::partial_sort(rows.begin(), rows.begin()+k, rows.end(),
+		    [&v](Pos_t a, Pos_t b){ return v[a] > v[b] || (v[a] == v[b] && a < b); });
+  rows.resize(k);
+  return rows;
+}
+
+//_____________________________________________________________________________
+/** Warrior names of rows. */
+vector<string> RosterIndex::names(const vector<Pos_t>& rows) const
+{
+  vector<string> nms;
+  nms.reserve(rows.size());
+  for(Pos_t i=0; i<rows.size(); i++) nms.push_back(mNames.at(rows[i]));
+  return nms;
+}
+
+//_____________________________________________________________________________
+/** Get the warrior parameter for an attribute. */
+const Parameter& RosterIndex::GetAttribute(const Warrior& war, eAttribute attribute)
+{
+  switch(attribute){
+  case kProwess:      return war.mProwess;
+  case kAgility:      return war.mAgility;
+  case kIntelligence: return war.mIntelligence;
+  case kPersonality:  return war.mPersonality;
+  case kHealth:       return war.mHealth;
+  default: throw Exception("RosterIndex::GetAttribute: Undefined attribute enumeration.");
+  }
+}
+
+//_____________________________________________________________________________
+/** Get the attribute name, as in the warrior parameter name. */
+string RosterIndex::GetAttributeName(eAttribute attribute)
+{
+  return GetAttribute(Warrior(), attribute).name();
+}
+
+//_____________________________________________________________________________
+/** Column number of an attribute field. */
+Pos_t RosterIndex::columnNumber(eAttribute attribute, eField field) const
+{
+  if(attribute < 0 || attribute >= kNumAttributes)
+    throw Exception("RosterIndex::column: Undefined attribute enumeration.");
+  return 2*attribute + (field == kError ? 1 : 0);
+}
+
+//_____________________________________________________________________________
+/** Fill a row from a warrior. */
+void RosterIndex::setRow(Pos_t row, const Warrior& war)
+{
+  for(Int_t a=0; a<kNumAttributes; a++){
+    const Parameter& p = GetAttribute(war, eAttribute(a));
+    mColumns[2*a  ][row] = p.value();
+    mColumns[2*a+1][row] = p.error();
+  }
+}
+
+} // end namespace Blobb
@@ -0,0 +1,35 @@
+/** \file      src/lib/SharedOutput.cxx
+    \brief     Source for writing to streams shared between threads
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/SharedOutput.hh"  // these methods
+#include <cstdint>                // cplusplus.com/reference/cstdint/
+#include <mutex>                  // cplusplus.com/reference/mutex/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+//! Number of stream locks; streams are hashed onto them.
+static const Pos_t gNumStreamLocks = 16;
+
+//_____________________________________________________________________________
+//! Lock of a stream buffer.
+static std::mutex& StreamLock(const std::streambuf* buf)
+{
+  static std::mutex locks[gNumStreamLocks];
+  std::uintptr_t key = reinterpret_cast<std::uintptr_t>(buf);
+  return locks[(key >> 4) % gNumStreamLocks];
+}
+
+//_____________________________________________________________________________
+/** Write & flush a block under the lock of the stream's buffer. */
+void WriteShared(ostream& os, CChar_t* data, ULong_t size)
+{
+  std::lock_guard<std::mutex> lock(StreamLock(os.rdbuf()));
+  if(size > 0) os.write(data, std::streamsize(size));
+  os.flush();
+}
+
+} // end namespace Blobb
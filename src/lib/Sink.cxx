@@ -0,0 +1,277 @@
+/** \file      src/lib/Sink.cxx
+    \brief     Source for the output sinks
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Sink.hh"        // these classes
+#include "blobb/LogService.hh"  // logging
+#include <cerrno>               // cplusplus.com/reference/cerrno/
+#include <cstring>              // cplusplus.com/reference/cstring/
+
+#ifdef HAVE_UNISTD_H
+  #include <unistd.h>           // write, close
+#endif
+#ifdef HAVE_SYS_UIO_H
+  #include <sys/uio.h>          // writev
+#endif
+
+namespace Blobb {
+
+const Pos_t BufferedSink::DefBufferSize = 1 << 16;
+
+//_____________________________________________________________________________
+/** Constructor. */
+Sink::Sink()
+  : std::streambuf(),
+    mOs(this)
+{}
+
+//_____________________________________________________________________________
+/** Constructor; the stream is set bad. */
+NullSink::NullSink()
+  : Sink()
+{
+  mOs.setstate(std::ios::badbit);
+}
+
+//_____________________________________________________________________________
+//! Discard a character
+NullSink::int_type NullSink::overflow(int_type c)
+{
+  return traits_type::not_eof(c);
+}
+
+//_____________________________________________________________________________
+//! Discard n characters
+std::streamsize NullSink::xsputn(const char_type*, std::streamsize n)
+{
+  return n;
+}
+
+//_____________________________________________________________________________
+/** Constructor; reserve memory for the output [bytes]. */
+MemorySink::MemorySink(Pos_t reserve)
+  : Sink(),
+    mText()
+{
+  mText.reserve(reserve);
+}
+
+//_____________________________________________________________________________
+//! Append a character
+MemorySink::int_type MemorySink::overflow(int_type c)
+{
+  if(!traits_type::eq_int_type(c, traits_type::eof())) mText += traits_type::to_char_type(c);
+  return traits_type::not_eof(c);
+}
+
+//_____________________________________________________________________________
+//! Append n characters
+std::streamsize MemorySink::xsputn(const char_type* s, std::streamsize n)
+{
+  mText.append(s, n);
+  return n;
+}
+
+//_____________________________________________________________________________
+/** Constructor.
+    \param bufferSize Size of the buffer [bytes]. */
+BufferedSink::BufferedSink(Pos_t bufferSize)
+  : Sink(),
+    mBuffer(bufferSize > 0 ? bufferSize : 1),
+    mNumWrites(0)
+{
+  setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+}
+
+//_____________________________________________________________________________
+//! Buffer full: write it out, then buffer c
+BufferedSink::int_type BufferedSink::overflow(int_type c)
+{
+  if(!drain()) return traits_type::eof();
+  if(!traits_type::eq_int_type(c, traits_type::eof())){
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+//_____________________________________________________________________________
+//! Write n characters; if they do not fit, written out with the buffer
+std::streamsize BufferedSink::xsputn(const char_type* s, std::streamsize n)
+{
+  if(n > epptr() - pptr()) return (drain(s, ULong_t(n)) ? n : 0);
+  memcpy(pptr(), s, n);
+  pbump(Int_t(n));
+  return n;
+}
+
+//_____________________________________________________________________________
+//! Write the buffer out
+int BufferedSink::sync()
+{
+  return (drain() ? 0 : -1);
+}
+
+//_____________________________________________________________________________
+/** Write the buffer, then the block (if any), out; the buffer is emptied.
+    \return "success" boolean. */
+Bool_t BufferedSink::drain(CChar_t* block, ULong_t size)
+{
+  ULong_t buffered = pptr() - pbase();
+  if(buffered == 0 && size == 0) return kTrue;
+  Bool_t success = writeOut(pbase(), buffered, block, size);
+  mNumWrites++;
+  setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+  return success;
+}
+
+//_____________________________________________________________________________
+/** Constructor; no file open. */
+FileSink::FileSink(Pos_t bufferSize)
+  : BufferedSink(bufferSize),
+    mFile(0),
+    mFileName("")
+{}
+
+//_____________________________________________________________________________
+/** Constructor; the file is opened (see open). */
+FileSink::FileSink(const string& fileName, Bool_t append, Pos_t bufferSize)
+  : BufferedSink(bufferSize),
+    mFile(0),
+    mFileName("")
+{
+  open(fileName, append);
+}
+
+//_____________________________________________________________________________
+/** Destructor; the file is closed. */
+FileSink::~FileSink()
+{
+  close();
+}
+
+//_____________________________________________________________________________
+/** Open a file, truncated or appended to; an open file is closed first.
+    \return "success" boolean. */
+Bool_t FileSink::open(const string& fileName, Bool_t append)
+{
+  close();
+  mFileName = fileName;
+  mFile = std::fopen(fileName.c_str(), (append ? "ab" : "wb"));
+  if(!mFile){
+    loutE(DataHandling) << "FileSink::open: Failed to open file '" << fileName << "'." << endl;
+    return kFalse;
+  }
+  // the sink buffers
+  std::setvbuf(mFile, 0, _IONBF, 0);
+  mOs.clear();
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Write the buffer out and close the file, if open.
+    \return "success" boolean: false if a write failed. */
+Bool_t FileSink::close()
+{
+  if(!mFile) return kTrue;
+  Bool_t success = (pubsync() == 0);
+  success &= (std::fclose(mFile) == 0);
+  mFile = 0;
+  if(!success) loutE(DataHandling) << "FileSink::close: Failed to write file '" << mFileName << "'." << endl;
+  return success;
+}
+
+//_____________________________________________________________________________
+//! Write the data & block to the file
+Bool_t FileSink::writeOut(CChar_t* data, ULong_t size, CChar_t* block, ULong_t blockSize)
+{
+  if(!mFile) return kFalse;
+  if(size > 0 && std::fwrite(data, 1, size, mFile) != size) return kFalse;
+  if(blockSize > 0 && std::fwrite(block, 1, blockSize, mFile) != blockSize) return kFalse;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Constructor.
+    \param owned Close the descriptor at destruction? */
+FdSink::FdSink(Int_t fd, Bool_t owned, Pos_t bufferSize)
+  : BufferedSink(bufferSize),
+    mFd(fd),
+    mOwned(owned)
+{
+#ifndef HAVE_UNISTD_H
+  loutE(DataHandling) << "FdSink: <unistd.h> not found." << endl;
+  mOs.setstate(std::ios::badbit);
+#endif
+}
+
+//_____________________________________________________________________________
+/** Destructor; the buffer is written out. */
+FdSink::~FdSink()
+{
+  pubsync();
+#ifdef HAVE_UNISTD_H
+  if(mOwned) ::close(mFd);
+#endif
+}
+
+//_____________________________________________________________________________
+//! Write the data & block to the descriptor, gathered; retried until done
+Bool_t FdSink::writeOut(CChar_t* data, ULong_t size, CChar_t* block, ULong_t blockSize)
+{
+#if defined(HAVE_UNISTD_H) && defined(HAVE_SYS_UIO_H)
+  struct iovec iov[2];
+  Int_t num(0);
+  if(size > 0){
+    iov[num].iov_base = const_cast<Char_t*>(data);
+    iov[num].iov_len = size;
+    num++;
+  }
+  if(blockSize > 0){
+    iov[num].iov_base = const_cast<Char_t*>(block);
+    iov[num].iov_len = blockSize;
+    num++;
+  }
+  struct iovec* next = iov;
+  while(num > 0){
+    ssize_t written = writev(mFd, next, num);
+    if(written < 0){
+      if(errno == EINTR) continue;
+      return kFalse;
+    }
+    // skip the pieces written, then the part written of the next
+    while(num > 0 && ULong_t(written) >= next->iov_len){
+      written -= next->iov_len;
+      next++;
+      num--;
+    }
+    if(num > 0){
+      next->iov_base = static_cast<Char_t*>(next->iov_base) + written;
+      next->iov_len -= written;
+    }
+  }
+  return kTrue;
+#elif defined(HAVE_UNISTD_H)
+  CChar_t* pieces[2] = {data, block};
+  ULong_t sizes[2] = {size, blockSize};
+  for(Int_t p=0; p<2; p++){
+    while(sizes[p] > 0){
+      ssize_t written = ::write(mFd, pieces[p], sizes[p]);
+      if(written < 0){
+	if(errno == EINTR) continue;
+	return kFalse;
+      }
+      pieces[p] += written;
+      sizes[p] -= written;
+    }
+  }
+  return kTrue;
+#else
+  (void)data; (void)size; (void)block; (void)blockSize;
+  return kFalse;
+#endif
+}
+
+} // end namespace Blobb
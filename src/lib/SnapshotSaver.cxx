@@ -0,0 +1,123 @@
+/** \file      src/lib/SnapshotSaver.cxx
+    \brief     Source for SnapshotSaver
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/SnapshotSaver.hh"  // this class
+#include "blobb/StringTools.hh"    // string tools
+#include "blobb/LogService.hh"     // logging
+#include <cstdio>                  // cplusplus.com/reference/cstdio/
+
+#ifdef HAVE_UNISTD_H
+  #include <unistd.h>              // fsync, close
+  #include <fcntl.h>               // open
+#endif // end HAVE_UNISTD_H
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Constructor. */
+SnapshotSaver::SnapshotSaver()
+  : mFileName(""),
+    mThread(),
+    mBusy(kFalse),
+    mSuccess(kTrue)
+{}
+
+//_____________________________________________________________________________
+/** Destructor; waits for a running save. */
+SnapshotSaver::~SnapshotSaver()
+{
+  wait();
+}
+
+//_____________________________________________________________________________
+/** Start saving to fileName in the background; waits for a running save 
+    first. The writer must not refer to data modified meanwhile.
+    \return "success" boolean: true if started. */
+Bool_t SnapshotSaver::start(const string& fileName, const Writer_t& writer, 
+			    const Done_t& done)
+{
+  wait();
+  mFileName = fileName;
+  mSuccess = kFalse;
+  mBusy = kTrue;
+  try{
+    mThread = std::thread([this, fileName, writer, done](){
+	string tmp = TempName(fileName);
+	Bool_t ok = writer(tmp) && SyncFile(tmp);
+	if(ok && rename(tmp.c_str(), fileName.c_str()) != 0){
+	  loutE(DataHandling) << "SnapshotSaver: Failed to replace '" << fileName << "'." << endl;
+	  ok = kFalse;
+	}
+	if(!ok) remove(tmp.c_str());
+	else ok = SyncDir(fileName);
+	if(done) done(fileName, ok);
+	mSuccess = ok;
+	mBusy = kFalse;
+      });
+  }
+  catch(std::exception& e){
+    loutE(DataHandling) << "SnapshotSaver: Failed to start saving '" << fileName 
+			<< "'; " << e.what() << endl;
+    mBusy = kFalse;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Wait for a running save.
+    \return "success" boolean: true if the last save succeeded. */
+Bool_t SnapshotSaver::wait()
+{
+  if(mThread.joinable()) mThread.join();
+  return mSuccess;
+}
+
+//_____________________________________________________________________________
+/** Temporary file of a save: same directory & extension as the target. */
+string SnapshotSaver::TempName(const string& fileName)
+{
+  return GetFileDir(fileName) + GetFileBase(fileName) + ".part" + GetFileExt(fileName);
+}
+
+//_____________________________________________________________________________
+/** Write a file's data to disk (fsync, where available).
+    \return "success" boolean: true if synced. */
+Bool_t SnapshotSaver::SyncFile(const string& fileName)
+{
+  FILE* file = fopen(fileName.c_str(), "rb");
+  if(!file){
+    loutE(DataHandling) << "SnapshotSaver: Cannot open '" << fileName << "' to sync." << endl;
+    return kFalse;
+  }
+  Bool_t ok(kTrue);
+#ifdef HAVE_UNISTD_H
+  ok = (fsync(fileno(file)) == 0);
+  if(!ok) loutE(DataHandling) << "SnapshotSaver: Failed to sync '" << fileName << "'." << endl;
+#endif // end HAVE_UNISTD_H
+  fclose(file);
+  return ok;
+}
+
+//_____________________________________________________________________________
+/** Write the directory entry of a file to disk (fsync of its directory,
+    where available), e.g. to make a rename over it durable.
+    \return "success" boolean: true if synced. */
+Bool_t SnapshotSaver::SyncDir(const string& fileName)
+{
+  Bool_t ok(kTrue);
+#ifdef HAVE_UNISTD_H
+  string dir = GetFileDir(fileName);
+  if(dir == "") dir = ".";
+  int fd = open(dir.c_str(), O_RDONLY);
+  ok = (fd >= 0 && fsync(fd) == 0);
+  if(fd >= 0) close(fd);
+  if(!ok) loutE(DataHandling) << "SnapshotSaver: Failed to sync directory '" << dir << "'." << endl;
+#endif // end HAVE_UNISTD_H
+  return ok;
+}
+
+} // end namespace Blobb
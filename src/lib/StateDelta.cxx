@@ -0,0 +1,265 @@
+/** \file      src/lib/StateDelta.cxx
+    \brief     Source for StateDelta
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/StateDelta.hh"   // this class
+#include "blobb/ClassImp.hh"     // blobb class implementation
+#include "blobb/Exception.hh"    // exception handler
+#include "blobb/LogService.hh"   // logging
+#include "blobb/StringTools.hh"  // string tools
+#include <set>                   // cplusplus.com/reference/set/
+
+//! Blobb class implementation macro
+BLOBB_CLASS_IMP(StateDelta)
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+//! Base-name suffix of delta files.
+static const string gDeltaSuffix(".delta");
+
+//_____________________________________________________________________________
+/** Default constructor. */
+StateDelta::StateDelta()
+  : Named("StateDelta", "BloBB state delta"),
+    mBaseFileName(""),
+    mBaseHash(0),
+    mStateHash(0),
+    mStartTime(-1),
+    mEndTime(-1),
+    mRandom(),
+    mChanged(),
+    mRemoved()
+{}
+
+//_____________________________________________________________________________
+/** Constructor; the changes of state since base. */
+StateDelta::StateDelta(const BloBB& base, const BloBB& state, const string& baseFileName)
+  : StateDelta()
+{
+  mBaseFileName = baseFileName;
+  compute(base, state);
+}
+
+//_____________________________________________________________________________
+/** Copy constructor. */
+StateDelta::StateDelta(const StateDelta& other, const string& newName)
+  : Named(other),
+    mBaseFileName(other.mBaseFileName),
+    mBaseHash(other.mBaseHash),
+    mStateHash(other.mStateHash),
+    mStartTime(other.mStartTime),
+    mEndTime(other.mEndTime),
+    mRandom(other.mRandom),
+    mChanged(other.mChanged),
+    mRemoved(other.mRemoved)
+{
+  if(newName != "")
+    setName(newName);
+}
+
+//_____________________________________________________________________________
+/** Assignment operator. */
+StateDelta& StateDelta::operator=(const StateDelta& rhs)
+{
+  Named::operator=(rhs);
+  mBaseFileName = rhs.mBaseFileName;
+  mBaseHash     = rhs.mBaseHash;
+  mStateHash    = rhs.mStateHash;
+  mStartTime    = rhs.mStartTime;
+  mEndTime      = rhs.mEndTime;
+  mRandom       = rhs.mRandom;
+  mChanged      = rhs.mChanged;
+  mRemoved      = rhs.mRemoved;
+  return *this;
+}
+
+//_____________________________________________________________________________
+/** No warrior added, changed or removed? */
+Bool_t StateDelta::isEmpty() const
+{
+  return mChanged.empty() && mRemoved.empty();
+}
+
+//_____________________________________________________________________________
+/** Forget all changes. */
+void StateDelta::clear()
+{
+  mBaseHash = 0;
+  mStateHash = 0;
+  mChanged.clear();
+  mRemoved.clear();
+}
+
+//_____________________________________________________________________________
+/** Equivalence. */
+Bool_t StateDelta::isEqual(const AbsObject& other) const
+{
+  // check pointer
+  if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const StateDelta& d = static_cast<const StateDelta&>(other);
+  // check members
+  if(!Named::isEqual(d))                 return kFalse;
+  if(mBaseFileName != d.baseFileName())  return kFalse;
+  if(mBaseHash     != d.baseHash())      return kFalse;
+  if(mStateHash    != d.stateHash())     return kFalse;
+  if(mStartTime    != d.mStartTime)      return kFalse;
+  if(mEndTime      != d.mEndTime)        return kFalse;
+  if(mRandom       != d.mRandom)         return kFalse;
+  if(mChanged      != d.changed())       return kFalse;
+  if(mRemoved      != d.removed())       return kFalse;
+  return kTrue;
+}
+
+//_____________________________________________________________________________
+/** Compute the changes of state since base: warriors are matched by
+    name (both rosters are sorted) and compared by content; the content
+    hashes of both states are kept. */
+void StateDelta::compute(const BloBB& base, const BloBB& state)
+{
+  clear();
+  setNameTitle(state.name(), state.title());
+  mBaseHash  = base.hash();
+  mStateHash = state.hash();
+  mStartTime = state.startTime();
+  mEndTime   = state.endTime();
+  mRandom    = state.random();
+
+  Warriors_t::const_iterator b = base.warriors().begin(), bEnd = base.warriors().end();
+  Warriors_t::const_iterator s = state.warriors().begin(), sEnd = state.warriors().end();
+  while(b != bEnd || s != sEnd){
+    if(s == sEnd || (b != bEnd && b->first < s->first)){
+      mRemoved.push_back(b->first);
+      ++b;
+    }
+    else if(b == bEnd || s->first < b->first){
+      mChanged.insert(mChanged.end(), *s);
+      ++s;
+    }
+    else{
+      if(!(b->second == s->second)) mChanged.insert(mChanged.end(), *s);
+      ++b;
+      ++s;
+    }
+  }
+}
+
+//_____________________________________________________________________________
+/** Apply the changes to the base state.
+    \param check Check the content hashes of the base and of the result.
+    \warning Throws Exception if state is not the base, or if the result
+    is not the saved state. */
+void StateDelta::apply(BloBB& state, Bool_t check) const
+{
+  if(check && state.hash() != mBaseHash)
+    throw Exception("StateDelta::apply: The state is not the base of the delta.");
+  state.setNameTitle(name(), title());
+  state.setStartTime(mStartTime);
+  state.setEndTime(mEndTime);
+  state.setRandom(mRandom);
+  Warriors_t& wars = state.warriors();
+  for(vector<string>::const_iterator it = mRemoved.begin(); it != mRemoved.end(); ++it)
+    wars.erase(*it);
+  for(Warriors_t::const_iterator it = mChanged.begin(); it != mChanged.end(); ++it)
+    wars[it->first] = it->second;
+  state.reindex();
+  if(check && state.hash() != mStateHash)
+    throw Exception("StateDelta::apply: The rebuilt state differs from the saved one.");
+}
+
+//_____________________________________________________________________________
+/** Is this a delta file (".delta" suffix of the base name)? */
+Bool_t StateDelta::IsDeltaFile(const string& fileName)
+{
+  string base = GetFileBase(fileName);
+  return (base.size() > gDeltaSuffix.size() &&
+	  base.compare(base.size() - gDeltaSuffix.size(), gDeltaSuffix.size(), gDeltaSuffix) == 0);
+}
+
+//_____________________________________________________________________________
+/** Save the changes of state since the state in baseFileName (a full
+    save or a delta), which is loaded first.
+    \return "success" boolean: true if saved. */
+Bool_t StateDelta::Save(const BloBB& state, const string& fileName, const string& baseFileName)
+{
+  BloBB base;
+  if(!base.loadFile(baseFileName)){
+    loutE(InputArguments) << "StateDelta::Save: Failed to load the base '" << baseFileName
+			  << "', no delta written." << endl;
+    return kFalse;
+  }
+  return Save(state, fileName, base, baseFileName);
+}
+
+//_____________________________________________________________________________
+/** Save the changes of state since base, the state in baseFileName.
+    \return "success" boolean: true if saved. */
+Bool_t StateDelta::Save(const BloBB& state, const string& fileName,
+			const BloBB& base, const string& baseFileName)
+{
+  string ext = GetFileExt(fileName);
+  if(!IsDeltaFile(fileName) || !IsArchiveExt(ext) || GetArchiveTypeFromExt(ext) == kMapped){
+    loutE(InputArguments) << "StateDelta::Save: Delta files are named <name>" << gDeltaSuffix
+			  << "<ext>, not as a mapped roster; no delta written to '"
+			  << fileName << "'." << endl;
+    return kFalse;
+  }
+  // a base next to the delta is found from the delta's directory
+  string baseName = baseFileName;
+  if(GetFileDir(baseName) == GetFileDir(fileName))
+    baseName = baseName.substr(GetFileDir(baseName).size());
+  StateDelta delta(base, state, baseName);
+  loutI(DataHandling) << "Delta of " << delta.changed().size() << " changed & "
+		      << delta.removed().size() << " removed warrior(s) since "
+		      << baseFileName << endl;
+  return delta.save(fileName);
+}
+
+//_____________________________________________________________________________
+/** Load the state saved in a delta file: its chain of deltas is followed
+    back to a full save, which is loaded and the deltas applied in turn.
+    \return "success" boolean: true if loaded. */
+Bool_t StateDelta::Load(const string& fileName, BloBB& state)
+{
+  vector<StateDelta> chain;
+  std::set<string> seen;
+  string file = fileName;
+  while(IsDeltaFile(file)){
+    if(!seen.insert(file).second){
+      loutE(InputArguments) << "StateDelta::Load: The chain of '" << fileName
+			    << "' loops at '" << file << "'." << endl;
+      return kFalse;
+    }
+    chain.push_back(StateDelta());
+    if(!chain.back().load(file)) return kFalse;
+    string base = chain.back().baseFileName();
+    file = (GetFileDir(base) == "" ? GetFileDir(file) + base : base);
+  }
+  if(!state.loadFile(file)) return kFalse;
+  if(chain.empty()) return kTrue;
+
+  // each delta applies to the previous one's result: hashed at the ends only
+  Bool_t linked = (state.hash() == chain.back().baseHash());
+  for(Pos_t d=0; d+1<chain.size(); d++) 
+    linked = linked && (chain[d].baseHash() == chain[d+1].stateHash());
+  if(!linked){
+    loutE(DataHandling) << "StateDelta::Load: The chain of '" << fileName
+			<< "' does not match its base '" << file << "'." << endl;
+    return kFalse;
+  }
+  for(vector<StateDelta>::reverse_iterator it = chain.rbegin(); it != chain.rend(); ++it)
+    it->apply(state, kFalse);
+  if(state.hash() != chain.front().stateHash()){
+    loutE(DataHandling) << "StateDelta::Load: The state rebuilt from '" << fileName
+			<< "' differs from the saved one." << endl;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+} // end namespace Blobb
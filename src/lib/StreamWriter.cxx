@@ -0,0 +1,234 @@
+/** \file      src/lib/StreamWriter.cxx
+    \brief     Source for StreamWriter
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/StreamWriter.hh"  // this class
+#include "blobb/Exception.hh"     // exception handler
+#include <cmath>                  // cplusplus.com/reference/cmath/
+#include <cstdio>                 // cplusplus.com/reference/cstdio/
+#include <cstring>                // cplusplus.com/reference/cstring/
+
+namespace Blobb {
+
+//_____________________________________________________________________________
+/** Constructor; writes the document start.
+    \warning Throws Exception for archive types other than kJson & kXml. */
+StreamWriter::StreamWriter(ostream& os, eArchiveType arcType, Bool_t compact,
+			   ULong_t bufferSize)
+  : mOs(os),
+    mArcType(arcType),
+    mCompact(compact),
+    mBuffer(bufferSize < 64 ? 64 : bufferSize),
+    mPos(0),
+    mBytes(0),
+    mLevels(),
+    mTag("")
+{
+  if(mArcType != kJson && mArcType != kXml)
+    throw Exception("StreamWriter: Only JSON and XML archives can be streamed.");
+  // root node
+  Level_t root = {"cereal", kFalse, 0};
+  if(mArcType == kJson) put('{');
+  else{
+    put("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
+    if(!mCompact) put('\n');
+    put("<cereal>");
+  }
+  mLevels.push_back(root);
+}
+
+//_____________________________________________________________________________
+/** Destructor; closes the document. */
+StreamWriter::~StreamWriter()
+{
+  try{ close(); }
+  catch(...){}
+}
+
+//_____________________________________________________________________________
+/** Start an object node. */
+void StreamWriter::startNode(const string& name)
+{
+  const string& tag = prefix(name);
+  if(mArcType == kJson) put('{');
+  else{ put('<'); put(tag); put('>'); }
+  Level_t level = {tag, kFalse, 0};
+  mLevels.push_back(level);
+}
+
+//_____________________________________________________________________________
+/** Start an array node; its children are unnamed. */
+void StreamWriter::startArray(const string& name)
+{
+  const string& tag = prefix(name);
+  if(mArcType == kJson) put('[');
+  else{ put('<'); put(tag); put(" size=\"dynamic\">"); }
+  Level_t level = {tag, kTrue, 0};
+  mLevels.push_back(level);
+}
+
+//_____________________________________________________________________________
+/** Finish the current (object or array) node. */
+void StreamWriter::finishNode()
+{
+  if(mLevels.size() < 2) throw Exception("StreamWriter::finishNode: No open node.");
+  Level_t level = mLevels.back();
+  mLevels.pop_back();
+  if(level.count > 0) indent(mLevels.size());
+  if(mArcType == kJson) put(level.isArray ? ']' : '}');
+  else{ put("</"); put(level.name); put('>'); }
+}
+
+//_____________________________________________________________________________
+/** Write a string value. */
+void StreamWriter::value(const string& name, const string& val)
+{
+  const string& tag = prefix(name);
+  if(mArcType == kJson){ put('"'); putEscaped(val); put('"'); }
+  else{ put('<'); put(tag); put('>'); putEscaped(val); put("</"); put(tag); put('>'); }
+}
+
+//_____________________________________________________________________________
+/** Write a floating-point value (round-trip precision). */
+void StreamWriter::value(const string& name, Double_t val)
+{
+  Char_t num[32];
+  // integral values (not -0): cheaper than, and identical to, %g
+  if(val > -1.e15 && val < 1.e15 && val == Double_t(Long_t(val)) && !(val == 0. && std::signbit(val)))
+    snprintf(num, sizeof(num), "%ld", (long)val);
+  else
+    snprintf(num, sizeof(num), "%.17g", val);
+  const string& tag = prefix(name);
+  if(mArcType == kJson) put(num);
+  else{ put('<'); put(tag); put('>'); put(num); put("</"); put(tag); put('>'); }
+}
+
+//_____________________________________________________________________________
+/** Write an unsigned integer value. */
+void StreamWriter::value(const string& name, UInt_t val)
+{
+  Char_t num[16];
+  snprintf(num, sizeof(num), "%u", val);
+  const string& tag = prefix(name);
+  if(mArcType == kJson) put(num);
+  else{ put('<'); put(tag); put('>'); put(num); put("</"); put(tag); put('>'); }
+}
+
+//_____________________________________________________________________________
+/** Write the buffer to the stream. */
+void StreamWriter::flush()
+{
+  if(mPos > 0){
+    mOs.write(&mBuffer[0], mPos);
+    mBytes += mPos;
+    mPos = 0;
+  }
+  if(!mOs) throw Exception("StreamWriter::flush: Failed to write the stream.");
+}
+
+//_____________________________________________________________________________
+/** Finish all open nodes, close the root and flush. */
+void StreamWriter::close()
+{
+  if(mLevels.empty()) return;
+  while(mLevels.size() > 1) finishNode();
+  mLevels.pop_back();
+  if(mArcType == kJson){ if(!mCompact) put('\n'); put('}'); }
+  else{ if(!mCompact) put('\n'); put(mCompact ? "</cereal>\n" : "</cereal>\n\n"); }
+  flush();
+}
+
+//_____________________________________________________________________________
+/** Separator, indentation & key for the next child of the current node.
+    \return The child's (XML) name. */
+const string& StreamWriter::prefix(const string& name)
+{
+  if(mLevels.empty()) throw Exception("StreamWriter: Document already closed.");
+  Level_t& level = mLevels.back();
+  if(mArcType == kJson && level.count > 0) put(',');
+  indent(mLevels.size());
+  if(level.isArray){
+    if(mArcType == kXml){
+      Char_t buf[32];
+      snprintf(buf, sizeof(buf), "value%lu", (unsigned long)level.count);
+      mTag = buf;
+      level.count++;
+      return mTag;
+    }
+  }
+  else if(mArcType == kJson){
+    put('"'); putEscaped(name); put(mCompact ? "\":" : "\": ");
+  }
+  level.count++;
+  return name;
+}
+
+//_____________________________________________________________________________
+/** Append a character. */
+void StreamWriter::put(Char_t c)
+{
+  if(mPos == mBuffer.size()) flush();
+  mBuffer[mPos++] = c;
+}
+
+//_____________________________________________________________________________
+/** Append characters. */
+void StreamWriter::put(CChar_t* s, ULong_t length)
+{
+  if(mPos + length > mBuffer.size()) flush();
+  if(length > mBuffer.size()){
+    mOs.write(s, length);
+    mBytes += length;
+    return;
+  }
+  memcpy(&mBuffer[mPos], s, length);
+  mPos += length;
+}
+
+//_____________________________________________________________________________
+/** Append a string, escaped for JSON or XML. */
+void StreamWriter::putEscaped(const string& s)
+{
+  for(string::const_iterator it = s.begin(); it != s.end(); ++it){
+    Char_t c = *it;
+    if(mArcType == kJson){
+      if(c == '"' || c == '\\'){ put('\\'); put(c); }
+      else if(c == '\n') put("\\n");
+      else if(c == '\t') put("\\t");
+      else if(c == '\r') put("\\r");
+      else if((unsigned char)c < 0x20){
+	Char_t buf[8];
+	snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+	put(buf);
+      }
+      else put(c);
+    }
+    else{
+      if(c == '&')      put("&amp;");
+      else if(c == '<') put("&lt;");
+      else if(c == '>') put("&gt;");
+      else put(c);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+/** Append a C-string. */
+void StreamWriter::put(CChar_t* s)
+{
+  put(s, strlen(s));
+}
+
+//_____________________________________________________________________________
+/** New line & indentation (none if compact). */
+void StreamWriter::indent(ULong_t depth)
+{
+  if(mCompact) return;
+  put('\n');
+  if(mArcType == kJson) for(ULong_t i=0; i<depth; i++) put("    ", 4);
+  else                  for(ULong_t i=0; i<depth; i++) put('\t');
+}
+
+} // end namespace Blobb
@@ -7,6 +7,7 @@
 #include "blobb/TimeStamp.hh"  // this class
 #include "blobb/ClassImp.hh"     // blobb class implementation
 #include "blobb/Exception.hh"  // exception handler
+#include "blobb/Hash.hh"       // content hashing
 
 //! Blobb class implementation macro
 BLOBB_CLASS_IMP(TimeStamp)
@@ -77,9 +78,9 @@ Bool_t TimeStamp::isEqual(const AbsObject& other) const
 {
   if(isSame(other)) return true;
 
-  // check cast
-  TimeStamp* ts = (TimeStamp*)(&other);
-  if(!ts) return false;
+  // check class-type & cast
+  if(!isSameClass(other)) return false;
+  const TimeStamp* ts = static_cast<const TimeStamp*>(&other);
 
   // check members
   if(mUts != ts->uts()) return false;
@@ -88,6 +89,13 @@ Bool_t TimeStamp::isEqual(const AbsObject& other) const
   return true;
 }
 
+//_____________________________________________________________________________
+/** Content hash of the UTS value. */
+ULong_t TimeStamp::hash() const
+{
+  return HashCombine(ClassId(), ULong_t(Long_t(mUts)));
+}
+
 //_____________________________________________________________________________
 /** Compare this to other. 
     Returns: 
@@ -8,6 +8,9 @@
 #include "blobb/ClassImp.hh"  // blobb class implementation
 #include "blobb/Random.hh"    // random number
 #include "blobb/CLUI.hh"      // command-line user interface
+#include "blobb/Hash.hh"      // content hashing
+#include "blobb/StreamWriter.hh" // streaming JSON/XML writer
+#include "blobb/Format.hh"     // formatting into buffers
 
 //! Blobb class implementation macro
 BLOBB_CLASS_IMP(Warrior)
@@ -111,26 +114,24 @@ Bool_t Warrior::isEqual(const AbsObject& other) const
 {
   // check pointer
   if(isSame(other)) return kTrue;
+  // check class-type
+  if(!isSameClass(other)) return kFalse;
+  // statically cast; class-type already checked
+  const Warrior& w = static_cast<const Warrior&>(other); 
   // check members
-  try{ 
-    // dynamically cast
-    const Warrior& w = dynamic_cast<const Warrior&>(other); 
-    // check members
-    if(!Named::isEqual(w))               return kFalse;
-    if(mProwess      != w.mProwess)      return kFalse;
-    if(mAgility      != w.mAgility)      return kFalse;
-    if(mIntelligence != w.mIntelligence) return kFalse;
-    if(mPersonality  != w.mPersonality)  return kFalse;
-    if(mHealth       != w.mHealth)       return kFalse;
-    if(mFatigue      != w.mFatigue)      return kFalse;
-    if(mStun         != w.mStun)         return kFalse;
-    if(mDisarm       != w.mDisarm)       return kFalse;
-    if(mFallen       != w.mFallen)       return kFalse;
-    if(mFatigueTime  != w.mFatigueTime)  return kFalse;
-    if(mHealthTime   != w.mHealthTime)   return kFalse;
-    return kTrue;
-  }
-  catch(const bad_cast& bc){ return kFalse; }
+  if(!Named::isEqual(w))               return kFalse;
+  if(mProwess      != w.mProwess)      return kFalse;
+  if(mAgility      != w.mAgility)      return kFalse;
+  if(mIntelligence != w.mIntelligence) return kFalse;
+  if(mPersonality  != w.mPersonality)  return kFalse;
+  if(mHealth       != w.mHealth)       return kFalse;
+  if(mFatigue      != w.mFatigue)      return kFalse;
+  if(mStun         != w.mStun)         return kFalse;
+  if(mDisarm       != w.mDisarm)       return kFalse;
+  if(mFallen       != w.mFallen)       return kFalse;
+  if(mFatigueTime  != w.mFatigueTime)  return kFalse;
+  if(mHealthTime   != w.mHealthTime)   return kFalse;
+  return kTrue;
 }
 
 //_____________________________________________________________________________
@@ -237,31 +238,82 @@ Bool_t Warrior::collapsed() const
 	  mFatigue.value() <=0.);
 }
 
+//_____________________________________________________________________________
+/** Content hash.
+    Not cached at this level: the attributes are public and modified in place,
+    so the (cached) attribute hashes are combined on each call. */
+ULong_t Warrior::hash() const
+{
+  return computeHash();
+}
+
+//_____________________________________________________________________________
+/** Compute the content hash of name, title and all attributes. */
+ULong_t Warrior::computeHash() const
+{
+  ULong_t h = HashCombine(Named::computeHash(), ClassId());
+  h = HashCombine(h, mProwess.hash());
+  h = HashCombine(h, mAgility.hash());
+  h = HashCombine(h, mIntelligence.hash());
+  h = HashCombine(h, mPersonality.hash());
+  h = HashCombine(h, mHealth.hash());
+  h = HashCombine(h, mFatigue.hash());
+  h = HashCombine(h, mStun.hash());
+  h = HashCombine(h, mDisarm.hash());
+  h = HashCombine(h, mFallen.hash());
+  h = HashCombine(h, mFatigueTime.hash());
+  return HashCombine(h, mHealthTime.hash());
+}
+
+//_____________________________________________________________________________
+/** Write name, title, attributes and disabilities to a streaming writer. */
+void Warrior::stream(StreamWriter& sw) const
+{
+  sw.startNode("Named");
+  Named::stream(sw);
+  sw.finishNode();
+  sw.startNode("Prowess");      mProwess.stream(sw);      sw.finishNode();
+  sw.startNode("Agility");      mAgility.stream(sw);      sw.finishNode();
+  sw.startNode("Intelligence"); mIntelligence.stream(sw); sw.finishNode();
+  sw.startNode("Personality");  mPersonality.stream(sw);  sw.finishNode();
+  sw.startNode("Health");       mHealth.stream(sw);       sw.finishNode();
+  sw.startNode("Fatigue");      mFatigue.stream(sw);      sw.finishNode();
+  sw.startNode("Stun");         mStun.stream(sw);         sw.finishNode();
+  sw.startNode("Disarm");       mDisarm.stream(sw);       sw.finishNode();
+  sw.startNode("Fallen");       mFallen.stream(sw);       sw.finishNode();
+  sw.startNode("FatigueTime");  mFatigueTime.stream(sw);  sw.finishNode();
+  sw.startNode("HealthTime");   mHealthTime.stream(sw);   sw.finishNode();
+}
+
 //_____________________________________________________________________________
 //! Interface to print value of object
 void Warrior::printValue(ostream& os) const
 {
-  os << "{" 
-     << mProwess.value() << ","
-     << mAgility.value() << "," 
-     << mIntelligence.value() << "," 
-     << mPersonality.value() << "," 
+  Char_t storage[128];
+  FormatBuffer fb(os, storage, sizeof(storage));
+  fb << '{' 
+     << mProwess.value() << ','
+     << mAgility.value() << ',' 
+     << mIntelligence.value() << ',' 
+     << mPersonality.value() << ',' 
      << mHealth.value()
-     << "}";
+     << '}';
 }
 
 //_____________________________________________________________________________
 //! Interface to print extras
 void Warrior::printExtras(ostream& os) const
 {
-  os << "{" 
-     << mFatigue.value() << ","
-     << mStun.value() << "," 
-     << mDisarm.value() << "," 
-     << mFallen.value() << "," 
-     << mFatigueTime.value() << "," 
+  Char_t storage[128];
+  FormatBuffer fb(os, storage, sizeof(storage));
+  fb << '{' 
+     << mFatigue.value() << ','
+     << mStun.value() << ',' 
+     << mDisarm.value() << ',' 
+     << mFallen.value() << ',' 
+     << mFatigueTime.value() << ',' 
      << mHealthTime.value()
-     << "}";
+     << '}';
 }
 
 //_____________________________________________________________________________
@@ -324,21 +376,22 @@ void Warrior::printToUI(CLUI& clui, Bool_t verbose) const
 { 
   // Warrior head
   printStream(clui.os(), kClassName|kName|kTitle, kSingleLine);
-  // atributes
-  string indent("         ");
-  mProwess.print     (clui, indent+"     ");
-  mAgility.print     (clui, indent+"     ");
+  // atributes, names aligned (indents built once)
+  static const string indent(9, ' '), indent1(10, ' '), indent2(11, ' '), 
+    indent5(14, ' '), indent6(15, ' '), indent8(17, ' ');
+  mProwess.print     (clui, indent5);
+  mAgility.print     (clui, indent5);
   mIntelligence.print(clui, indent);
-  mPersonality.print (clui, indent+" ");
-  mHealth.print      (clui, indent+"      ");
+  mPersonality.print (clui, indent1);
+  mHealth.print      (clui, indent6);
   // disabilities
   if(verbose){
-    mFatigue.print    (clui, indent+"     ");
-    mStun.print       (clui, indent+"        ");
-    mDisarm.print     (clui, indent+"      ");
-    mFallen.print     (clui, indent+"      ");
-    mFatigueTime.print(clui, indent+" ");
-    mHealthTime.print (clui, indent+"  ");
+    mFatigue.print    (clui, indent5);
+    mStun.print       (clui, indent8);
+    mDisarm.print     (clui, indent6);
+    mFallen.print     (clui, indent6);
+    mFatigueTime.print(clui, indent1);
+    mHealthTime.print (clui, indent2);
   }
 }
 
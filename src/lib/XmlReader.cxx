@@ -0,0 +1,176 @@
+/** \file      src/lib/XmlReader.cxx
+    \brief     Source for XmlReader
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/XmlReader.hh"                     // this class
+#include "blobb/MappedFile.hh"                    // memory-mapped file
+#include "blobb/LogService.hh"                    // logging
+#include <cereal/external/rapidxml/rapidxml.hpp>  // rapidxml parser
+#include <cstdlib>                                // cplusplus.com/reference/cstdlib/
+#include <cstring>                                // cplusplus.com/reference/cstring/
+
+namespace Blobb {
+
+/** \typedef rapidxml::xml_node<> XmlNode_t
+    \brief rapidxml element. */
+typedef rapidxml::xml_node<> XmlNode_t;
+
+//_____________________________________________________________________________
+//! Child element by name; throws if missing.
+static const XmlNode_t* Child(const XmlNode_t* node, CChar_t* name)
+{
+  const XmlNode_t* child = node->first_node(name);
+  if(!child)
+    throw Exception("XmlReader: Missing element <" + string(name) + "> in <"
+		    + string(node->name(), node->name_size()) + ">.");
+  return child;
+}
+
+//_____________________________________________________________________________
+//! Floating-point element value, converted in place.
+static inline Double_t ToDouble(const XmlNode_t* node)
+{
+  // values are followed by '<' (or are the terminated empty string)
+  return strtod(node->value(), 0);
+}
+
+//_____________________________________________________________________________
+//! Unsigned element value, converted in place.
+static inline UInt_t ToUInt(const XmlNode_t* node)
+{
+  return UInt_t(strtoul(node->value(), 0, 10));
+}
+
+//_____________________________________________________________________________
+//! String element value, with the predefined & numeric entities decoded.
+static string ToString(const XmlNode_t* node)
+{
+  CChar_t* v = node->value();
+  ULong_t  n = node->value_size();
+  if(!memchr(v, '&', n)) return string(v, n);
+
+  string s;
+  s.reserve(n);
+  for(ULong_t i=0; i<n; i++){
+    if(v[i] != '&'){ s += v[i]; continue; }
+    CChar_t* semi = static_cast<CChar_t*>(memchr(v + i, ';', n - i));
+    if(!semi){ s += v[i]; continue; }
+    string ent(v + i + 1, semi);
+    if(ent == "lt")        s += '<';
+    else if(ent == "gt")   s += '>';
+    else if(ent == "amp")  s += '&';
+    else if(ent == "quot") s += '"';
+    else if(ent == "apos") s += '\'';
+    else if(ent.size() > 1 && ent[0] == '#'){
+      ULong_t c = (ent[1] == 'x' ? strtoul(ent.c_str() + 2, 0, 16) : strtoul(ent.c_str() + 1, 0, 10));
+      if(c < 0x80) s += Char_t(c);
+      else if(c < 0x800){ s += Char_t(0xC0 | (c >> 6)); s += Char_t(0x80 | (c & 0x3F)); }
+      else if(c < 0x10000){
+	s += Char_t(0xE0 | (c >> 12));        s += Char_t(0x80 | ((c >> 6) & 0x3F));
+	s += Char_t(0x80 | (c & 0x3F));
+      }
+      else{
+	s += Char_t(0xF0 | (c >> 18));        s += Char_t(0x80 | ((c >> 12) & 0x3F));
+	s += Char_t(0x80 | ((c >> 6) & 0x3F)); s += Char_t(0x80 | (c & 0x3F));
+      }
+    }
+    else{ s.append(v + i, semi + 1); }
+    i = semi - v;
+  }
+  return s;
+}
+
+//_____________________________________________________________________________
+//! Name & title from a <Named> element.
+static void ReadNamed(const XmlNode_t* node, Named& named)
+{
+  const XmlNode_t* n = Child(node, "Named");
+  named.setNameTitle(ToString(Child(n, "Name")), ToString(Child(n, "Title")));
+}
+
+//_____________________________________________________________________________
+//! Parameter from its element.
+static void ReadParameter(const XmlNode_t* node, Parameter& par)
+{
+  ReadNamed(node, par);
+  par.set(ToDouble(Child(node, "Value")), ToDouble(Child(node, "Error")));
+  par.setRange(ToDouble(Child(node, "Min")), ToDouble(Child(node, "Max")));
+}
+
+//_____________________________________________________________________________
+//! Warrior from its (map value) element.
+static void ReadWarrior(const XmlNode_t* node, Warrior& war)
+{
+  ReadNamed(node, war);
+  ReadParameter(Child(node, "Prowess"),      war.mProwess);
+  ReadParameter(Child(node, "Agility"),      war.mAgility);
+  ReadParameter(Child(node, "Intelligence"), war.mIntelligence);
+  ReadParameter(Child(node, "Personality"),  war.mPersonality);
+  ReadParameter(Child(node, "Health"),       war.mHealth);
+  ReadParameter(Child(node, "Fatigue"),      war.mFatigue);
+  ReadParameter(Child(node, "Stun"),         war.mStun);
+  ReadParameter(Child(node, "Disarm"),       war.mDisarm);
+  ReadParameter(Child(node, "Fallen"),       war.mFallen);
+  ReadParameter(Child(node, "FatigueTime"),  war.mFatigueTime);
+  ReadParameter(Child(node, "HealthTime"),   war.mHealthTime);
+}
+
+//_____________________________________________________________________________
+/** Default constructor. */
+XmlReader::XmlReader()
+  : mNumParsed(0)
+{}
+
+//_____________________________________________________________________________
+/** Load a state from an XML file (cereal layout).
+    \return "success" boolean: true if successfully loaded. */
+Bool_t XmlReader::load(const string& fileName, BloBB& blobb)
+{
+  mNumParsed = 0;
+  MappedFile file;
+  if(!file.open(fileName, kTrue)) return kFalse;
+
+  try{
+    loutI(DataHandling) << "Mapping file " << fileName << endl;
+    // parse in place; the mapping is not written to
+    rapidxml::xml_document<> doc;
+    doc.parse<rapidxml::parse_non_destructive | rapidxml::parse_no_data_nodes>
+      (const_cast<Char_t*>(reinterpret_cast<CChar_t*>(file.data())));
+    const XmlNode_t* root = Child(&doc, "cereal")->first_node();
+    if(!root) throw Exception("XmlReader: Empty document.");
+
+    // state
+    blobb.clear();
+    ReadNamed(root, blobb);
+    blobb.setStartTime(TimeStamp(ToString(Child(root, "StartTime"))));
+    blobb.setEndTime(TimeStamp(ToString(Child(root, "EndTime"))));
+    const XmlNode_t* rnd = Child(root, "Random");
+    blobb.setRandom(Random(ToUInt(Child(rnd, "Seed")), ToUInt(Child(rnd, "NumIter"))));
+
+    // warriors
+    Warriors_t& wars = blobb.warriors();
+    Warrior war;
+    for(const XmlNode_t* el = Child(root, "Warriors")->first_node(); el; el = el->next_sibling()){
+      ReadWarrior(Child(el, "value"), war);
+      wars.emplace_hint(wars.end(), ToString(Child(el, "key")), war);
+      mNumParsed++;
+    }
+    blobb.reindex();
+  }
+  catch(const rapidxml::parse_error& e){
+    loutE(InputArguments) << "XmlReader::load: Failed to parse file '" << fileName
+			  << "'; " << e.what() << " (offset "
+			  << (e.where<Char_t>() - reinterpret_cast<CChar_t*>(file.data())) << ")" << endl;
+    return kFalse;
+  }
+  catch(std::exception& e){
+    loutE(InputArguments) << "XmlReader::load: Failed to read file '" << fileName
+			  << "'; " << e.what() << endl;
+    return kFalse;
+  }
+  return kTrue;
+}
+
+} // end namespace Blobb
@@ -0,0 +1,1270 @@
+/** \file      src/progs/blobb-bench.cxx
+    \brief     Source for binary executable for blobb benchmarks.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Exception.hh"   // exception handler
+#include "blobb/LogService.hh"  // log service
+#include "blobb/BloBB.hh"       // main program
+#include "blobb/MappedRoster.hh"  // memory-mapped roster
+#include "blobb/JsonReader.hh"    // streaming JSON loader
+#include "blobb/XmlReader.hh"     // mapped XML loader
+#include "blobb/Journal.hh"       // change journal
+#include "blobb/ArchiveIndex.hh"  // footer index of binary archives
+#include "blobb/StreamWriter.hh"  // streaming JSON writer
+#include "blobb/StateDelta.hh"    // delta snapshots
+#include "blobb/FightEngine.hh"   // fights
+#include "blobb/BinaryLog.hh"     // binary log records
+#include "blobb/Sink.hh"          // output sinks
+#include "blobb/Batch.hh"         // batch mode
+#include "blobb/Dashboard.hh"     // live tournaments
+#include <chrono>               // cplusplus.com/reference/chrono/
+#include <cstdio>               // cplusplus.com/reference/cstdio/
+#include <cstring>              // cplusplus.com/reference/cstring/
+#include <fstream>              // cplusplus.com/reference/fstream/
+#include <functional>           // cplusplus.com/reference/functional/
+#include <sstream>              // cplusplus.com/reference/sstream/
+#include <thread>               // cplusplus.com/reference/thread/
+#ifdef HAVE_CONFIG_H
+  #include "blobb/Config.hh"    // configuration information
+#endif
+#ifdef HAVE_UNISTD_H
+  #include <fcntl.h>            // POSIX open & fadvise
+  #include <unistd.h>           // POSIX fsync & close
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+  #include <sys/resource.h>     // POSIX getrusage
+#endif
+#ifdef HAVE_SYS_WAIT_H
+  #include <sys/wait.h>         // POSIX waitpid
+#endif
+using namespace Blobb;          // blobb top level namespace
+
+//_____________________________________________________________________________
+/** \typedef std::chrono::steady_clock Clock_t
+    \brief Monotonic clock for timing.
+*/
+typedef std::chrono::steady_clock Clock_t;
+
+//_____________________________________________________________________________
+//! Seconds elapsed since start.
+static Double_t Elapsed(const Clock_t::time_point& start)
+{
+  return std::chrono::duration<Double_t>(Clock_t::now() - start).count();
+}
+
+//_____________________________________________________________________________
+//! Build a roster of 'size' warriors with random attributes.
+static Warriors_t BuildRoster(UInt_t size, UInt_t seed = 1)
+{
+  Random rnd(seed);
+  Warriors_t wars;
+  Warrior w;
+  Char_t name[32];
+  for(UInt_t i=0; i<size; i++){
+    snprintf(name, sizeof(name), "W%09u", i);
+    w.setNameTitle(name, "A Benchmark Warrior");
+    w.mProwess.set     (rnd.uniform(20., 80.), rnd.uniform(5., 20.));
+    w.mAgility.set     (rnd.uniform(20., 80.), rnd.uniform(5., 20.));
+    w.mIntelligence.set(rnd.uniform(20., 80.), rnd.uniform(5., 20.));
+    w.mPersonality.set (rnd.uniform(20., 80.), rnd.uniform(5., 20.));
+    w.mHealth.set      (rnd.uniform(20., 80.), rnd.uniform(5., 20.));
+    w.mFatigue.set     (w.mHealth.value());
+    wars.insert(wars.end(), Warriors_t::value_type(w.name(), w));
+  }
+  return wars;
+}
+
+//_____________________________________________________________________________
+//! Print one benchmark result line.
+static void PrintResult(const string& bench, const string& what,
+			UInt_t size, Double_t seconds, Double_t perItem)
+{
+  printf("%-12s %-24s size=%-9u time=%10.6f s  per-item=%10.2f ns\n",
+	 bench.c_str(), what.c_str(), size, seconds, perItem*1.e9);
+}
+
+//_____________________________________________________________________________
+//! Bulk equality & class-type checks over a Warriors_t.
+static void BenchEquality(UInt_t size, UInt_t reps)
+{
+  Warriors_t wars  = BuildRoster(size);
+  Warriors_t other = wars;
+  UInt_t nEqual(0);
+
+  // map equality: one isEqual per warrior (and per attribute)
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++)
+    if(wars == other) nEqual++;
+  Double_t t = Elapsed(start);
+  PrintResult("equality", "Warriors_t ==", size, t, t/(Double_t(reps)*size));
+  if(nEqual != reps) throw Exception("BenchEquality: rosters differ!");
+
+  // class-type checks by identifier
+  UInt_t nA(0);
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++)
+    for(Warriors_t::const_iterator it=wars.begin(); it!=wars.end(); ++it)
+      if(it->second.isA(Warrior::ClassId())) nA++;
+  t = Elapsed(start);
+  PrintResult("equality", "isA(ClassId)", size, t, t/(Double_t(reps)*size));
+
+  // class-type checks by name (for reference)
+  UInt_t nName(0);
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++)
+    for(Warriors_t::const_iterator it=wars.begin(); it!=wars.end(); ++it)
+      if(it->second.className() == "Warrior") nName++;
+  t = Elapsed(start);
+  PrintResult("equality", "className() == string", size, t, t/(Double_t(reps)*size));
+  if(nA != nName) throw Exception("BenchEquality: class-type checks differ!");
+}
+
+//_____________________________________________________________________________
+//! Range filter & top-k over the columnar roster index vs. walking Warriors_t.
+static void BenchIndex(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const RosterIndex& index = blobb.index();
+
+  // map walk: prowess > 70 and health < 40
+  Pos_t nWalk(0);
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    vector<string> sel;
+    const Warriors_t& wars = blobb.warriors();
+    for(Warriors_t::const_iterator it=wars.begin(); it!=wars.end(); ++it)
+      if(it->second.mProwess.value() > 70. && it->second.mHealth.value() < 40.)
+	sel.push_back(it->first);
+    nWalk = sel.size();
+  }
+  Double_t t = Elapsed(start);
+  PrintResult("index", "Warriors_t walk", size, t, t/(Double_t(reps)*size));
+
+  // index select
+  vector<RosterIndex::Cut> cuts;
+  cuts.push_back(RosterIndex::Cut(RosterIndex::kProwess, 70.));
+  cuts.push_back(RosterIndex::Cut(RosterIndex::kHealth, kMinD, 40.));
+  Pos_t nSel(0);
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++)
+    nSel = index.select(cuts).size();
+  t = Elapsed(start);
+  PrintResult("index", "RosterIndex::select", size, t, t/(Double_t(reps)*size));
+  if(nSel != nWalk) throw Exception("BenchIndex: selections differ!");
+
+  // index top-10
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++)
+    index.top(RosterIndex::kProwess, 10);
+  t = Elapsed(start);
+  PrintResult("index", "RosterIndex::top(10)", size, t, t/(Double_t(reps)*size));
+}
+
+//_____________________________________________________________________________
+//! Open & look-up in a memory-mapped roster vs. loading a cereal binary archive.
+static void BenchMapped(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string cnbFile("blobb-bench.cnb"), bbmFile("blobb-bench.bbm");
+  if(!blobb.save(cnbFile) || !blobb.save(bbmFile))
+    throw Exception("BenchMapped: Failed to write the rosters!");
+
+  // full load of the binary archive (once; it dominates)
+  BloBB loaded;
+  Clock_t::time_point start = Clock_t::now();
+  if(!loaded.load(cnbFile)) throw Exception("BenchMapped: Failed to load!");
+  Double_t t = Elapsed(start);
+  PrintResult("mapped", "cereal binary load", size, t, t/size);
+
+  // open the mapped roster
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    MappedRoster roster(bbmFile);
+    if(roster.size() != size) throw Exception("BenchMapped: Roster size differs!");
+  }
+  t = Elapsed(start);
+  PrintResult("mapped", "MappedRoster open", size, t, t/reps);
+
+  // look-up & build single warriors
+  MappedRoster roster(bbmFile);
+  Random rnd(2);
+  Char_t name[32];
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    snprintf(name, sizeof(name), "W%09u", UInt_t(rnd.uniform(0., size)) % size);
+    if(!(roster.warrior(name) == blobb.warrior(name)))
+      throw Exception("BenchMapped: Warriors differ!");
+  }
+  t = Elapsed(start);
+  PrintResult("mapped", "MappedRoster warrior(key)", size, t, t/reps);
+
+  // lazy load of the mapped roster & one look-up
+  BloBB mapped;
+  start = Clock_t::now();
+  if(!mapped.load(bbmFile) || !mapped.hasWarrior(name)) 
+    throw Exception("BenchMapped: Failed to map!");
+  t = Elapsed(start);
+  PrintResult("mapped", "mapped lazy load", size, t, t);
+
+  // all warriors of the mapped roster built
+  start = Clock_t::now();
+  if(mapped.warriors().size() != size) throw Exception("BenchMapped: Roster size differs!");
+  t = Elapsed(start);
+  PrintResult("mapped", "mapped full build", size, t, t/size);
+  if(mapped.hash() != loaded.hash()) throw Exception("BenchMapped: States differ!");
+
+  remove(cnbFile.c_str());
+  remove(bbmFile.c_str());
+}
+
+//_____________________________________________________________________________
+//! Size of a file [bytes].
+static Double_t FileSize(const string& fileName)
+{
+  std::ifstream ifs(fileName.c_str(), std::ios::binary | std::ios::ate);
+  return Double_t(ifs.tellg());
+}
+
+//_____________________________________________________________________________
+//! Streaming JSON/XML writer vs. cereal's JSON/XML archives.
+static void BenchStream(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  CChar_t* exts[] = {".json", ".xml"};
+  for(UInt_t e=0; e<2; e++){
+    string fileName = string("blobb-bench") + exts[e];
+    string arc = GetArchiveName(GetArchiveTypeFromExt(exts[e]));
+    Char_t what[64];
+
+    // cereal archive
+    Clock_t::time_point start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++) blobb.save(fileName);
+    Double_t t = Elapsed(start);
+    snprintf(what, sizeof(what), "cereal %s %.0fMB/s", arc.c_str(),
+	     FileSize(fileName)*reps/t/1.e6);
+    PrintResult("stream", what, size, t, t/(Double_t(reps)*size));
+    BloBB expected;
+    expected.load(fileName);
+
+    // streamed, pretty & compact
+    for(UInt_t compact=0; compact<2; compact++){
+      start = Clock_t::now();
+      for(UInt_t r=0; r<reps; r++) blobb.saveStreamed(fileName, compact);
+      t = Elapsed(start);
+      snprintf(what, sizeof(what), "%s %s %.0fMB/s", (compact ? "compact" : "stream"),
+	       arc.c_str(), FileSize(fileName)*reps/t/1.e6);
+      PrintResult("stream", what, size, t, t/(Double_t(reps)*size));
+      // read back with cereal; same state as read from cereal's output
+      BloBB loaded;
+      if(!loaded.load(fileName) || loaded.hash() != expected.hash())
+	throw Exception("BenchStream: Streamed " + arc + " state differs!");
+    }
+    remove(fileName.c_str());
+  }
+}
+
+//_____________________________________________________________________________
+//! Streaming (SAX) JSON loading vs. cereal's (DOM) JSON archive.
+static void BenchSax(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string fileName("blobb-bench.json");
+  if(!blobb.saveStreamed(fileName)) throw Exception("BenchSax: Failed to write the state!");
+
+  // streamed, all warriors
+  JsonReader reader(JsonReader::Filter_t(), 0);
+  BloBB sax;
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) reader.load(fileName, sax);
+  Double_t t = Elapsed(start);
+  PrintResult("sax", "JsonReader load", size, t, t/(Double_t(reps)*size));
+
+  // streamed, stop at the middle warrior
+  Char_t key[32];
+  snprintf(key, sizeof(key), "W%09u", size/2);
+  Warrior war;
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) JsonReader::LoadWarrior(fileName, key, war);
+  t = Elapsed(start);
+  PrintResult("sax", "JsonReader::LoadWarrior", size, t, t/(Double_t(reps)*size));
+  if(!(war == sax.warrior(key))) throw Exception("BenchSax: Warriors differ!");
+
+  // cereal DOM
+  BloBB dom;
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) dom.load(fileName);
+  t = Elapsed(start);
+  PrintResult("sax", "cereal JSON load", size, t, t/(Double_t(reps)*size));
+  if(dom.hash() != sax.hash()) throw Exception("BenchSax: States differ!");
+  remove(fileName.c_str());
+}
+
+//_____________________________________________________________________________
+//! Mapped, in-place XML loading vs. cereal's XML archive.
+static void BenchXml(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string fileName("blobb-bench.xml");
+  if(!blobb.saveStreamed(fileName)) throw Exception("BenchXml: Failed to write the state!");
+
+  // mapped
+  XmlReader reader;
+  BloBB mapped;
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) reader.load(fileName, mapped);
+  Double_t t = Elapsed(start);
+  PrintResult("xml", "XmlReader load", size, t, t/(Double_t(reps)*size));
+
+  // cereal
+  BloBB cereal;
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) cereal.load(fileName);
+  t = Elapsed(start);
+  PrintResult("xml", "cereal XML load", size, t, t/(Double_t(reps)*size));
+  if(mapped.hash() != cereal.hash() || mapped.hash() != blobb.hash())
+    throw Exception("BenchXml: States differ!");
+  remove(fileName.c_str());
+}
+
+//_____________________________________________________________________________
+//! LZ block-compressed archives vs. their uncompressed formats.
+static void BenchLz(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  CChar_t* exts[] = {".cnb", ".cnbz", ".json", ".jsonz"};
+  ULong_t expected(0);
+  for(UInt_t e=0; e<4; e++){
+    string fileName = string("blobb-bench") + exts[e];
+    string arc = GetArchiveName(GetArchiveTypeFromExt(exts[e]));
+    Char_t what[64];
+
+    // save
+    Clock_t::time_point start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++) blobb.save(fileName);
+    Double_t t = Elapsed(start);
+    snprintf(what, sizeof(what), "save %s %.1fMB", arc.c_str(), FileSize(fileName)/1.e6);
+    PrintResult("lz", what, size, t, t/(Double_t(reps)*size));
+
+    // load
+    BloBB loaded;
+    start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++) loaded.load(fileName);
+    t = Elapsed(start);
+    snprintf(what, sizeof(what), "load %s", arc.c_str());
+    PrintResult("lz", what, size, t, t/(Double_t(reps)*size));
+    // compressed: same state as read from the plain format
+    if(e%2 == 0) expected = loaded.hash();
+    else if(loaded.hash() != expected)
+      throw Exception("BenchLz: " + arc + " state differs!");
+    remove(fileName.c_str());
+  }
+}
+
+//_____________________________________________________________________________
+/** \struct Benchmark_t
+    \brief A named benchmark.
+*/
+struct Benchmark_t {
+  CChar_t* name;                          //!< name (command-line argument)
+  CChar_t* description;                   //!< description
+  void (*run)(UInt_t size, UInt_t reps);  //!< benchmark method
+};
+
+//_____________________________________________________________________________
+//! Journaled autosaves (one changed warrior) vs. full binary saves.
+static void BenchJournal(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string fileName("blobb-bench.cnb");
+  remove(fileName.c_str());
+  Char_t title[32];
+
+  // full save per change
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    snprintf(title, sizeof(title), "full %u", r);
+    blobb.warriors().begin()->second.setTitle(title);
+    blobb.save(fileName);
+  }
+  Double_t t = Elapsed(start);
+  PrintResult("journal", "full save", size, t, t/reps);
+  remove(fileName.c_str());
+
+  // journal record & sync per change
+  if(!blobb.openJournal(fileName)) throw Exception("BenchJournal: Failed to journal!");
+  Warrior war = blobb.warriors().begin()->second;
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    snprintf(title, sizeof(title), "journal %u", r);
+    war.setTitle(title);
+    blobb.addWarrior(war);
+    blobb.journal()->sync();
+  }
+  t = Elapsed(start);
+  PrintResult("journal", "journaled save", size, t, t/reps);
+  blobb.closeJournal();
+
+  // base + journal replay
+  BloBB loaded;
+  start = Clock_t::now();
+  if(!loaded.openJournal(fileName)) throw Exception("BenchJournal: Failed to replay!");
+  t = Elapsed(start);
+  PrintResult("journal", "load & replay", size, t, t/size);
+  if(loaded.hash() != blobb.hash()) throw Exception("BenchJournal: States differ!");
+  loaded.closeJournal();
+  remove(fileName.c_str());
+  remove(Journal::JournalName(fileName).c_str());
+}
+
+//_____________________________________________________________________________
+//! Background (snapshot) saves vs. blocking saves.
+static void BenchAsync(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string fileName("blobb-bench.cnb");
+
+  // blocking
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++) blobb.save(fileName);
+  Double_t t = Elapsed(start);
+  PrintResult("async", "blocking save", size, t, t/reps);
+
+  // background: time the caller is blocked (snapshot), then the total
+  Double_t blocked(0.);
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    blobb.waitSave();
+    Clock_t::time_point snap = Clock_t::now();
+    if(!blobb.saveAsync(fileName)) throw Exception("BenchAsync: Failed to start!");
+    blocked += Elapsed(snap);
+  }
+  if(!blobb.waitSave()) throw Exception("BenchAsync: Failed to save!");
+  t = Elapsed(start);
+  PrintResult("async", "background save, blocked", size, blocked, blocked/reps);
+  PrintResult("async", "background save, total", size, t, t/reps);
+
+  BloBB loaded;
+  if(!loaded.load(fileName) || loaded.hash() != blobb.hash())
+    throw Exception("BenchAsync: States differ!");
+  remove(fileName.c_str());
+}
+
+//_____________________________________________________________________________
+//! Indexed single-warrior loads vs. full loads of binary archives.
+static void BenchFooter(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  CChar_t* exts[] = {".cnb", ".cnbz"};
+  for(UInt_t e=0; e<2; e++){
+    string fileName = string("blobb-bench") + exts[e];
+    string arc = GetArchiveName(GetArchiveTypeFromExt(exts[e]));
+    if(!blobb.save(fileName)) throw Exception("BenchFooter: Failed to write the state!");
+    Char_t what[64];
+
+    // full load (once; it dominates)
+    BloBB loaded;
+    Clock_t::time_point start = Clock_t::now();
+    if(!loaded.load(fileName)) throw Exception("BenchFooter: Failed to load!");
+    Double_t t = Elapsed(start);
+    snprintf(what, sizeof(what), "%s full load", arc.c_str());
+    PrintResult("footer", what, size, t, t/size);
+
+    // open the index
+    start = Clock_t::now();
+    ArchiveIndex index(fileName);
+    t = Elapsed(start);
+    if(index.size() != size + 1) throw Exception("BenchFooter: Index size differs!");
+    snprintf(what, sizeof(what), "%s index open", arc.c_str());
+    PrintResult("footer", what, size, t, t);
+
+    // single warriors
+    Random rnd(2);
+    Char_t name[32];
+    Warrior war;
+    start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++){
+      snprintf(name, sizeof(name), "W%09u", UInt_t(rnd.uniform(0., size)) % size);
+      if(!index.load(index.objectName() + "/" + name, war) || !(war == blobb.warrior(name)))
+	throw Exception("BenchFooter: Warriors differ!");
+    }
+    t = Elapsed(start);
+    snprintf(what, sizeof(what), "%s warrior(key)", arc.c_str());
+    PrintResult("footer", what, size, t, t/reps);
+    remove(fileName.c_str());
+  }
+}
+
+//_____________________________________________________________________________
+//! Portable (endian-safe) binary vs. native binary archives.
+static void BenchPortable(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  CChar_t* exts[] = {".cnb", ".cnpb"};
+  for(UInt_t e=0; e<2; e++){
+    string fileName = string("blobb-bench") + exts[e];
+    string arc = GetArchiveName(GetArchiveTypeFromExt(exts[e]));
+    Char_t what[64];
+
+    // save
+    Clock_t::time_point start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++) blobb.save(fileName);
+    Double_t t = Elapsed(start);
+    snprintf(what, sizeof(what), "save %s %.1fMB", arc.c_str(), FileSize(fileName)/1.e6);
+    PrintResult("portable", what, size, t, t/(Double_t(reps)*size));
+
+    // load
+    BloBB loaded;
+    start = Clock_t::now();
+    for(UInt_t r=0; r<reps; r++) loaded.load(fileName);
+    t = Elapsed(start);
+    snprintf(what, sizeof(what), "load %s", arc.c_str());
+    PrintResult("portable", what, size, t, t/(Double_t(reps)*size));
+    if(loaded.hash() != blobb.hash())
+      throw Exception("BenchPortable: " + arc + " state differs!");
+    remove(fileName.c_str());
+  }
+}
+
+//_____________________________________________________________________________
+//! Resident set size [bytes]: current (VmRSS) or peak (VmHWM); 0 if unknown.
+static Double_t Rss(Bool_t peak)
+{
+  std::ifstream ifs("/proc/self/status");
+  string key(peak ? "VmHWM:" : "VmRSS:"), line;
+  while(std::getline(ifs, line))
+    if(line.compare(0, key.size(), key) == 0) return atof(line.c_str() + key.size())*1024.;
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage usage;
+  if(peak && getrusage(RUSAGE_SELF, &usage) == 0) return Double_t(usage.ru_maxrss)*1024.;
+#endif
+  return 0.;
+}
+
+//_____________________________________________________________________________
+//! Reset the peak resident set size to the current one (Linux only).
+static void ResetPeakRss()
+{
+  std::ofstream ofs("/proc/self/clear_refs");
+  if(ofs.is_open()) ofs << "5" << endl;
+}
+
+//_____________________________________________________________________________
+/** Run work in a child process (where supported), so that its memory use
+    starts from a small heap, not one holding what earlier work freed;
+    work fills values, which are passed back.
+    \return "success" boolean: true if work completed. */
+static Bool_t InChild(const std::function<void(vector<Double_t>&)>& work, vector<Double_t>& values)
+{
+#if defined(HAVE_UNISTD_H) && defined(HAVE_SYS_WAIT_H)
+  std::cout.flush();
+  std::cerr.flush();
+  int fds[2];
+  if(pipe(fds) != 0) throw Exception("InChild: Failed to open a pipe!");
+  pid_t pid = fork();
+  if(pid < 0) throw Exception("InChild: Failed to fork!");
+  if(pid == 0){
+    close(fds[0]);
+    int status(0);
+    try{
+      work(values);
+      ULong_t n = values.size();
+      status = (write(fds[1], &n, sizeof(n)) == ssize_t(sizeof(n)) &&
+		write(fds[1], values.data(), n*sizeof(Double_t)) == ssize_t(n*sizeof(Double_t))
+		? 0 : 1);
+    }
+    catch(std::exception& e){
+      std::cerr << e.what() << endl;
+      status = 1;
+    }
+    _exit(status);
+  }
+  close(fds[1]);
+  ULong_t n(0);
+  Bool_t ok = (read(fds[0], &n, sizeof(n)) == ssize_t(sizeof(n)));
+  if(ok){
+    values.resize(n);
+    ssize_t bytes = (n > 0 ? read(fds[0], values.data(), n*sizeof(Double_t)) : 0);
+    ok = (bytes == ssize_t(n*sizeof(Double_t)));
+  }
+  close(fds[0]);
+  int status(0);
+  ok = (waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0) && ok;
+  return ok;
+#else
+  work(values);
+  return kTrue;
+#endif
+}
+
+//_____________________________________________________________________________
+//! Drop a file from the page cache, for cold-cache reads (where supported).
+static Bool_t DropCache(const string& fileName)
+{
+#if defined(HAVE_UNISTD_H) && defined(POSIX_FADV_DONTNEED)
+  Int_t fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0) return kFalse;
+  Bool_t ok = (fsync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0);
+  close(fd);
+  return ok;
+#else
+  (void)fileName;
+  return kFalse;
+#endif
+}
+
+//_____________________________________________________________________________
+//! Hourly delta snapshots (1% of the warriors changed) vs. full saves;
+//! the previous snapshot is kept in memory.
+static void BenchDelta(UInt_t size, UInt_t reps)
+{
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(size));
+  const string baseName("blobb-bench.cnb");
+  if(!blobb.save(baseName)) throw Exception("BenchDelta: Failed to save the base!");
+  BloBB base(blobb);  // kept in memory between snapshots
+  Random rnd(2);
+  Char_t name[32], fileName[64];
+  Double_t tFull(0.), tDelta(0.), bytesFull(0.), bytesDelta(0.);
+  string prev(baseName);
+  for(UInt_t r=0; r<reps; r++){
+    for(UInt_t c=0; c<size/100+1; c++){
+      snprintf(name, sizeof(name), "W%09u", UInt_t(rnd.uniform(0., size)) % size);
+      blobb.warrior(name).mHealth.incrValue(-1.);
+      blobb.reindex(name);
+    }
+    Clock_t::time_point start = Clock_t::now();
+    blobb.save("blobb-bench-full.cnb");
+    tFull += Elapsed(start);
+    bytesFull += FileSize("blobb-bench-full.cnb");
+    snprintf(fileName, sizeof(fileName), "blobb-bench-%03u.delta.cnb", r);
+    start = Clock_t::now();
+    if(!StateDelta::Save(blobb, fileName, base, prev)) throw Exception("BenchDelta: Failed to save!");
+    base = blobb;
+    tDelta += Elapsed(start);
+    bytesDelta += FileSize(fileName);
+    prev = fileName;
+  }
+  Char_t what[64];
+  snprintf(what, sizeof(what), "full save %.2fMB", bytesFull/reps/1.e6);
+  PrintResult("delta", what, size, tFull, tFull/reps);
+  snprintf(what, sizeof(what), "delta save %.3fMB", bytesDelta/reps/1.e6);
+  PrintResult("delta", what, size, tDelta, tDelta/reps);
+
+  // rebuild from the chain
+  BloBB loaded;
+  Clock_t::time_point start = Clock_t::now();
+  if(!loaded.loadFile(prev) || loaded.hash() != blobb.hash())
+    throw Exception("BenchDelta: States differ!");
+  Double_t t = Elapsed(start);
+  snprintf(what, sizeof(what), "load chain of %u", reps);
+  PrintResult("delta", what, size, t, t/size);
+  remove(baseName.c_str());
+  remove("blobb-bench-full.cnb");
+  for(UInt_t r=0; r<reps; r++){
+    snprintf(fileName, sizeof(fileName), "blobb-bench-%03u.delta.cnb", r);
+    remove(fileName);
+  }
+}
+
+//_____________________________________________________________________________
+//! Run 'reps' death matches, printed to os; buffered or not.
+static void RunDeaths(const string& what, std::ostream& os, Bool_t buffered, UInt_t reps,
+		      CChar_t* bench = "death")
+{
+  Warriors_t wars = BuildRoster(2*reps);
+  Random rnd(3);
+  CLUI clui;
+  clui.setOutStream(&os);
+  clui.setBuffered(buffered);
+  std::ostream::pos_type pos = os.tellp();
+  Clock_t::time_point start = Clock_t::now();
+  Warriors_t::iterator it = wars.begin();
+  for(UInt_t r=0; r<reps; r++){
+    Warrior& w1 = (it++)->second;
+    Warrior& w2 = (it++)->second;
+    FightEngine(&clui, &rnd, &w1, &w2).death();
+  }
+  Double_t t = Elapsed(start);
+  Char_t label[64];
+  if(pos >= 0) snprintf(label, sizeof(label), "%s %.1fkB", what.c_str(), (os.tellp() - pos)/reps/1.e3);
+  else         snprintf(label, sizeof(label), "%s", what.c_str());
+  PrintResult(bench, label, reps, t, t/reps);
+}
+
+//_____________________________________________________________________________
+//! Death-match output to a file & to a pipe, with a flush per message
+//! vs. buffered CLUI output; per-item is per match.
+static void BenchDeath(UInt_t, UInt_t reps)
+{
+  const string fileName("blobb-bench-death.log");
+  {
+    std::ofstream ofs(fileName.c_str());
+    RunDeaths("file, flushed", ofs, kFalse, reps);
+  }
+  {
+    std::ofstream ofs(fileName.c_str());
+    RunDeaths("file, buffered", ofs, kTrue, reps);
+  }
+  remove(fileName.c_str());
+
+#ifdef HAVE_UNISTD_H
+  // a pipe drained by a reader thread
+  int fds[2];
+  if(pipe(fds) != 0) throw Exception("BenchDeath: Failed to open a pipe!");
+  std::thread reader([&fds](){
+      Char_t buf[1 << 16];
+      while(read(fds[0], buf, sizeof(buf)) > 0) ;
+    });
+  Char_t pipeName[64];
+  snprintf(pipeName, sizeof(pipeName), "/proc/self/fd/%d", fds[1]);
+  {
+    std::ofstream ops(pipeName);
+    if(!ops.is_open()) throw Exception("BenchDeath: Failed to open the pipe!");
+    RunDeaths("pipe, flushed", ops, kFalse, reps);
+    RunDeaths("pipe, buffered", ops, kTrue, reps);
+  }
+  close(fds[1]);
+  reader.join();
+  close(fds[0]);
+#endif
+}
+
+//_____________________________________________________________________________
+//! Death-match output discarded by a /dev/null file vs. a null sink, and
+//! written to memory, file & pipe sinks; per-item is per match.
+static void BenchSinks(UInt_t, UInt_t reps)
+{
+  {
+    std::ofstream null("/dev/null");
+    RunDeaths("/dev/null ofstream", null, kFalse, reps, "sinks");
+  }
+  {
+    NullSink null;
+    RunDeaths("null sink", null.os(), kFalse, reps, "sinks");
+  }
+  {
+    MemorySink memory;
+    RunDeaths("memory sink", memory.os(), kFalse, reps, "sinks");
+  }
+  const string fileName("blobb-bench-sinks.log");
+  {
+    std::ofstream ofs(fileName.c_str());
+    RunDeaths("file ofstream, flushed", ofs, kFalse, reps, "sinks");
+  }
+  {
+    FileSink file(fileName);
+    RunDeaths("file sink, flushed", file.os(), kFalse, reps, "sinks");
+    RunDeaths("file sink, buffered", file.os(), kTrue, reps, "sinks");
+  }
+  remove(fileName.c_str());
+
+#ifdef HAVE_UNISTD_H
+  // a pipe drained by a reader thread
+  int fds[2];
+  if(pipe(fds) != 0) throw Exception("BenchSinks: Failed to open a pipe!");
+  std::thread reader([&fds](){
+      Char_t buf[1 << 16];
+      while(read(fds[0], buf, sizeof(buf)) > 0) ;
+    });
+  {
+    FdSink pipeSink(fds[1], kTrue);
+    RunDeaths("pipe fd sink, flushed", pipeSink.os(), kFalse, reps, "sinks");
+    RunDeaths("pipe fd sink, buffered", pipeSink.os(), kTrue, reps, "sinks");
+  }
+  reader.join();
+  close(fds[0]);
+#endif
+}
+
+//_____________________________________________________________________________
+/** Save/load time, peak RSS & file size for every archive type, over
+    rosters of 10 up to 'size' warriors (x10 steps), written as JSON to
+    stdout; per-operation times are averages over the repetitions.
+    - save/load: AbsObject::save & load, loads with a cold (if the page
+      cache can be dropped) and a warm cache,
+    - write/read: the BLOBB_CLASS_IMP write & read, in memory.
+    Saves and loads each run in a child process (InChild); their peak RSS
+    is the child's peak above its RSS at the start (without /proc, the
+    child's whole peak). */
+static void BenchArchives(UInt_t size, UInt_t reps)
+{
+  eLogLevel level = GetLogLevel();
+  if(level > kWarning) SetLogLevel(kWarning);
+  StreamWriter sw(std::cout, kJson);
+  sw.startNode("archives");
+#ifdef HAVE_CONFIG_H
+  sw.value("version", string(BLOBB_VERSION));
+#endif
+  sw.value("reps", reps);
+  sw.startArray("results");
+
+  // a child per step, so peaks are not hidden by heap freed earlier
+  enum { kSave, kSavePeak, kFileBytes, kWrite, kRead, kNumSaveValues };
+  enum { kLoadCold, kLoadWarm, kLoadPeak, kNumLoadValues };
+  for(ULong_t n=10; n<=size; n*=10){
+    for(Int_t a=kBinary; a<=kPortable; a++){
+      eArchiveType arcType = eArchiveType(a);
+      string fileName = "blobb-bench" + GetArchiveExt(arcType);
+
+      // save, write & read (mapped rosters are only loaded from files)
+      vector<Double_t> saved(kNumSaveValues, -1.);
+      Bool_t ok = InChild([&](vector<Double_t>& v){
+	  BloBB blobb;
+	  blobb.setWarriors(BuildRoster(UInt_t(n)));
+	  Double_t base = Rss(kFalse);
+	  ResetPeakRss();
+	  Clock_t::time_point start = Clock_t::now();
+	  for(UInt_t r=0; r<reps; r++) 
+	    if(!blobb.save(fileName)) throw Exception("BenchArchives: Failed to save!");
+	  v[kSave] = Elapsed(start)/reps;
+	  v[kSavePeak] = Rss(kTrue) - base;
+	  v[kFileBytes] = FileSize(fileName);
+
+	  std::stringstream ss;
+	  start = Clock_t::now();
+	  for(UInt_t r=0; r<reps; r++){ ss.str(""); blobb.write(ss, arcType); }
+	  v[kWrite] = Elapsed(start)/reps;
+	  if(arcType != kMapped){
+	    string data = ss.str();
+	    BloBB loaded;
+	    start = Clock_t::now();
+	    for(UInt_t r=0; r<reps; r++){ std::istringstream is(data); loaded.read(is, arcType); }
+	    v[kRead] = Elapsed(start)/reps;
+	  }
+	}, saved);
+      if(!ok){
+	remove(fileName.c_str());
+	throw Exception("BenchArchives: " + GetArchiveName(arcType) + " save failed!");
+      }
+
+      // load, cold & warm
+      vector<Double_t> loadedValues(kNumLoadValues, -1.);
+      ok = InChild([&](vector<Double_t>& v){
+	  BloBB loaded;
+	  Double_t base = Rss(kFalse);
+	  ResetPeakRss();
+	  Double_t cold(0.);
+	  Bool_t dropped(kTrue);
+	  for(UInt_t r=0; r<reps; r++){
+	    dropped = DropCache(fileName) && dropped;
+	    Clock_t::time_point start = Clock_t::now();
+	    if(!loaded.load(fileName)) throw Exception("BenchArchives: Failed to load!");
+	    cold += Elapsed(start);
+	  }
+	  if(dropped) v[kLoadCold] = cold/reps;
+	  Clock_t::time_point start = Clock_t::now();
+	  for(UInt_t r=0; r<reps; r++)
+	    if(!loaded.load(fileName)) throw Exception("BenchArchives: Failed to load!");
+	  v[kLoadWarm] = Elapsed(start)/reps;
+	  v[kLoadPeak] = Rss(kTrue) - base;
+	}, loadedValues);
+      remove(fileName.c_str());
+      if(!ok) throw Exception("BenchArchives: " + GetArchiveName(arcType) + " load failed!");
+
+      sw.startNode("");
+      sw.value("archive", GetArchiveName(arcType));
+      sw.value("warriors", Double_t(n));
+      sw.value("save_s", saved[kSave]);
+      sw.value("save_peak_rss", saved[kSavePeak]);
+      sw.value("file_bytes", saved[kFileBytes]);
+      if(loadedValues[kLoadCold] >= 0.) sw.value("load_cold_s", loadedValues[kLoadCold]);
+      sw.value("load_warm_s", loadedValues[kLoadWarm]);
+      sw.value("load_peak_rss", loadedValues[kLoadPeak]);
+      sw.value("write_s", saved[kWrite]);
+      if(saved[kRead] >= 0.) sw.value("read_s", saved[kRead]);
+      sw.finishNode();
+      sw.flush();
+    }
+  }
+  sw.close();
+  std::cout << endl;
+  SetLogLevel(level);
+}
+
+//_____________________________________________________________________________
+/** \class NullBuffer
+    \brief Stream buffer discarding its output.
+*/
+class NullBuffer : public std::streambuf {
+protected:
+  //! Discard a character
+  virtual int_type overflow(int_type c){ return traits_type::not_eof(c); }
+  //! Discard n characters
+  virtual std::streamsize xsputn(const char_type*, std::streamsize n){ return n; }
+};
+
+//_____________________________________________________________________________
+//! Number of lines not starting with exactly one CLUI prefix, in a file.
+static UInt_t CountTornLines(const string& fileName)
+{
+  const string prefix("\x1b[1;41m[BloBB]");
+  std::ifstream ifs(fileName.c_str());
+  string line;
+  UInt_t torn(0);
+  while(std::getline(ifs, line))
+    if(line.compare(0, prefix.size(), prefix) != 0 || line.find(prefix, 1) != string::npos) torn++;
+  return torn;
+}
+
+//_____________________________________________________________________________
+//! Death matches narrated by concurrent sessions (threads, each with its
+//! own CLUI) into one shared file, line-atomic vs. buffered; per-item is
+//! per match.
+static void BenchSessions(UInt_t, UInt_t reps)
+{
+  const UInt_t numThreads(4);
+  const string fileName("blobb-bench-sessions.log");
+  UInt_t n = (reps + numThreads - 1)/numThreads;
+  for(Int_t buffered=0; buffered<=1; buffered++){
+    std::ofstream ofs(fileName.c_str());
+    Clock_t::time_point start = Clock_t::now();
+    vector<std::thread> threads;
+    for(UInt_t t=0; t<numThreads; t++){
+      threads.push_back(std::thread([t, n, buffered, &ofs](){
+	    Warriors_t wars = BuildRoster(2*n);
+	    Random rnd(3 + t);
+	    CLUI clui;
+	    clui.setOutStream(&ofs);
+	    if(buffered) clui.setBuffered();
+	    else         clui.setLineAtomic();
+	    Warriors_t::iterator it = wars.begin();
+	    for(UInt_t r=0; r<n; r++){
+	      Warrior& w1 = (it++)->second;
+	      Warrior& w2 = (it++)->second;
+	      FightEngine(&clui, &rnd, &w1, &w2).death();
+	    }
+	  }));
+    }
+    for(UInt_t t=0; t<numThreads; t++) threads[t].join();
+    Double_t t = Elapsed(start);
+    ofs.close();
+    Char_t what[64];
+    snprintf(what, sizeof(what), "%s, %u torn", (buffered ? "buffered" : "line-atomic"),
+	     CountTornLines(fileName));
+    PrintResult("sessions", what, n*numThreads, t, t/(n*numThreads));
+  }
+  remove(fileName.c_str());
+}
+
+//_____________________________________________________________________________
+//! Round-robin tournaments of (up to 100) warriors without vs. with a
+//! live dashboard (80x24, into memory) at 10 & 60 frames/s; per-item is
+//! per match.
+static void BenchDashboard(UInt_t size, UInt_t reps)
+{
+  UInt_t n = (size < 100 ? size : 100);
+  BloBB blobb;
+  blobb.setWarriors(BuildRoster(n));
+  NullSink results;
+  Batch batch(blobb, results.os());
+  ULong_t numMatches = ULong_t(reps)*n*(n - 1)/2;
+  Double_t rates[3] = {0., 10., 60.};
+  for(Int_t r=0; r<3; r++){
+    // the same fights each time
+    blobb.setRandom(Random(3));
+    MemorySink screen;
+    Dashboard dashboard(screen.os(), rates[r], 80, 24);
+    batch.setDashboard(rates[r] > 0. ? &dashboard : 0);
+    Clock_t::time_point start = Clock_t::now();
+    for(UInt_t rep=0; rep<reps; rep++) batch.execute("tournament");
+    Double_t t = Elapsed(start);
+    Char_t what[64];
+    if(rates[r] > 0.)
+      snprintf(what, sizeof(what), "%.0f Hz, %luB/frame", rates[r],
+	       (unsigned long)(dashboard.numBytes()/(dashboard.numFrames() ? dashboard.numFrames() : 1)));
+    else
+      snprintf(what, sizeof(what), "no dashboard");
+    PrintResult("dashboard", what, n, t, t/numMatches);
+  }
+  if(batch.numFailed() > 0) throw Exception("BenchDashboard: Tournament failed!");
+}
+
+//_____________________________________________________________________________
+//! Disabled debug messages via the macros vs. a direct Log() call (the
+//! operands formatted to /dev/null), and enabled messages.
+static void BenchLog(UInt_t size, UInt_t reps)
+{
+  eLogLevel level = GetLogLevel();
+  SetLogLevel(kInfo);
+  Warriors_t wars = BuildRoster(1);
+  const Warrior& w = wars.begin()->second;
+  UInt_t n = size*reps;
+
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    loutD(DataHandling) << "Warrior " << w.name() << " #" << i << " health " << w.mHealth.value() << endl;
+  Double_t t = Elapsed(start);
+  PrintResult("log", "disabled, macro", size, t, t/n);
+
+  start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    Log(kDebug, DataHandling) << "Warrior " << w.name() << " #" << i << " health " << w.mHealth.value() << endl;
+  t = Elapsed(start);
+  PrintResult("log", "disabled, Log() call", size, t, t/n);
+
+  // debug enabled, topic masked out
+  SetLogLevel(kDebug);
+  UInt_t topics = GetLogTopics();
+  SetLogTopics(Evaluation);
+  start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    loutD(DataHandling) << "Warrior " << w.name() << " #" << i << " health " << w.mHealth.value() << endl;
+  t = Elapsed(start);
+  PrintResult("log", "masked topic, macro", size, t, t/n);
+  SetLogTopics(topics);
+  SetLogLevel(kInfo);
+
+  // enabled, into a discarding buffer
+  NullBuffer null;
+  std::streambuf* buf = std::clog.rdbuf(&null);
+  start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    loutI(DataHandling) << "Warrior " << w.name() << " #" << i << " health " << w.mHealth.value() << endl;
+  t = Elapsed(start);
+  std::clog.rdbuf(buf);
+  PrintResult("log", "enabled", size, t, t/n);
+  SetLogLevel(level);
+}
+
+//_____________________________________________________________________________
+//! Log 'n' messages on each of 'numThreads' threads.
+static Double_t LogOnThreads(UInt_t numThreads, UInt_t n)
+{
+  Clock_t::time_point start = Clock_t::now();
+  vector<std::thread> threads;
+  for(UInt_t t=0; t<numThreads; t++){
+    threads.push_back(std::thread([t, n](){
+	  for(UInt_t i=0; i<n; i++)
+	    loutI(Evaluation) << "Worker " << t << " round " << i << " swing " << 0.5*i << endl;
+	}));
+  }
+  for(UInt_t t=0; t<numThreads; t++) threads[t].join();
+  return Elapsed(start);
+}
+
+//_____________________________________________________________________________
+//! Synchronous vs. asynchronous logging from worker threads, with stderr
+//! sent to /dev/null; per-item is per message.
+static void BenchAsyncLog(UInt_t size, UInt_t reps)
+{
+#ifdef HAVE_UNISTD_H
+  const UInt_t numThreads(4);
+  UInt_t n = size*reps/numThreads;
+  eLogLevel level = GetLogLevel();
+  SetLogLevel(kInfo);
+  std::clog.flush();
+  int err = dup(2), null = open("/dev/null", O_WRONLY);
+  dup2(null, 2);
+  close(null);
+
+  Double_t t1 = LogOnThreads(1, n*numThreads);
+  Double_t tn = LogOnThreads(numThreads, n);
+  StartAsyncLog(kLogBlock);
+  Double_t ta = LogOnThreads(numThreads, n);
+  Clock_t::time_point start = Clock_t::now();
+  FlushLog();
+  Double_t tf = ta + Elapsed(start);
+  StopAsyncLog();
+  StartAsyncLog(kLogDrop);
+  Double_t td = LogOnThreads(numThreads, n);
+  ULong_t dropped = GetLogDropped();
+  StopAsyncLog();
+
+  dup2(err, 2);
+  close(err);
+  SetLogLevel(level);
+  UInt_t total = n*numThreads;
+  PrintResult("asynclog", "sync, 1 thread", size, t1, t1/total);
+  PrintResult("asynclog", "sync, 4 threads", size, tn, tn/total);
+  PrintResult("asynclog", "async block, 4 threads", size, ta, ta/total);
+  PrintResult("asynclog", "async block, written", size, tf, tf/total);
+  Char_t what[64];
+  snprintf(what, sizeof(what), "async drop %.0f%%, 4 thr.", 100.*dropped/total);
+  PrintResult("asynclog", what, size, td, td/total);
+#else
+  (void)size; (void)reps;
+  loutW(InputArguments) << "BenchAsyncLog: Needs <unistd.h>." << endl;
+#endif
+}
+
+//_____________________________________________________________________________
+//! Debug messages written as text (stderr sent to a file) vs. as binary
+//! records; per-item is per message.
+static void BenchBinLog(UInt_t size, UInt_t reps)
+{
+#ifdef HAVE_UNISTD_H
+  eLogLevel level = GetLogLevel();
+  SetLogLevel(kDebug);
+  Warriors_t wars = BuildRoster(1);
+  const Warrior& w = wars.begin()->second;
+  const string textName("blobb-bench-log.txt"), binName("blobb-bench-log.blog");
+  UInt_t n = size*reps;
+
+  std::clog.flush();
+  int err = dup(2), text = open(textName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  dup2(text, 2);
+  close(text);
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    loutfD(Evaluation, "Warrior %s round %u swing %.3f health %.1f", w.name(), i, 0.5*i, w.mHealth.value());
+  Double_t tText = Elapsed(start);
+  dup2(err, 2);
+  close(err);
+
+  if(!StartBinaryLog(binName)) throw Exception("BenchBinLog: Failed to open the log!");
+  start = Clock_t::now();
+  for(UInt_t i=0; i<n; i++)
+    loutfD(Evaluation, "Warrior %s round %u swing %.3f health %.1f", w.name(), i, 0.5*i, w.mHealth.value());
+  StopBinaryLog();
+  Double_t tBin = Elapsed(start);
+  SetLogLevel(level);
+
+  Char_t what[64];
+  snprintf(what, sizeof(what), "text %.1fMB", FileSize(textName)/1.e6);
+  PrintResult("binlog", what, size, tText, tText/n);
+  snprintf(what, sizeof(what), "binary %.1fMB", FileSize(binName)/1.e6);
+  PrintResult("binlog", what, size, tBin, tBin/n);
+  std::ifstream ifs(binName.c_str(), std::ios::binary);
+  std::ofstream ofs(textName.c_str());
+  start = Clock_t::now();
+  if(!DecodeBinaryLog(ifs, ofs)) throw Exception("BenchBinLog: Failed to decode!");
+  Double_t t = Elapsed(start);
+  PrintResult("binlog", "decode", size, t, t/n);
+  remove(textName.c_str());
+  remove(binName.c_str());
+#else
+  (void)size; (void)reps;
+  loutW(InputArguments) << "BenchBinLog: Needs <unistd.h>." << endl;
+#endif
+}
+
+//_____________________________________________________________________________
+/** Warrior list lines (as BloBB::printWarriors) to a memory sink: stream
+    insertions per field vs. printStream, whose hooks format into a stack
+    buffer; and the death-match narration. Per-item is per line. */
+static void BenchPrint(UInt_t size, UInt_t reps)
+{
+  Warriors_t wars = BuildRoster(size);
+  MemorySink sink(size*100);
+  ostream& os = sink.os();
+  Clock_t::time_point start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    sink.clear();
+    for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it){
+      const Warrior& w = it->second;
+      os << "\t" << w.name() << " \"" << w.title() << "\" = {" 
+	 << w.mProwess.value() << "," << w.mAgility.value() << "," 
+	 << w.mIntelligence.value() << "," << w.mPersonality.value() << "," 
+	 << w.mHealth.value() << "} {" << w.mFatigue.value() << "," 
+	 << w.mStun.value() << "," << w.mDisarm.value() << "," 
+	 << w.mFallen.value() << "," << w.mFatigueTime.value() << "," 
+	 << w.mHealthTime.value() << "}" << endl;
+    }
+  }
+  Double_t t = Elapsed(start);
+  string streamed = sink.str();
+  PrintResult("print", "stream insertions", size, t, t/size/reps);
+
+  start = Clock_t::now();
+  for(UInt_t r=0; r<reps; r++){
+    sink.clear();
+    for(Warriors_t::const_iterator it = wars.begin(); it != wars.end(); ++it)
+      it->second.printStream(os, Printable::kName|Printable::kTitle|Printable::kValue|Printable::kExtras, 
+			     Printable::kSingleLine, "\t");
+  }
+  t = Elapsed(start);
+  if(sink.str() != streamed) throw Exception("BenchPrint: Different output!");
+  PrintResult("print", "printStream, buffered", size, t, t/size/reps);
+
+  MemorySink narration;
+  RunDeaths("death match, memory", narration.os(), kFalse, reps, "print");
+}
+
+//_____________________________________________________________________________
+//! Available benchmarks.
+static const Benchmark_t gBenchmarks[] =
+  {
+    {"equality", "Bulk Warriors_t equality and class-type checks", BenchEquality},
+    {"index",    "Roster index range filter and top-k queries",     BenchIndex},
+    {"mapped",   "Memory-mapped roster open and look-up",           BenchMapped},
+    {"stream",   "Streaming JSON/XML writer vs. cereal archives",   BenchStream},
+    {"sax",      "Streaming JSON loader vs. cereal JSON archive",   BenchSax},
+    {"xml",      "Mapped XML loader vs. cereal XML archive",        BenchXml},
+    {"lz",       "LZ block-compressed vs. plain binary/JSON",       BenchLz},
+    {"journal",  "Journaled autosaves vs. full binary saves",       BenchJournal},
+    {"async",    "Background snapshot saves vs. blocking saves",    BenchAsync},
+    {"footer",   "Indexed single-warrior loads vs. full loads",     BenchFooter},
+    {"portable", "Portable (endian-safe) vs. native binary",        BenchPortable},
+    {"delta",    "Delta snapshots vs. full saves, chain loads",     BenchDelta},
+    {"archives", "All archive types over roster sizes, as JSON",   BenchArchives},
+    {"death",    "Death-match output, flushed vs. buffered CLUI",   BenchDeath},
+    {"sinks",    "Null, memory, file & pipe output sinks",          BenchSinks},
+    {"sessions", "Concurrent death-match narration, 4 threads",     BenchSessions},
+    {"dashboard", "Tournaments without vs. with a live dashboard",   BenchDashboard},
+    {"log",      "Disabled, masked & enabled log messages",         BenchLog},
+    {"asynclog", "Synchronous vs. asynchronous logging, 4 threads", BenchAsyncLog},
+    {"binlog",   "Text vs. binary debug log records",               BenchBinLog},
+    {"print",    "Warrior lines: stream insertions vs. buffers",    BenchPrint},
+    {0, 0, 0}
+  };
+
+//_____________________________________________________________________________
+//! Usage for blobb-bench.
+void PrintUsage(std::ostream& os)
+{
+  os << "blobb-bench: Run blobb performance benchmarks." << endl;
+  os << "Usage: blobb-bench <benchmark|all> [size=100000] [repetitions=10]" << endl;
+  os << "Benchmarks:" << endl;
+  for(const Benchmark_t* b = gBenchmarks; b->name; b++)
+    os << "  " << b->name << string(12 - strlen(b->name), ' ') << b->description << endl;
+}
+
+//_____________________________________________________________________________
+//! main method for blobb-bench.
+Int_t main(Int_t argc, Char_t** argv)
+{
+  // parse arguments
+  if(argc < 2 || string(argv[1]) == "-h" || string(argv[1]) == "--help"){
+    PrintUsage(std::cout);
+    return (argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS);
+  }
+  string which(argv[1]);
+  UInt_t size = (argc > 2 ? UInt_t(atol(argv[2])) : 100000);
+  UInt_t reps = (argc > 3 ? UInt_t(atol(argv[3])) : 10);
+  if(size == 0 || reps == 0){
+    PrintUsage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  // run
+  try {
+    Bool_t found(kFalse);
+    for(const Benchmark_t* b = gBenchmarks; b->name; b++){
+      if(which != "all" && which != b->name) continue;
+      found = kTrue;
+      b->run(size, reps);
+    }
+    if(!found){
+      loutE(InputArguments) << "Unknown benchmark '" << which << "'." << endl;
+      PrintUsage(std::cerr);
+      return EXIT_FAILURE;
+    }
+  }
+  catch(const Exception& e) {
+    loutF(Evaluation) << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/** \file      src/progs/blobb-convert.cxx
+    \brief     Source for binary executable for blobb-convert.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/Exception.hh"   // exception handler
+#include "blobb/LogService.hh"  // log service
+#include "blobb/Converter.hh"   // parallel conversion
+#include "blobb/StringTools.hh" // file-name tools
+#include <chrono>               // cplusplus.com/reference/chrono/
+#include <cstdlib>              // cplusplus.com/reference/cstdlib/
+#include <fstream>              // cplusplus.com/reference/fstream/
+using namespace Blobb;          // blobb top level namespace
+
+#ifdef HAVE_GETOPT_H
+  #include <getopt.h>           // GNU option parsing
+  /** \typedef GnuOpt_t
+      \brief GNU getopt option, see blobb-config.cxx. */
+  typedef struct option GnuOpt_t;
+#endif // end HAVE_GETOPT_H
+
+//_____________________________________________________________________________
+//! Usage for blobb-convert.
+void PrintUsage(std::ostream& os)
+{
+  os << "blobb-convert: Convert BloBB saves between archive types." << endl;
+  os << "               Files are converted in parallel, one state per thread." << endl;
+  os << "Usage: blobb-convert -t type [option(s)] file(s)" << endl;
+  os << "Options:" << endl;
+  os << "  -h|--help            Display this help message" << endl;
+  os << "  -a|--archives        List the archive types" << endl;
+  os << "  -t|--to type         Output archive type, by name or extension (e.g. JSON, .cnbz)" << endl;
+  os << "  -o|--out-dir dir     Output directory (default: next to each input)" << endl;
+  os << "  -j|--threads n       Number of threads (default: all cores)" << endl;
+  os << "  -l|--list file       Also convert the files listed, one per line, in file" << endl;
+  os << "  -m|--merge file      Merge the files (shards of a roster) into file" << endl;
+  os << "  -s|--split n         Split each file into n shards (name-000.ext, ...)" << endl;
+  os << "  -f|--force           Overwrite existing outputs" << endl;
+  os << "  -y|--sync            Sync outputs to disk before renaming them in place" << endl;
+  os << "  -v|--verbose         Log each file read & written" << endl;
+}
+
+//_____________________________________________________________________________
+/** Parse an archive type name or extension.
+    \return "success" boolean: true if known. */
+static Bool_t ParseArchive(const string& arg, eArchiveType& arcType)
+{
+  if(arg != "" && arg[0] == '.'){
+    if(!IsArchiveExt(arg)) return kFalse;
+    arcType = GetArchiveTypeFromExt(arg);
+    return kTrue;
+  }
+  for(Int_t t=kBinary; t<=kPortable; t++){
+    if(GetArchiveName(eArchiveType(t)) == arg){
+      arcType = eArchiveType(t);
+      return kTrue;
+    }
+  }
+  return kFalse;
+}
+
+//_____________________________________________________________________________
+//! main method for blobb-convert.
+Int_t main(Int_t argc, Char_t** argv)
+{
+#ifndef HAVE_GETOPT_H
+  // --------------------------------------------
+  // check for GNU getopt.h
+  std::cerr << "ERROR: blobb-convert: <getopt.h> not found." << endl;
+  return EXIT_FAILURE;
+#else
+
+  // --------------------------------------------
+  // check input(s)
+  if(argc <= 1){
+    PrintUsage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  // --------------------------------------------
+  // struct array for feeding to getopt
+  static GnuOpt_t gGnuLongOpts[] =
+    {
+      {"help",     no_argument,       0, 'h'},
+      {"archives", no_argument,       0, 'a'},
+      {"to",       required_argument, 0, 't'},
+      {"out-dir",  required_argument, 0, 'o'},
+      {"threads",  required_argument, 0, 'j'},
+      {"list",     required_argument, 0, 'l'},
+      {"merge",    required_argument, 0, 'm'},
+      {"split",    required_argument, 0, 's'},
+      {"force",    no_argument,       0, 'f'},
+      {"sync",     no_argument,       0, 'y'},
+      {"verbose",  no_argument,       0, 'v'},
+      {0, 0, 0, 0}
+    };
+
+  Converter converter;
+  Bool_t hasType(kFalse), verbose(kFalse);
+  string mergeFileName("");
+  UInt_t numShards(0);
+  vector<string> fileNames;
+
+  // --------------------------------------------
+  // read options
+  int optIdx(0), optChar(-1);
+  while((optChar = getopt_long(argc, argv, "hat:o:j:l:m:s:fyv", gGnuLongOpts, &optIdx)) != -1){
+    switch(optChar){
+    case 'h':
+      PrintUsage(std::cout);
+      return EXIT_SUCCESS;
+
+    case 'a':
+      PrintArchiveInfo(std::cout);
+      return EXIT_SUCCESS;
+
+    case 't':{
+      eArchiveType arcType(kBinary);
+      if(!ParseArchive(optarg, arcType)){
+	loutE(InputArguments) << "blobb-convert: Unknown archive type '" << optarg << "'." << endl;
+	return EXIT_FAILURE;
+      }
+      converter.setOutType(arcType);
+      hasType = kTrue;
+      break;
+    }
+
+    case 'o':
+      converter.setOutDir(optarg);
+      break;
+
+    case 'j':
+      converter.setNumThreads(UInt_t(atoi(optarg)));
+      break;
+
+    case 'l':{
+      std::ifstream ifs(optarg);
+      if(!ifs.is_open()){
+	loutE(InputArguments) << "blobb-convert: Cannot open list '" << optarg << "'." << endl;
+	return EXIT_FAILURE;
+      }
+      string line;
+      while(std::getline(ifs, line)) if(line != "") fileNames.push_back(line);
+      break;
+    }
+
+    case 'm':
+      mergeFileName = optarg;
+      break;
+
+    case 's':
+      numShards = UInt_t(atoi(optarg));
+      break;
+
+    case 'f':
+      converter.setOverwrite();
+      break;
+
+    case 'y':
+      converter.setSync();
+      break;
+
+    case 'v':
+      verbose = kTrue;
+      break;
+
+    default:
+      PrintUsage(std::cerr);
+      return EXIT_FAILURE;
+    } // end option switch
+  } // end while (read opts)
+  for(Int_t i=optind; i<argc; i++) fileNames.push_back(argv[i]);
+
+  // --------------------------------------------
+  // check the request
+  if(mergeFileName != ""){
+    if(!IsArchiveExt(GetFileExt(mergeFileName))){
+      loutE(InputArguments) << "blobb-convert: Unknown extension of '" << mergeFileName << "'." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  else if(!hasType){
+    loutE(InputArguments) << "blobb-convert: No output type given (-t)." << endl;
+    return EXIT_FAILURE;
+  }
+  if(fileNames.empty()){
+    loutE(InputArguments) << "blobb-convert: No files given." << endl;
+    return EXIT_FAILURE;
+  }
+  if(mergeFileName != "" && numShards > 0){
+    loutE(InputArguments) << "blobb-convert: Cannot both merge (-m) and split (-s)." << endl;
+    return EXIT_FAILURE;
+  }
+  if(!verbose && GetLogLevel() > kWarning) SetLogLevel(kWarning);
+  // workers' messages are written by a background thread
+  StartAsyncLog();
+
+  // --------------------------------------------
+  // convert
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Pos_t numDone(0), numFailed(0);
+  try{
+    if(mergeFileName != ""){
+      converter.merge(fileNames, mergeFileName);
+      numDone = converter.numDone();
+      numFailed = converter.numFailed();
+    }
+    else if(numShards > 0){
+      for(Pos_t f=0; f<fileNames.size(); f++){
+	converter.split(fileNames[f], numShards);
+	numDone += converter.numDone();
+	numFailed += converter.numFailed();
+      }
+    }
+    else{
+      converter.convert(fileNames);
+      numDone = converter.numDone();
+      numFailed = converter.numFailed();
+    }
+  }
+  catch(const Exception& e){
+    loutF(Evaluation) << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+  Double_t t = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+  FlushLog();
+  std::cout << "blobb-convert: " << numDone << " file(s) written, " << numFailed
+	    << " failed, in " << t << " s (" << converter.numThreads() << " threads)." << endl;
+  return (numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+#endif // end HAVE_GETOPT_H
+}
@@ -0,0 +1,41 @@
+/** \file      src/progs/blobb-logdump.cxx
+    \brief     Source for binary executable for blobb-logdump.
+    \author    Doug Hague
+    \date      18.10.2026
+    \copyright See License.txt
+*/
+#include "blobb/BinaryLog.hh"   // binary log records
+#include <cstdlib>              // cplusplus.com/reference/cstdlib/
+#include <fstream>              // cplusplus.com/reference/fstream/
+using namespace Blobb;          // blobb top level namespace
+
+//_____________________________________________________________________________
+//! Usage for blobb-logdump.
+void PrintUsage(std::ostream& os)
+{
+  os << "blobb-logdump: Render binary BloBB logs as text, one line per message." << endl;
+  os << "Usage: blobb-logdump [file(s)]   (default: stdin)" << endl;
+}
+
+//_____________________________________________________________________________
+//! main method for blobb-logdump.
+Int_t main(Int_t argc, Char_t** argv)
+{
+  if(argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help")){
+    PrintUsage(std::cout);
+    return EXIT_SUCCESS;
+  }
+  if(argc <= 1) return (DecodeBinaryLog(std::cin, std::cout) ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  Bool_t ok(kTrue);
+  for(Int_t i=1; i<argc; i++){
+    std::ifstream ifs(argv[i], std::ios::binary);
+    if(!ifs.is_open()){
+      loutE(InputArguments) << "blobb-logdump: Cannot open '" << argv[i] << "'." << endl;
+      ok = kFalse;
+      continue;
+    }
+    ok = DecodeBinaryLog(ifs, std::cout) && ok;
+  }
+  return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
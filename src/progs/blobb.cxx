@@ -4,10 +4,15 @@
     \date      08.06.2014
     \copyright See License.txt
 */
+#include "blobb/BinaryLog.hh"   // binary log records
 #include "blobb/Exception.hh"   // exception handler
 #include "blobb/LogService.hh"  // log service
 #include "blobb/Options.hh"     // program options
 #include "blobb/BloBB.hh"       // main program
+#include "blobb/Batch.hh"       // batch mode
+#include "blobb/Dashboard.hh"   // live tournaments
+#include <cstdlib>              // cplusplus.com/reference/cstdlib/
+#include <fstream>              // cplusplus.com/reference/fstream/
 using namespace Blobb;          // blobb top level namespace
 
 //_____________________________________________________________________________
@@ -17,6 +22,7 @@ Int_t main(Int_t argc, Char_t** argv)
   try {
     // --------------------------------------------
     // parse options; can throw Exception
+    eLogLevel defLevel = GetLogLevel();
     Options options(argc, argv);
     // Print help?
     if(options.help()){
@@ -50,6 +56,16 @@ Int_t main(Int_t argc, Char_t** argv)
     }
 #endif // HAVE_CONFIG_H
 
+    // --------------------------------------------
+    // binary log records instead of text; closed at exit
+    if(options.binaryLogFileName() != ""){
+      if(!StartBinaryLog(options.binaryLogFileName())){
+	loutE(InputArguments) << "Cannot open binary log '" << options.binaryLogFileName() << "'." << endl;
+	return EXIT_FAILURE;
+      }
+      std::atexit(StopBinaryLog);
+    }
+
     // --------------------------------------------
     // main program handler
     BloBB blobb;
@@ -57,6 +73,34 @@ Int_t main(Int_t argc, Char_t** argv)
     if(options.hasInFileName())  blobb.load(options.inFileName());
     else                         blobb = BloBB::BuildDefault();
 
+    // --------------------------------------------
+    // batch: script in, results out, no prompts
+    if(options.batch()){
+      // warnings & errors only, unless another print-level is given
+      if(GetLogLevel() == defLevel && defLevel > kWarning) SetLogLevel(kWarning);
+      std::ifstream script;
+      if(options.scriptFileName() != ""){
+	script.open(options.scriptFileName().c_str());
+	if(!script.is_open()){
+	  loutE(InputArguments) << "Cannot open script '" << options.scriptFileName() << "'." << endl;
+	  return EXIT_FAILURE;
+	}
+      }
+      std::ofstream results;
+      if(options.outFileName() != ""){
+	results.open(options.outFileName().c_str());
+	if(!results.is_open()){
+	  loutE(InputArguments) << "Cannot open output '" << options.outFileName() << "'." << endl;
+	  return EXIT_FAILURE;
+	}
+      }
+      Batch batch(blobb, (results.is_open() ? (std::ostream&)results : std::cout));
+      Dashboard dashboard(std::cerr);
+      if(options.dashboard()) batch.setDashboard(&dashboard);
+      batch.run(script.is_open() ? (std::istream&)script : std::cin);
+      return (batch.numFailed() == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
     // --------------------------------------------
     // run; can throw Exception
     return blobb.main();